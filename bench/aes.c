@@ -0,0 +1,148 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// AES-128 in counter mode as used by AES-GCM (the last 32 bits of the counter
+// block are a big-endian counter that is incremented for each block, NIST
+// SP 800-38D), which encrypts a set of blocks with the same key
+
+#include "bench.h"
+
+#define BLOCKS 64
+
+static uint32_t aes_key[4];
+static uint32_t ctr_block[4];
+static uint32_t plain_data[BLOCKS * 4];
+static uint32_t cipher_data[BLOCKS * 4];
+
+static const uint8_t aes_sbox[256] = {
+    0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+    0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+    0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+    0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+    0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+    0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+    0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+    0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+    0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+    0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+    0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+    0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+    0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+    0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+    0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+    0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16
+};
+
+static inline uint8_t aes_xtime(uint8_t x) {
+    return (x << 1) ^ ((x & 0x80) ? 0x1B : 0x00);
+}
+
+// void aes_ctr(uint32_t blocks, const uint32_t *key, const uint32_t *ctr,
+//              const uint32_t *src, uint32_t *dst)
+//
+// encrypts (or decrypts) blocks 16-byte blocks of src into dst with the key
+// stream obtained by encrypting the initial counter block ctr and its
+// successors with the 128-bit key; all arguments are byte strings
+//
+// The cipher is computed byte by byte with a table for SubBytes (FIPS 197).
+BENCH_KERNEL void aes_ctr(uint32_t blocks, const uint32_t *key, const uint32_t *ctr,
+                          const uint32_t *src, uint32_t *dst) {
+    const uint8_t *key_bytes = (const uint8_t *)key;
+    const uint8_t *src_bytes = (const uint8_t *)src;
+    uint8_t       *dst_bytes = (uint8_t *)dst;
+    uint8_t        rk[176], cb[16], st[16], t[16], rcon = 1;
+    uint32_t       i, j, c, r;
+
+    // key expansion
+    for (i = 0; i < 16; i++) {
+        rk[i] = key_bytes[i];
+    }
+    for (i = 16; i < 176; i += 4) {
+        for (j = 0; j < 4; j++) {
+            t[j] = rk[i-4+j];
+        }
+        if (i % 16 == 0) {
+            uint8_t tmp = t[0];
+            t[0] = aes_sbox[t[1]] ^ rcon;
+            t[1] = aes_sbox[t[2]];
+            t[2] = aes_sbox[t[3]];
+            t[3] = aes_sbox[tmp];
+            rcon = aes_xtime(rcon);
+        }
+        for (j = 0; j < 4; j++) {
+            rk[i+j] = rk[i-16+j] ^ t[j];
+        }
+    }
+
+    for (i = 0; i < 16; i++) {
+        cb[i] = ((const uint8_t *)ctr)[i];
+    }
+    for (i = 0; i < blocks; i++) {
+        for (j = 0; j < 16; j++) {
+            st[j] = cb[j] ^ rk[j];
+        }
+        for (r = 1; r <= 10; r++) {
+            // SubBytes and ShiftRows
+            for (c = 0; c < 4; c++) {
+                for (j = 0; j < 4; j++) {
+                    t[4*c+j] = aes_sbox[st[(4*(c+j)+j) % 16]];
+                }
+            }
+            // MixColumns (skipped in the last round) and AddRoundKey
+            for (c = 0; c < 4; c++) {
+                uint8_t a0 = t[4*c], a1 = t[4*c+1], a2 = t[4*c+2], a3 = t[4*c+3];
+                uint8_t all = a0 ^ a1 ^ a2 ^ a3;
+                if (r != 10) {
+                    t[4*c  ] = a0 ^ all ^ aes_xtime(a0 ^ a1);
+                    t[4*c+1] = a1 ^ all ^ aes_xtime(a1 ^ a2);
+                    t[4*c+2] = a2 ^ all ^ aes_xtime(a2 ^ a3);
+                    t[4*c+3] = a3 ^ all ^ aes_xtime(a3 ^ a0);
+                }
+                for (j = 0; j < 4; j++) {
+                    st[4*c+j] = t[4*c+j] ^ rk[16*r+4*c+j];
+                }
+            }
+        }
+        for (j = 0; j < 16; j++) {
+            dst_bytes[16*i+j] = src_bytes[16*i+j] ^ st[j];
+        }
+        // increment the 32-bit big-endian counter in the last word
+        for (j = 15; j >= 12; j--) {
+            if (++cb[j] != 0) {
+                break;
+            }
+        }
+    }
+}
+
+BENCH_THROUGHPUT(0xE2AA78F0);
+
+int main(void) {
+    uint32_t seed = 1, i, start, end;
+    for (i = 0; i < 4; i++) {
+        aes_key[i]  = bench_rand(&seed) << 16;
+        aes_key[i] |= bench_rand(&seed);
+    }
+    // 96-bit nonce followed by a counter that wraps around within the data
+    for (i = 0; i < 3; i++) {
+        ctr_block[i]  = bench_rand(&seed) << 16;
+        ctr_block[i] |= bench_rand(&seed);
+    }
+    ctr_block[3] = 0xE0FFFFFFu;
+    for (i = 0; i < BLOCKS * 4; i++) {
+        plain_data[i]  = bench_rand(&seed) << 16;
+        plain_data[i] |= bench_rand(&seed);
+    }
+
+    start = bench_cycles();
+    aes_ctr(BLOCKS, aes_key, ctr_block, plain_data, cipher_data);
+    bench_sync(&cipher_data[BLOCKS * 4 - 1]);
+    end   = bench_cycles();
+
+    vdata_start[0] = bench_hash(2166136261u, cipher_data, BLOCKS * 4);
+    vdata_start[1] = BLOCKS * 16;
+    vdata_start[2] = end - start;
+    spill_cache(vdata_start, vdata_end);
+}
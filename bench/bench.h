@@ -0,0 +1,95 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+
+// The result of a benchmark is a single checksum word that is written to the
+// vdata region and compared against the expected value in the vref region by
+// the simulation harness (same convention as the tests in ../test/).
+#define BENCH_CHECKSUM(ref)                                                   \
+    __asm__ (                                                                 \
+        "    .data                  \n"                                       \
+        "    .balign 16             \n"                                       \
+        "    .global vdata_start    \n"                                       \
+        "    .global vdata_end      \n"                                       \
+        "vdata_start:               \n"                                       \
+        "    .word 0                \n"                                       \
+        "vdata_end:                 \n"                                       \
+        "    .balign 16             \n"                                       \
+        "    .global vref_start     \n"                                       \
+        "    .global vref_end       \n"                                       \
+        "vref_start:                \n"                                       \
+        "    .word " #ref "         \n"                                       \
+        "vref_end:                  \n"                                       \
+        "    .text                  \n"                                       \
+    )
+
+// Benchmarks that additionally report the throughput of their kernel use
+// BENCH_THROUGHPUT instead, which reserves two more words following the
+// checksum for the number of bytes processed by the kernel and the number of
+// cycles that it took; only the checksum is compared against the reference.
+#define BENCH_THROUGHPUT(ref)                                                 \
+    __asm__ (                                                                 \
+        "    .data                  \n"                                       \
+        "    .balign 16             \n"                                       \
+        "    .global vdata_start    \n"                                       \
+        "    .global vdata_end      \n"                                       \
+        "vdata_start:               \n"                                       \
+        "    .word 0, 0, 0          \n"                                       \
+        "vdata_end:                 \n"                                       \
+        "    .balign 16             \n"                                       \
+        "    .global vref_start     \n"                                       \
+        "    .global vref_end       \n"                                       \
+        "vref_start:                \n"                                       \
+        "    .word " #ref "         \n"                                       \
+        "vref_end:                  \n"                                       \
+        "    .text                  \n"                                       \
+    )
+
+extern volatile uint32_t vdata_start[];
+extern volatile uint32_t vdata_end[];
+
+// write back the data cache and terminate (see ../test/spill_cache.S)
+void spill_cache(volatile uint32_t *start, volatile uint32_t *end) __attribute__((noreturn));
+
+// Each benchmark provides a scalar implementation of its kernel(s) marked as
+// weak symbol.  The vectorized variant of a benchmark is obtained by linking
+// an additional object file that overrides the kernel(s) with a vectorized
+// implementation (analogous to the weak exception_handler in ../sw/crt0.S).
+#define BENCH_KERNEL __attribute__((weak, noinline))
+
+// pseudo-random number generator used to initialize the input data
+static inline uint32_t bench_rand(uint32_t *seed) {
+    *seed = *seed * 1103515245u + 12345u;
+    return *seed >> 16;
+}
+
+// read the cycle counter (CV32E40X inhibits it on reset, hence mcountinhibit
+// is cleared first)
+static inline uint32_t bench_cycles(void) {
+    uint32_t cycles;
+    __asm__ volatile ("csrw 0x320, zero\n\tcsrr %0, mcycle" : "=r"(cycles) :: "memory");
+    return cycles;
+}
+
+// wait for the vector instructions writing to the given word to complete (the
+// main core reads memory only once the pending vector stores are done)
+static inline void bench_sync(const uint32_t *word) {
+    (void)*(const volatile uint32_t *)word;
+}
+
+// checksum accumulation over an array of 32-bit words
+static inline uint32_t bench_hash(uint32_t hash, const uint32_t *data, uint32_t len) {
+    uint32_t i;
+    for (i = 0; i < len; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+#endif // BENCH_H
@@ -0,0 +1,55 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// Table-driven CRC-32 of a set of independent packets (based on crc32 from
+// Embench, but operating on several packets to expose data parallelism)
+
+#include "bench.h"
+
+#define PKT_CNT   32
+#define PKT_WORDS 32
+
+static uint32_t crc_table[256];
+static uint32_t pkt_data[PKT_CNT * PKT_WORDS];
+static uint32_t pkt_crc[PKT_CNT];
+
+// void crc32(size_t cnt, size_t words, const uint32_t *data,
+//            const uint32_t *table, uint32_t *crc)
+//
+// computes the CRC-32 of cnt packets of words 32-bit words each
+BENCH_KERNEL void crc32(uint32_t cnt, uint32_t words, const uint32_t *data,
+                        const uint32_t *table, uint32_t *crc) {
+    uint32_t i, j;
+    for (i = 0; i < cnt; i++) {
+        const uint8_t *bytes = (const uint8_t *)(data + i * words);
+        uint32_t c = 0xFFFFFFFFu;
+        for (j = 0; j < words * 4; j++) {
+            c = table[(c ^ bytes[j]) & 0xFF] ^ (c >> 8);
+        }
+        crc[i] = ~c;
+    }
+}
+
+BENCH_CHECKSUM(0x3AB706B7);
+
+int main(void) {
+    uint32_t seed = 1, i, j;
+    for (i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (j = 0; j < 8; j++) {
+            c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+        }
+        crc_table[i] = c;
+    }
+    for (i = 0; i < PKT_CNT * PKT_WORDS; i++) {
+        pkt_data[i]  = bench_rand(&seed) << 16;
+        pkt_data[i] |= bench_rand(&seed);
+    }
+
+    crc32(PKT_CNT, PKT_WORDS, pkt_data, crc_table, pkt_crc);
+
+    vdata_start[0] = bench_hash(2166136261u, pkt_crc, PKT_CNT);
+    spill_cache(vdata_start, vdata_end);
+}
@@ -0,0 +1,97 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// Vector context switching between two cooperative tasks: a vector task that
+// accumulates data in a few vector registers and a scalar task that does not
+// use the vector unit at all.  The scalar variant switches tasks eagerly, i.e.,
+// it saves and restores the complete vector state on every switch, whereas
+// the vector variant switches lazily based on the vector state status and
+// the dirty register mask (see ../sw/vctx.S).
+
+#include "bench.h"
+#include "../sw/vctx.h"
+
+#define ROUNDS      64
+#define SLICE_WORDS 4
+#define VLENB_MAX   256
+
+uint8_t ctx_vec[VCTX_SIZE(VLENB_MAX)] __attribute__((aligned(4)));
+uint8_t ctx_scl[VCTX_SIZE(VLENB_MAX)] __attribute__((aligned(4)));
+
+static uint32_t data[ROUNDS * SLICE_WORDS];
+static uint32_t result[4 * SLICE_WORDS + 1];
+
+// void task_switch(void *from, void *to)
+//
+// saves the vector context of the current task to the buffer from and
+// restores the vector context of the next task from the buffer to
+BENCH_KERNEL void task_switch(void *from, void *to) {
+    vctx_save_all(from);
+    vctx_restore(to);
+}
+
+// time slice of the vector task: accumulates SLICE_WORDS words in v1 to v4
+static void vector_slice(const uint32_t *src) {
+    uint32_t vl;
+    __asm__ volatile (
+        "vsetvli    %0, %2, e32,m1  \n"
+        "vle32.v    v5, (%1)        \n"
+        "vadd.vv    v1, v1, v5      \n"
+        "vxor.vv    v2, v2, v5      \n"
+        "vsub.vv    v3, v3, v5      \n"
+        "vadd.vv    v4, v4, v1      \n"
+        : "=&r"(vl) : "r"(src), "r"(SLICE_WORDS) : "memory"
+    );
+}
+
+// time slice of the scalar task
+static uint32_t scalar_slice(uint32_t acc, const uint32_t *src) {
+    uint32_t i;
+    for (i = 0; i < SLICE_WORDS; i++) {
+        acc = ((acc << 5) | (acc >> 27)) ^ src[i];
+    }
+    return acc;
+}
+
+BENCH_CHECKSUM(0x5079D775);
+
+int main(void) {
+    uint32_t seed = 1, acc = 0, vl, i;
+    for (i = 0; i < ROUNDS * SLICE_WORDS; i++) {
+        data[i]  = bench_rand(&seed) << 16;
+        data[i] |= bench_rand(&seed);
+    }
+
+    // the vector task starts first
+    __asm__ volatile (
+        "vsetvli    %0, %1, e32,m1  \n"
+        "vmv.v.i    v1, 0           \n"
+        "vmv.v.i    v2, 0           \n"
+        "vmv.v.i    v3, 0           \n"
+        "vmv.v.i    v4, 0           \n"
+        : "=&r"(vl) : "r"(SLICE_WORDS)
+    );
+    for (i = 0; i < ROUNDS; i++) {
+        vector_slice(data + i * SLICE_WORDS);
+        task_switch(ctx_vec, ctx_scl);
+        acc = scalar_slice(acc, data + (ROUNDS - 1 - i) * SLICE_WORDS);
+        task_switch(ctx_scl, ctx_vec);
+    }
+    __asm__ volatile (
+        "vsetvli    %0, %1, e32,m1  \n"
+        "vse32.v    v1, (%2)        \n"
+        "vse32.v    v2, (%3)        \n"
+        "vse32.v    v3, (%4)        \n"
+        "vse32.v    v4, (%5)        \n"
+        : "=&r"(vl)
+        : "r"(SLICE_WORDS), "r"(result), "r"(result + SLICE_WORDS), "r"(result + 2 * SLICE_WORDS),
+          "r"(result + 3 * SLICE_WORDS)
+        : "memory"
+    );
+    result[4 * SLICE_WORDS] = acc;
+
+    vdata_start[0] = bench_hash(2166136261u, result, 4 * SLICE_WORDS + 1);
+    spill_cache(vdata_start, vdata_end);
+}
@@ -0,0 +1,79 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// Fixed-point DSP kernels (based on the vec_mpy1, mac and fir kernels of edn
+// from Embench)
+
+#include "bench.h"
+
+#define N     256
+#define ORDER 32
+
+static int16_t edn_a[N];
+static int16_t edn_b[N];
+static int16_t edn_coeff[ORDER];
+static int32_t edn_fir[N - ORDER];
+static int32_t edn_mac[2];
+
+// void vec_mpy1(size_t n, int16_t *y, const int16_t *x, int16_t scaler)
+//
+// y[i] += (scaler * x[i]) >> 15
+BENCH_KERNEL void vec_mpy1(uint32_t n, int16_t *y, const int16_t *x, int16_t scaler) {
+    uint32_t i;
+    for (i = 0; i < n; i++) {
+        y[i] += (int16_t)(((int32_t)scaler * x[i]) >> 15);
+    }
+}
+
+// void mac(size_t n, const int16_t *a, const int16_t *b, int32_t *res)
+//
+// res[0] += a[i] * b[i], res[1] += b[i] * b[i]
+BENCH_KERNEL void mac(uint32_t n, const int16_t *a, const int16_t *b, int32_t *res) {
+    uint32_t sum = res[0], sqr = res[1], i;
+    for (i = 0; i < n; i++) {
+        sum += (uint32_t)((int32_t)a[i] * b[i]);
+        sqr += (uint32_t)((int32_t)b[i] * b[i]);
+    }
+    res[0] = sum;
+    res[1] = sqr;
+}
+
+// void fir(size_t n, size_t order, const int16_t *x, const int16_t *coeff,
+//          int32_t *y)
+//
+// y[j] = (sum_i x[j + i] * coeff[i]) >> 15 for j in 0 .. n - order - 1
+BENCH_KERNEL void fir(uint32_t n, uint32_t order, const int16_t *x, const int16_t *coeff, int32_t *y) {
+    uint32_t i, j;
+    for (j = 0; j < n - order; j++) {
+        int32_t sum = 0;
+        for (i = 0; i < order; i++) {
+            sum += (int32_t)x[j + i] * coeff[i];
+        }
+        y[j] = sum >> 15;
+    }
+}
+
+BENCH_CHECKSUM(0x61E83D72);
+
+int main(void) {
+    uint32_t seed = 1, i, hash;
+    for (i = 0; i < N; i++) {
+        edn_a[i] = (int16_t)bench_rand(&seed);
+        edn_b[i] = (int16_t)bench_rand(&seed);
+    }
+    for (i = 0; i < ORDER; i++) {
+        edn_coeff[i] = (int16_t)(bench_rand(&seed) % 2048) - 1024;
+    }
+
+    vec_mpy1(N, edn_a, edn_b, 0x5A5A);
+    mac(N, edn_a, edn_b, edn_mac);
+    fir(N, ORDER, edn_a, edn_coeff, edn_fir);
+
+    hash = bench_hash(2166136261u, (const uint32_t *)edn_a, N / 2);
+    hash = bench_hash(hash, (const uint32_t *)edn_mac, 2);
+    hash = bench_hash(hash, (const uint32_t *)edn_fir, N - ORDER);
+    vdata_start[0] = hash;
+    spill_cache(vdata_start, vdata_end);
+}
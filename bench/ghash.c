@@ -0,0 +1,86 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// GHASH (the authentication function of AES-GCM) of a set of independent
+// packets that are authenticated with the same hash key
+
+#include "bench.h"
+
+#define PKT_CNT    32
+#define PKT_BLOCKS 4
+
+static uint32_t hash_key[4];
+static uint32_t pkt_data[PKT_CNT * PKT_BLOCKS * 4];
+static uint32_t pkt_hash[PKT_CNT * 4];
+
+// void ghash(uint32_t cnt, uint32_t blocks, const uint32_t *data,
+//            const uint32_t *key, uint32_t *hash)
+//
+// computes the GHASH of cnt packets of blocks 16-byte blocks each; the key,
+// the data and the hashes are byte strings as defined by the GCM standard
+//
+// The multiplication in GF(2^128) is done bit by bit (Algorithm 1 of NIST
+// SP 800-38D) on big-endian 32-bit words.
+BENCH_KERNEL void ghash(uint32_t cnt, uint32_t blocks, const uint32_t *data,
+                        const uint32_t *key, uint32_t *hash) {
+    const uint8_t *key_bytes = (const uint8_t *)key;
+    uint32_t h[4], y[4], z[4], v[4], i, j, k, bit;
+    for (k = 0; k < 4; k++) {
+        h[k] = ((uint32_t)key_bytes[4*k  ] << 24) | ((uint32_t)key_bytes[4*k+1] << 16) |
+               ((uint32_t)key_bytes[4*k+2] << 8 ) |  (uint32_t)key_bytes[4*k+3];
+    }
+    for (i = 0; i < cnt; i++) {
+        const uint8_t *bytes = (const uint8_t *)(data + i * blocks * 4);
+        uint8_t       *out   = (uint8_t *)(hash + i * 4);
+        for (k = 0; k < 4; k++) {
+            y[k] = 0;
+        }
+        for (j = 0; j < blocks; j++) {
+            for (k = 0; k < 4; k++) {
+                y[k] ^= ((uint32_t)bytes[16*j+4*k  ] << 24) | ((uint32_t)bytes[16*j+4*k+1] << 16) |
+                        ((uint32_t)bytes[16*j+4*k+2] << 8 ) |  (uint32_t)bytes[16*j+4*k+3];
+                z[k]  = 0;
+                v[k]  = h[k];
+            }
+            for (bit = 0; bit < 128; bit++) {
+                uint32_t lsb = v[3] & 1;
+                if ((y[bit / 32] >> (31 - bit % 32)) & 1) {
+                    for (k = 0; k < 4; k++) {
+                        z[k] ^= v[k];
+                    }
+                }
+                v[3] = (v[3] >> 1) | (v[2] << 31);
+                v[2] = (v[2] >> 1) | (v[1] << 31);
+                v[1] = (v[1] >> 1) | (v[0] << 31);
+                v[0] = (v[0] >> 1) ^ (lsb ? 0xE1000000u : 0);
+            }
+            for (k = 0; k < 4; k++) {
+                y[k] = z[k];
+            }
+        }
+        for (k = 0; k < 16; k++) {
+            out[k] = y[k / 4] >> (24 - 8 * (k % 4));
+        }
+    }
+}
+
+BENCH_CHECKSUM(0xDD61220A);
+
+int main(void) {
+    uint32_t seed = 1, i;
+    for (i = 0; i < 4; i++) {
+        hash_key[i]  = bench_rand(&seed) << 16;
+        hash_key[i] |= bench_rand(&seed);
+    }
+    for (i = 0; i < PKT_CNT * PKT_BLOCKS * 4; i++) {
+        pkt_data[i]  = bench_rand(&seed) << 16;
+        pkt_data[i] |= bench_rand(&seed);
+    }
+
+    ghash(PKT_CNT, PKT_BLOCKS, pkt_data, hash_key, pkt_hash);
+
+    vdata_start[0] = bench_hash(2166136261u, pkt_hash, PKT_CNT * 4);
+    spill_cache(vdata_start, vdata_end);
+}
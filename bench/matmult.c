@@ -0,0 +1,45 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// Integer matrix multiplication (based on matmult-int from Embench)
+
+#include "bench.h"
+
+#define N 20
+
+static int32_t mat_a[N * N];
+static int32_t mat_b[N * N];
+static int32_t mat_c[N * N];
+
+// void matmult(size_t n, const int32_t *a, const int32_t *b, int32_t *c)
+//
+// c = a * b for square n * n matrices stored in row-major order
+BENCH_KERNEL void matmult(uint32_t n, const int32_t *a, const int32_t *b, int32_t *c) {
+    uint32_t i, j, k;
+    for (i = 0; i < n; i++) {
+        for (j = 0; j < n; j++) {
+            int32_t sum = 0;
+            for (k = 0; k < n; k++) {
+                sum += a[i * n + k] * b[k * n + j];
+            }
+            c[i * n + j] = sum;
+        }
+    }
+}
+
+BENCH_CHECKSUM(0x740B8CB7);
+
+int main(void) {
+    uint32_t seed = 1, i;
+    for (i = 0; i < N * N; i++) {
+        mat_a[i] = (int32_t)(bench_rand(&seed) % 8095) - 4047;
+        mat_b[i] = (int32_t)(bench_rand(&seed) % 8095) - 4047;
+    }
+
+    matmult(N, mat_a, mat_b, mat_c);
+
+    vdata_start[0] = bench_hash(2166136261u, (const uint32_t *)mat_c, N * N);
+    spill_cache(vdata_start, vdata_end);
+}
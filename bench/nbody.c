@@ -0,0 +1,69 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// Integer N-body simulation (based on nbody from Embench, but using
+// fixed-point arithmetic and a linear spring force between all pairs of bodies
+// since Vicuna has neither floating-point nor division support)
+
+#include "bench.h"
+
+#define BODIES 64
+#define STEPS  4
+
+static int32_t body_pos[3][BODIES];
+static int32_t body_vel[3][BODIES];
+static int32_t body_acc[BODIES];
+static int32_t body_mass[BODIES];
+
+// void nbody_acc(size_t n, const int32_t *pos, const int32_t *mass,
+//                int32_t *acc)
+//
+// acc[i] = sum_j mass[j] * (pos[j] - pos[i]) for one spatial dimension
+BENCH_KERNEL void nbody_acc(uint32_t n, const int32_t *pos, const int32_t *mass, int32_t *acc) {
+    uint32_t i, j;
+    for (i = 0; i < n; i++) {
+        int32_t sum = 0;
+        for (j = 0; j < n; j++) {
+            sum += mass[j] * (pos[j] - pos[i]);
+        }
+        acc[i] = sum;
+    }
+}
+
+// void nbody_advance(size_t n, int32_t *pos, int32_t *vel, const int32_t *acc)
+//
+// vel[i] += acc[i] >> 8, pos[i] += vel[i] >> 4 for one spatial dimension
+BENCH_KERNEL void nbody_advance(uint32_t n, int32_t *pos, int32_t *vel, const int32_t *acc) {
+    uint32_t i;
+    for (i = 0; i < n; i++) {
+        vel[i] += acc[i] >> 8;
+        pos[i] += vel[i] >> 4;
+    }
+}
+
+BENCH_CHECKSUM(0xDC0852BB);
+
+int main(void) {
+    uint32_t seed = 1, i, d, step, hash;
+    for (i = 0; i < BODIES; i++) {
+        for (d = 0; d < 3; d++) {
+            body_pos[d][i] = (int32_t)(bench_rand(&seed) % 2048) - 1024;
+            body_vel[d][i] = (int32_t)(bench_rand(&seed) % 64) - 32;
+        }
+        body_mass[i] = (int32_t)(bench_rand(&seed) % 16) + 1;
+    }
+
+    for (step = 0; step < STEPS; step++) {
+        for (d = 0; d < 3; d++) {
+            nbody_acc(BODIES, body_pos[d], body_mass, body_acc);
+            nbody_advance(BODIES, body_pos[d], body_vel[d], body_acc);
+        }
+    }
+
+    hash = bench_hash(2166136261u, (const uint32_t *)body_pos, 3 * BODIES);
+    hash = bench_hash(hash, (const uint32_t *)body_vel, 3 * BODIES);
+    vdata_start[0] = hash;
+    spill_cache(vdata_start, vdata_end);
+}
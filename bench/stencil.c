@@ -0,0 +1,51 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// Iterative 2D 5-point stencil (Jacobi-style smoothing of a grid with fixed
+// boundary values)
+
+#include "bench.h"
+
+#define ROWS  32
+#define COLS  32
+#define STEPS 4
+
+// grid including a boundary of one element on each side
+#define GRID_W (COLS + 2)
+#define GRID_H (ROWS + 2)
+
+static int32_t grid[2][GRID_H * GRID_W];
+
+// void stencil(size_t rows, size_t cols, const int32_t *in, int32_t *out)
+//
+// out[i][j] = (in[i-1][j] + in[i+1][j] + in[i][j-1] + in[i][j+1] + 4 * in[i][j]) >> 3
+// for the interior rows * cols elements of a grid with a row stride of cols + 2
+BENCH_KERNEL void stencil(uint32_t rows, uint32_t cols, const int32_t *in, int32_t *out) {
+    uint32_t stride = cols + 2, i, j;
+    for (i = 1; i <= rows; i++) {
+        for (j = 1; j <= cols; j++) {
+            out[i * stride + j] = (in[(i - 1) * stride + j] + in[(i + 1) * stride + j] +
+                                   in[i * stride + j - 1] + in[i * stride + j + 1] +
+                                   4 * in[i * stride + j]) >> 3;
+        }
+    }
+}
+
+BENCH_CHECKSUM(0x25C00200);
+
+int main(void) {
+    uint32_t seed = 1, i, step;
+    for (i = 0; i < GRID_H * GRID_W; i++) {
+        grid[0][i] = (int32_t)(bench_rand(&seed) % 65536) - 32768;
+        grid[1][i] = grid[0][i];
+    }
+
+    for (step = 0; step < STEPS; step++) {
+        stencil(ROWS, COLS, grid[step & 1], grid[(step & 1) ^ 1]);
+    }
+
+    vdata_start[0] = bench_hash(2166136261u, (const uint32_t *)grid[STEPS & 1], GRID_H * GRID_W);
+    spill_cache(vdata_start, vdata_end);
+}
@@ -7,8 +7,8 @@
 # Create Project
 ################################################################################
 
-if {$argc != 7} {
-    puts "usage: gen_demo.tcl VPROC-DIR CORE-DIR PART CONSTR-FILE RAM-FILE DIFF-CLK CLK-PER"
+if {$argc != 8} {
+    puts "usage: gen_demo.tcl VPROC-DIR CORE-DIR PART CONSTR-FILE RAM-FILE DIFF-CLK CLK-PER MEM-W"
     exit 2
 }
 
@@ -20,6 +20,7 @@ set constr_file  [lindex $argv 3]
 set ram_file_var "RAM_FPATH=\"[lindex $argv 4]\""
 set diff_clk_var "DIFF_CLK=[lindex $argv 5]"
 set clk_per_var  "SYSCLK_PER=[lindex $argv 6]"
+set mem_w_var    "MEM_W=[lindex $argv 7]"
 
 # create project:
 set _xil_proj_name_ "vicuna_demo"
@@ -62,7 +63,9 @@ lappend src_list "$vproc_dir/demo/rtl/uart_tx.sv"
 foreach file {
     vproc_top.sv vproc_pkg.sv vproc_core.sv vproc_decoder.sv vproc_lsu.sv vproc_alu.sv
     vproc_mul.sv vproc_mul_block.sv vproc_sld.sv vproc_elem.sv vproc_hazards.sv vproc_vregfile.sv
-    vproc_vregpack.sv vproc_vregunpack.sv vproc_queue.sv
+    vproc_vregpack.sv vproc_vregunpack.sv vproc_queue.sv vproc_cache.sv vproc_perfmon.sv
+    vproc_tracebuf.sv vproc_cdc_fifo.sv vproc_cdc_bridge.sv vproc_xif.sv vproc_xif_ibex.sv
+    vproc_aes.sv
 } {
     lappend src_list "$vproc_dir/rtl/$file"
 }
@@ -83,8 +86,18 @@ if {[string first "ibex" $core_dir] != -1} {
     lappend src_list "$core_dir/syn/rtl/prim_clock_gating.v"
     lappend src_list "$core_dir/vendor/lowrisc_ip/dv/sv/dv_utils/"
     lappend src_list "$core_dir/vendor/lowrisc_ip/ip/prim/rtl/"
+} elseif {[string first "cv32e40x" $core_dir] != -1} {
+    set main_core "cv32e40x"
+    foreach file [glob -directory "$core_dir/rtl" *.sv] {
+        lappend src_list $file
+    }
+    lappend src_list "$core_dir/bhv/cv32e40x_sim_clock_gate.sv"
+    lappend src_list "$core_dir/rtl/include/"
 }
 add_files -fileset $obj -norecurse -scan_for_includes $src_list
+if {$main_core == "cv32e40x"} {
+    set_property verilog_define VPROC_CV32E40X [get_filesets {sources_1 sim_1}]
+}
 
 # add simulation only files:
 set obj [get_filesets sim_1]
@@ -102,5 +115,5 @@ set obj [get_filesets constrs_1]
 add_files -fileset $obj -norecurse $constr_file
 
 # set memory initialization files:
-set_property generic "$ram_file_var $diff_clk_var $clk_per_var" -objects [get_filesets sources_1]
-set_property generic "$ram_file_var $diff_clk_var $clk_per_var" -objects [get_filesets sim_1]
+set_property generic "$ram_file_var $diff_clk_var $clk_per_var $mem_w_var" -objects [get_filesets sources_1]
+set_property generic "$ram_file_var $diff_clk_var $clk_per_var $mem_w_var" -objects [get_filesets sim_1]
@@ -12,7 +12,9 @@ module demo_tb #(
         parameter bit          DIFF_CLK   = 1'b0,
         parameter real         SYSCLK_PER = 0.0,
         parameter int unsigned PLL_MUL    = 10,
-        parameter int unsigned PLL_DIV    = 20
+        parameter int unsigned PLL_DIV    = 20,
+        parameter int unsigned MEM_W      = 32,
+        parameter              UART_LOG   = "uart_log.txt"
     );
 
     logic clk, rst;
@@ -25,7 +27,8 @@ module demo_tb #(
         .DIFF_CLK   ( DIFF_CLK   ),
         .SYSCLK_PER ( SYSCLK_PER ),
         .PLL_MUL    ( PLL_MUL    ),
-        .PLL_DIV    ( PLL_DIV    )
+        .PLL_DIV    ( PLL_DIV    ),
+        .MEM_W      ( MEM_W      )
     ) soc (
         .sys_clk_pi ( clk        ),
         .sys_clk_ni ( ~clk       ),
@@ -48,4 +51,27 @@ module demo_tb #(
     end
 
     assign rx = 1'b1;
+
+    // UART receiver: writes each byte sent by the demo system to UART_LOG (one
+    // byte per line in hexadecimal, trace buffer dumps contained therein are
+    // decoded with tools/vtimeline -x) and prints it to the console
+    localparam real UART_BIT_PER = 1_000_000_000.0 / 115200; // in ns, like SYSCLK_PER
+
+    integer     uart_fd;
+    logic [7:0] uart_byte;
+    initial begin
+        uart_fd = $fopen(UART_LOG, "w");
+        forever begin
+            @(negedge tx);
+            // sample each data bit in the middle
+            #(UART_BIT_PER * 1.5);
+            for (int i = 0; i < 8; i++) begin
+                uart_byte[i] = tx;
+                #(UART_BIT_PER);
+            end
+            $fwrite(uart_fd, "%02x\n", uart_byte);
+            $fflush(uart_fd);
+            $write("%c", uart_byte);
+        end
+    end
 endmodule
@@ -4,13 +4,17 @@
 
 
 module demo_top #(
-        parameter              MAIN_CORE  = "",
-        parameter              RAM_FPATH  = "",
-        parameter int unsigned RAM_SIZE   = 262144,
-        parameter bit          DIFF_CLK   = 1'b0,
-        parameter real         SYSCLK_PER = 0.0,
-        parameter int unsigned PLL_MUL    = 10,
-        parameter int unsigned PLL_DIV    = 20
+        parameter              MAIN_CORE      = "",
+        parameter              RAM_FPATH      = "",
+        parameter int unsigned RAM_SIZE       = 262144,
+        parameter bit          DIFF_CLK       = 1'b0,
+        parameter real         SYSCLK_PER     = 0.0,
+        parameter int unsigned PLL_MUL        = 10,
+        parameter int unsigned PLL_DIV        = 20,
+        parameter int unsigned TRACE_LEN      = 1024,
+        parameter int unsigned UART_BAUD_RATE = 115200, // UART baud rate after reset
+        parameter int unsigned MEM_W          = 32,     // memory bus and RAM width (32 to 512)
+        parameter int unsigned VMEM_W         = MEM_W   // vector memory interface width
     )
     (
         input  logic sys_clk_pi,
@@ -25,6 +29,13 @@ module demo_top #(
     localparam logic [31:0] MEM_START = 32'h00000000;
     localparam logic [31:0] MEM_MASK  = RAM_SIZE-1;
 
+    // the demo has no data cache, since it would also cache the memory-mapped
+    // registers, hence the vector memory interface spans the whole memory bus
+    if (VMEM_W != MEM_W) begin
+        $fatal(1, "The demo requires equal widths of the memory bus MEM_W and of the vector ",
+                  "memory interface VMEM_W.  Currently, MEM_W == %d and VMEM_W == %d.", MEM_W, VMEM_W);
+    end
+
 
     logic sys_clk;
     generate
@@ -68,14 +79,14 @@ module demo_top #(
     logic rst_n;
     assign rst_n = sys_rst_ni & pll_lock;
 
-    logic        mem_req;
-    logic [31:0] mem_addr;
-    logic        mem_we;
-    logic  [3:0] mem_be;
-    logic [31:0] mem_wdata;
-    logic        mem_rvalid;
-    logic        mem_err;
-    logic [31:0] mem_rdata;
+    logic               mem_req;
+    logic [31:0]        mem_addr;
+    logic               mem_we;
+    logic [MEM_W/8-1:0] mem_be;
+    logic [MEM_W  -1:0] mem_wdata;
+    logic               mem_rvalid;
+    logic               mem_err;
+    logic [MEM_W  -1:0] mem_rdata;
 
     always_ff @(posedge clk or negedge rst_n) begin
         if (!rst_n) begin
@@ -85,63 +96,101 @@ module demo_top #(
         end
     end
 
+    logic        trace_ctl_we;
+    logic [1:0]  trace_ctl;
+    logic [31:0] trace_stat;
+    logic        trace_rd;
+    logic [31:0] trace_rdata;
+    logic        uart_irq;
+
     vproc_top #(
-        .MAIN_CORE    ( MAIN_CORE                   ),
-        .VREG_W       ( 2048                        ),
-        .VMEM_W       ( 32                          ),
-        .VMUL_W       ( 1024                        ),
-        .RAM_TYPE     ( vproc_pkg::RAM_XLNX_RAM32M  ),
-        .MUL_TYPE     ( vproc_pkg::MUL_XLNX_DSP48E1 )
+        .MEM_W          ( MEM_W                       ),
+        .MAIN_CORE      ( MAIN_CORE                   ),
+        .VREG_W         ( 2048                        ),
+        .VMEM_W         ( VMEM_W                      ),
+        .VMUL_W         ( 1024                        ),
+        .RAM_TYPE       ( vproc_pkg::RAM_XLNX_RAM32M  ),
+        .MUL_TYPE       ( vproc_pkg::MUL_XLNX_DSP48E1 ),
+        .TRACE_BUF_LEN  ( TRACE_LEN                   )
     ) vproc (
-        .clk_i        ( clk                         ),
-        .rst_ni       ( rst_n                       ),
-        .mem_req_o    ( mem_req                     ),
-        .mem_addr_o   ( mem_addr                    ),
-        .mem_we_o     ( mem_we                      ),
-        .mem_be_o     ( mem_be                      ),
-        .mem_wdata_o  ( mem_wdata                   ),
-        .mem_rvalid_i ( mem_rvalid                  ),
-        .mem_err_i    ( mem_err                     ),
-        .mem_rdata_i  ( mem_rdata                   )
+        .clk_i          ( clk                         ),
+        .vclk_i         ( clk                         ),
+        .rst_ni         ( rst_n                       ),
+        .mem_req_o      ( mem_req                     ),
+        .mem_addr_o     ( mem_addr                    ),
+        .mem_we_o       ( mem_we                      ),
+        .mem_be_o       ( mem_be                      ),
+        .mem_wdata_o    ( mem_wdata                   ),
+        .mem_rvalid_i   ( mem_rvalid                  ),
+        .mem_err_i      ( mem_err                     ),
+        .mem_rdata_i    ( mem_rdata                   ),
+        .irq_fast_i     ( {14'b0, uart_irq}           ),
+        .trace_ctl_we_i ( trace_ctl_we                ),
+        .trace_ctl_i    ( trace_ctl                   ),
+        .trace_stat_o   ( trace_stat                  ),
+        .trace_rd_i     ( trace_rd                    ),
+        .trace_rdata_o  ( trace_rdata                 )
     );
 
-    logic        sram_rvalid;
-    logic [31:0] sram_rdata;
-    logic        hwreg_rvalid;
-    logic [31:0] hwreg_rdata;
+    logic               sram_rvalid;
+    logic [MEM_W  -1:0] sram_rdata;
+    logic               hwreg_rvalid;
+    logic [31:0]        hwreg_rdata;
 
+    // the registers are 32 bits wide; the main core receives read data from
+    // the lane of the memory bus selected by the address, and its write data
+    // is replicated to all lanes, hence the registers are decoded from the
+    // full byte address and read data is replicated to all lanes
     assign mem_err   = mem_rvalid & (~(sram_rvalid | hwreg_rvalid));
-    assign mem_rdata = hwreg_rvalid ? hwreg_rdata : sram_rdata;
+    assign mem_rdata = hwreg_rvalid ? {(MEM_W/32){hwreg_rdata}} : sram_rdata;
+
+    logic               dma_req;
+    logic [31:0]        dma_addr;
+    logic [MEM_W  -1:0] dma_rdata;
 
-    ram32 #(
-        .SIZE      ( RAM_SIZE / 4                                    ),
-        .INIT_FILE ( RAM_FPATH                                       )
+    ram #(
+        .WIDTH      ( MEM_W                                           ),
+        .SIZE       ( RAM_SIZE / (MEM_W/8)                            ),
+        .INIT_FILE  ( RAM_FPATH                                       )
     ) u_ram (
-        .clk_i     ( clk                                             ),
-        .rst_ni    ( rst_n                                           ),
-        .req_i     ( mem_req & ((mem_addr & ~MEM_MASK) == MEM_START) ),
-        .we_i      ( mem_req & mem_we                                ),
-        .be_i      ( mem_be                                          ),
-        .addr_i    ( mem_addr                                        ),
-        .wdata_i   ( mem_wdata                                       ),
-        .rvalid_o  ( sram_rvalid                                     ),
-        .rdata_o   ( sram_rdata                                      )
+        .clk_i      ( clk                                             ),
+        .rst_ni     ( rst_n                                           ),
+        .req_i      ( mem_req & ((mem_addr & ~MEM_MASK) == MEM_START) ),
+        .we_i       ( mem_req & mem_we                                ),
+        .be_i       ( mem_be                                          ),
+        .addr_i     ( mem_addr                                        ),
+        .wdata_i    ( mem_wdata                                       ),
+        .rvalid_o   ( sram_rvalid                                     ),
+        .rdata_o    ( sram_rdata                                      ),
+        .rd_req_i   ( dma_req                                         ),
+        .rd_addr_i  ( dma_addr                                        ),
+        .rd_rdata_o ( dma_rdata                                       )
     );
 
     hwreg_iface #(
         .CLK_FREQ       ( CLK_FREQ                                ),
-        .UART_BAUD_RATE ( 115200                                  )
+        .UART_BAUD_RATE ( UART_BAUD_RATE                          ),
+        .MEM_W          ( MEM_W                                   )
     ) hwregs (
         .clk_i          ( clk                                     ),
         .rst_ni         ( rst_n                                   ),
         .req_i          ( mem_req & (mem_addr[31:16] == 16'hFF00) ),
         .we_i           ( mem_we                                  ),
         .addr_i         ( mem_addr[15:0]                          ),
-        .wdata_i        ( mem_wdata                               ),
+        .wdata_i        ( mem_wdata[31:0]                         ),
         .rvalid_o       ( hwreg_rvalid                            ),
         .rdata_o        ( hwreg_rdata                             ),
         .rx_i           ( uart_rx_i                               ),
-        .tx_o           ( uart_tx_o                               )
+        .tx_o           ( uart_tx_o                               ),
+        .irq_o          ( uart_irq                                ),
+        .dma_req_o      ( dma_req                                 ),
+        .dma_addr_o     ( dma_addr                                ),
+        .dma_rdata_i    ( dma_rdata                               ),
+        .trace_ctl_we_o ( trace_ctl_we                            ),
+        .trace_ctl_o    ( trace_ctl                               ),
+        .trace_stat_i   ( trace_stat                              ),
+        .trace_rd_o     ( trace_rd                                ),
+        .trace_rdata_i  ( trace_rdata                             )
     );
 
 endmodule
@@ -149,41 +198,81 @@ endmodule
 
 module hwreg_iface #(
         parameter int unsigned CLK_FREQ       = 100_000_000,
-        parameter int unsigned UART_BAUD_RATE = 115200
+        parameter int unsigned UART_BAUD_RATE = 115200,
+        parameter int unsigned MEM_W          = 32
     )
     (
-        input  logic          clk_i,
-        input  logic          rst_ni,
-        input  logic          req_i,
-        input  logic          we_i,
-        input  logic [15:0]   addr_i,
-        input  logic [31:0]   wdata_i,
-        output logic          rvalid_o,
-        output logic [31:0]   rdata_o,
-
-        input  logic          rx_i,
-        output logic          tx_o
+        input  logic               clk_i,
+        input  logic               rst_ni,
+        input  logic               req_i,
+        input  logic               we_i,
+        input  logic [15:0]        addr_i,
+        input  logic [31:0]        wdata_i,
+        output logic               rvalid_o,
+        output logic [31:0]        rdata_o,
+
+        input  logic               rx_i,
+        output logic               tx_o,
+        output logic               irq_o,
+
+        // read port of the RAM used by the DMA (read data is valid one cycle
+        // after the request)
+        output logic               dma_req_o,
+        output logic [31:0]        dma_addr_o,
+        input  logic [MEM_W-1:0]   dma_rdata_i,
+
+        output logic               trace_ctl_we_o,
+        output logic [1:0]         trace_ctl_o,
+        input  logic [31:0]        trace_stat_i,
+        output logic               trace_rd_o,
+        input  logic [31:0]        trace_rdata_i
     );
 
-    localparam logic [13:0] ADDR_UART_DATA   = 16'h0000 >> 2;
-    localparam logic [13:0] ADDR_UART_STATUS = 16'h0004 >> 2;
+    localparam int unsigned UART_DIV_RST = CLK_FREQ / UART_BAUD_RATE;
+    if (UART_DIV_RST == 0 || UART_DIV_RST > 16'hFFFF) begin
+        $fatal(1, "The UART bit period CLK_FREQ / UART_BAUD_RATE must be between 1 and 65535 ",
+                  "clock cycles.  The current value of %d is invalid.", UART_DIV_RST);
+    end
+
+    localparam logic [13:0] ADDR_UART_DATA     = 16'h0000 >> 2;
+    localparam logic [13:0] ADDR_UART_STATUS   = 16'h0004 >> 2;
+    localparam logic [13:0] ADDR_TRACE_CTL     = 16'h0008 >> 2;
+    localparam logic [13:0] ADDR_TRACE_DUMP    = 16'h000C >> 2;
+    localparam logic [13:0] ADDR_UART_DIV      = 16'h0010 >> 2;
+    localparam logic [13:0] ADDR_UART_IRQ_EN   = 16'h0014 >> 2;
+    localparam logic [13:0] ADDR_UART_IRQ_PEND = 16'h0018 >> 2;
+    localparam logic [13:0] ADDR_DMA_ADDR      = 16'h001C >> 2;
+    localparam logic [13:0] ADDR_DMA_LEN       = 16'h0020 >> 2;
 
     logic       uart_req;
-    logic       uart_wbusy;
+    logic       uart_we;
+    logic [7:0] uart_wdata;
+    logic       uart_wfull;
+    logic       uart_tx_idle;
     logic       uart_rvalid;
     logic [7:0] uart_rdata;
 
     assign uart_req = req_i && addr_i[15:2] == ADDR_UART_DATA;
 
-    uart_iface #(
-        .CLK_FREQ       ( CLK_FREQ          ),
-        .BAUD_RATE      ( UART_BAUD_RATE    )
-    ) uart (
+    // UART bit period in clock cycles
+    logic [15:0] uart_div_q;
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (~rst_ni) begin
+            uart_div_q <= 16'(UART_DIV_RST);
+        end
+        else if (req_i && we_i && addr_i[15:2] == ADDR_UART_DIV) begin
+            uart_div_q <= wdata_i[15:0];
+        end
+    end
+
+    uart_iface uart (
         .clk_i          ( clk_i             ),
         .rst_ni         ( rst_ni            ),
-        .we_i           ( uart_req && we_i  ),
-        .wdata_i        ( wdata_i[7:0]      ),
-        .wbusy_o        ( uart_wbusy        ),
+        .pulse_width_i  ( uart_div_q        ),
+        .we_i           ( uart_we           ),
+        .wdata_i        ( uart_wdata        ),
+        .wfull_o        ( uart_wfull        ),
+        .tx_idle_o      ( uart_tx_idle      ),
         .read_i         ( uart_req && !we_i ),
         .rvalid_o       ( uart_rvalid       ),
         .rdata_o        ( uart_rdata        ),
@@ -192,15 +281,180 @@ module hwreg_iface #(
         .tx_o           ( tx_o              )
     );
 
+    // Trace buffer control: writing to TRACE_CTL controls the recording
+    // (bit 0 enables recording, writing a 1 to bit 1 clears the trace buffer)
+    // and reading returns the trace status.  Writing to TRACE_DUMP sends the
+    // magic bytes "VTRC", the trace status word, and all entries of the trace
+    // buffer over the UART (each word in little-endian byte order), which is
+    // decoded on the host with tools/vtimeline.  Reading TRACE_DUMP returns 1
+    // while the dump is in progress, during which the UART is reported as busy
+    // and writes to UART_DATA are ignored.
+    assign trace_ctl_we_o = req_i && we_i && addr_i[15:2] == ADDR_TRACE_CTL;
+    assign trace_ctl_o    = wdata_i[1:0];
+
+    logic        dump_q;            // dump in progress
+    logic [1:0]  dump_word_q;       // 0: magic bytes, 1: status, 2: entries
+    logic [1:0]  dump_byte_q;       // index of the next byte of the current word
+    logic [31:0] dump_stat_q;       // trace status at the start of the dump
+    logic [29:0] dump_cnt_q;        // number of remaining entries
+    logic [31:0] dump_word;
+    logic        dump_tx;
+    always_comb begin
+        dump_word = trace_rdata_i;
+        if (dump_word_q == 2'd0) begin
+            dump_word = 32'h43525456; // "VTRC"
+        end
+        else if (dump_word_q == 2'd1) begin
+            dump_word = dump_stat_q;
+        end
+    end
+    assign dump_tx    = dump_q & ~uart_wfull;
+    assign trace_rd_o = dump_tx & (dump_word_q == 2'd2) & (dump_byte_q == 2'd3);
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (~rst_ni) begin
+            dump_q      <= 1'b0;
+            dump_word_q <= '0;
+            dump_byte_q <= '0;
+            dump_stat_q <= '0;
+            dump_cnt_q  <= '0;
+        end else begin
+            if (~dump_q) begin
+                if (req_i && we_i && addr_i[15:2] == ADDR_TRACE_DUMP) begin
+                    dump_q      <= 1'b1;
+                    dump_word_q <= 2'd0;
+                    dump_byte_q <= 2'd0;
+                    dump_stat_q <= trace_stat_i;
+                    dump_cnt_q  <= trace_stat_i[29:0];
+                end
+            end
+            else if (dump_tx) begin
+                dump_byte_q <= dump_byte_q + 1;
+                if (dump_byte_q == 2'd3) begin
+                    if (dump_word_q != 2'd2) begin
+                        dump_word_q <= dump_word_q + 1;
+                    end else begin
+                        dump_cnt_q <= dump_cnt_q - 1;
+                    end
+                    if ((dump_word_q == 2'd1 && dump_cnt_q == '0) ||
+                        (dump_word_q == 2'd2 && dump_cnt_q == 30'd1)) begin
+                        dump_q <= 1'b0;
+                    end
+                end
+            end
+        end
+    end
+
+    // Console DMA: writing the number of bytes to DMA_LEN sends that many
+    // bytes starting at the address in DMA_ADDR over the UART without any
+    // involvement of the core.  Bytes are fetched one at a time through the
+    // second read port of the RAM and pushed into the transmit FIFO whenever
+    // neither a trace dump nor a write to UART_DATA occupies it.  Reading
+    // DMA_LEN returns the number of remaining bytes; writes to DMA_ADDR and
+    // DMA_LEN are ignored while a transfer is in progress.  The end of a
+    // transfer sets the sticky DMA done flag in UART_IRQ_PEND.
+    logic [31:0] dma_addr_q;
+    logic [31:0] dma_len_q;         // number of remaining bytes
+    logic        dma_fetch_q;       // fetched byte is available in the next cycle
+    logic        dma_valid_q;       // fetched byte is ready to be sent
+    logic [7:0]  dma_byte_q;
+    logic        dma_done_q;        // sticky transfer done flag
+    logic        dma_busy;
+    logic        dma_tx;
+    assign dma_busy   = dma_len_q != '0;
+    assign dma_req_o  = dma_busy & ~dma_fetch_q & ~dma_valid_q;
+    assign dma_addr_o = dma_addr_q;
+    assign dma_tx     = dma_valid_q & ~dump_q & ~uart_wfull & ~(uart_req && we_i);
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (~rst_ni) begin
+            dma_addr_q  <= '0;
+            dma_len_q   <= '0;
+            dma_fetch_q <= 1'b0;
+            dma_valid_q <= 1'b0;
+            dma_byte_q  <= '0;
+            dma_done_q  <= 1'b0;
+        end else begin
+            dma_fetch_q <= dma_req_o;
+            if (dma_fetch_q) begin
+                dma_valid_q <= 1'b1;
+                dma_byte_q  <= dma_rdata_i[8*dma_addr_q[$clog2(MEM_W/8)-1:0] +: 8];
+            end
+            if (dma_tx) begin
+                dma_valid_q <= 1'b0;
+                dma_addr_q  <= dma_addr_q + 1;
+                dma_len_q   <= dma_len_q  - 1;
+                if (dma_len_q == 32'd1) begin
+                    dma_done_q <= 1'b1;
+                end
+            end
+            if (req_i && we_i && ~dma_busy) begin
+                if (addr_i[15:2] == ADDR_DMA_ADDR) begin
+                    dma_addr_q <= wdata_i;
+                end
+                if (addr_i[15:2] == ADDR_DMA_LEN) begin
+                    dma_len_q <= wdata_i;
+                end
+            end
+            if (req_i && we_i && addr_i[15:2] == ADDR_UART_IRQ_PEND && wdata_i[2]) begin
+                dma_done_q <= 1'b0;
+            end
+        end
+    end
+
+    // Transmit FIFO arbitration: a trace dump has exclusive access, otherwise
+    // writes to UART_DATA take precedence over the DMA (bytes written while
+    // the transmit FIFO is full are dropped)
+    always_comb begin
+        uart_we    = uart_req && we_i;
+        uart_wdata = wdata_i[7:0];
+        if (dump_q) begin
+            uart_we    = dump_tx;
+            uart_wdata = dump_word[8*dump_byte_q +: 8];
+        end
+        else if (dma_tx) begin
+            uart_we    = 1'b1;
+            uart_wdata = dma_byte_q;
+        end
+    end
+
+    // Interrupts: the interrupt line is asserted while any of the pending
+    // conditions in UART_IRQ_PEND is enabled in UART_IRQ_EN (bit 0: received
+    // byte available, bit 1: transmitter idle, bit 2: DMA transfer done).  The
+    // first two conditions are cleared by reading UART_DATA and writing to
+    // UART_DATA, respectively, while the DMA done flag is cleared by writing a
+    // 1 to bit 2 of UART_IRQ_PEND.
+    logic [2:0] irq_en_q, irq_pend;
+    logic       irq_q;
+    assign irq_pend = {dma_done_q, uart_tx_idle & ~dump_q & ~dma_busy, uart_rvalid};
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (~rst_ni) begin
+            irq_en_q <= '0;
+            irq_q    <= 1'b0;
+        end else begin
+            if (req_i && we_i && addr_i[15:2] == ADDR_UART_IRQ_EN) begin
+                irq_en_q <= wdata_i[2:0];
+            end
+            irq_q <= (irq_pend & irq_en_q) != '0;
+        end
+    end
+    assign irq_o = irq_q;
+
     logic [31:0] rdata;
     logic        rvalid;
 
     always_ff @(posedge clk_i) begin
         unique case (addr_i[15:2])
-            ADDR_UART_DATA:   rdata <= uart_rvalid ? uart_rdata : 32'hFFFFFFFF;
-            ADDR_UART_STATUS: rdata <= { 30'h0, uart_rvalid, uart_wbusy };
-
-            default:          rdata <= 0;
+            ADDR_UART_DATA:     rdata <= uart_rvalid ? uart_rdata : 32'hFFFFFFFF;
+            ADDR_UART_STATUS:   rdata <= { 28'h0, dma_busy, irq_pend[1], uart_rvalid,
+                                           uart_wfull | dump_q | dma_busy };
+            ADDR_TRACE_CTL:     rdata <= trace_stat_i;
+            ADDR_TRACE_DUMP:    rdata <= { 31'h0, dump_q };
+            ADDR_UART_DIV:      rdata <= { 16'h0, uart_div_q };
+            ADDR_UART_IRQ_EN:   rdata <= { 29'h0, irq_en_q };
+            ADDR_UART_IRQ_PEND: rdata <= { 29'h0, irq_pend };
+            ADDR_DMA_ADDR:      rdata <= dma_addr_q;
+            ADDR_DMA_LEN:       rdata <= dma_len_q;
+
+            default:            rdata <= 0;
         endcase
         rvalid <= req_i;
     end
@@ -210,77 +464,89 @@ module hwreg_iface #(
 endmodule
 
 
+// UART with transmit and receive FIFOs and a run-time configurable bit period
 module uart_iface #(
-        parameter int unsigned CLK_FREQ  = 100_000_000,
-        parameter int unsigned BAUD_RATE = 115200
+        parameter int unsigned FIFO_DEPTH = 16
     )
     (
         input  logic          clk_i,
         input  logic          rst_ni,
 
-        input  logic          we_i,
+        input  logic [15:0]   pulse_width_i, // bit period in clock cycles
+
+        input  logic          we_i,          // push a byte into the transmit FIFO
         input  logic [7:0]    wdata_i,
-        output logic          wbusy_o,
-        input  logic          read_i,
-        output logic          rvalid_o,
+        output logic          wfull_o,       // transmit FIFO is full
+        output logic          tx_idle_o,     // transmit FIFO is empty and all bytes sent
+        input  logic          read_i,        // pop a byte from the receive FIFO
+        output logic          rvalid_o,      // receive FIFO is not empty
         output logic [7:0]    rdata_o,
 
         input  logic          rx_i,
         output logic          tx_o
     );
 
-    localparam UART_RX_QUEUE_LEN = 8;
+    logic       tx_fifo_ready;
+    logic       tx_valid, tx_ready;
+    logic [7:0] tx_data;
+    vproc_queue #(
+        .WIDTH        ( 8             ),
+        .DEPTH        ( FIFO_DEPTH    )
+    ) tx_fifo (
+        .clk_i        ( clk_i         ),
+        .async_rst_ni ( rst_ni        ),
+        .sync_rst_ni  ( 1'b1          ),
+        .enq_ready_o  ( tx_fifo_ready ),
+        .enq_valid_i  ( we_i          ),
+        .enq_data_i   ( wdata_i       ),
+        .deq_ready_i  ( tx_ready      ),
+        .deq_valid_o  ( tx_valid      ),
+        .deq_data_o   ( tx_data       )
+    );
+    assign wfull_o = ~tx_fifo_ready;
 
-    logic tx_ready;
     uart_tx #(
-        .DATA_WIDTH ( 8         ),
-        .BAUD_RATE  ( BAUD_RATE ),
-        .CLK_FREQ   ( CLK_FREQ  )
+        .DATA_WIDTH    ( 8             ),
+        .PULSE_W       ( 16            )
     ) tx_inst (
-        .clk_i      ( clk_i     ),
-        .rst_ni     ( rst_ni    ),
-        .valid_i    ( we_i      ),
-        .data_i     ( wdata_i   ),
-        .ready_o    ( tx_ready  ),
-        .tx_o       ( tx_o      )
+        .clk_i         ( clk_i         ),
+        .rst_ni        ( rst_ni        ),
+        .pulse_width_i ( pulse_width_i ),
+        .valid_i       ( tx_valid      ),
+        .data_i        ( tx_data       ),
+        .ready_o       ( tx_ready      ),
+        .tx_o          ( tx_o          )
     );
-    assign wbusy_o = ~tx_ready;
+    assign tx_idle_o = ~tx_valid & tx_ready;
 
     logic       rx_valid;
     logic [7:0] rx_data;
     uart_rx #(
-        .DATA_WIDTH ( 8         ),
-        .BAUD_RATE  ( BAUD_RATE ),
-        .CLK_FREQ   ( CLK_FREQ  )
+        .DATA_WIDTH    ( 8             ),
+        .PULSE_W       ( 16            )
     ) rx_inst (
-        .clk_i      ( clk_i     ),
-        .rst_ni     ( rst_ni    ),
-        .rx_i       ( rx_i      ),
-        .ready_i    ( 1'b1      ),
-        .valid_o    ( rx_valid  ),
-        .data_o     ( rx_data   )
+        .clk_i         ( clk_i         ),
+        .rst_ni        ( rst_ni        ),
+        .pulse_width_i ( pulse_width_i ),
+        .rx_i          ( rx_i          ),
+        .ready_i       ( 1'b1          ),
+        .valid_o       ( rx_valid      ),
+        .data_o        ( rx_data       )
     );
 
-    logic       rvalid [UART_RX_QUEUE_LEN-1:0] = '{default: 0};
-    logic [7:0] rdata  [UART_RX_QUEUE_LEN-1:0] = '{default: 0};
-
-    always_ff @(posedge clk_i) begin
-        if (rvalid[0] == 0) begin
-            for (int i = 0; i < UART_RX_QUEUE_LEN-1; i++) begin
-                rvalid[i] <= rvalid[i+1];
-                rdata [i] <= rdata [i+1];
-            end
-            rvalid[UART_RX_QUEUE_LEN-1] <= 0;
-        end
-
-        if (rx_valid) begin
-            rvalid[UART_RX_QUEUE_LEN-1] <= 1;
-            rdata [UART_RX_QUEUE_LEN-1] <= rx_data;
-        end
-        if (rvalid[0] && read_i)
-            rvalid[0] <= 0;
-    end
-
-    assign rvalid_o = rvalid[0];
-    assign rdata_o = rdata[0];
+    // received bytes are dropped while the receive FIFO is full
+    vproc_queue #(
+        .WIDTH        ( 8             ),
+        .DEPTH        ( FIFO_DEPTH    )
+    ) rx_fifo (
+        .clk_i        ( clk_i         ),
+        .async_rst_ni ( rst_ni        ),
+        .sync_rst_ni  ( 1'b1          ),
+        .enq_ready_o  (               ),
+        .enq_valid_i  ( rx_valid      ),
+        .enq_data_i   ( rx_data       ),
+        .deq_ready_i  ( read_i        ),
+        .deq_valid_o  ( rvalid_o      ),
+        .deq_data_o   ( rdata_o       )
+    );
 endmodule
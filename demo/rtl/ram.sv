@@ -3,40 +3,61 @@
 // SPDX-License-Identifier: ISC
 
 
-// Simple single-port RAM with 32-bit words and byte enable
-module ram32
+// Simple RAM with WIDTH-bit words, a read-write port with byte enable, and a
+// second read-only port (used by the console DMA); the initialization file
+// contains 32-bit words (as generated by sw/Makefile), which are packed into
+// the RAM words in little-endian order
+module ram
     #(
-        parameter SIZE = 16384, // 64 K
+        parameter int unsigned WIDTH = 32,    // word width in bits (32 to 512)
+        parameter int unsigned SIZE  = 16384, // number of words
         parameter INIT_FILE
     )
     (
-        input               clk_i,
-        input               rst_ni,
-
-        input               req_i,
-        input               we_i,
-        input        [ 3:0] be_i,
-        input        [31:0] addr_i,
-        input        [31:0] wdata_i,
-        output logic        rvalid_o,
-        output logic [31:0] rdata_o
+        input                      clk_i,
+        input                      rst_ni,
+
+        input                      req_i,
+        input                      we_i,
+        input        [WIDTH/8-1:0] be_i,
+        input        [31:0]        addr_i,
+        input        [WIDTH  -1:0] wdata_i,
+        output logic               rvalid_o,
+        output logic [WIDTH  -1:0] rdata_o,
+
+        input                      rd_req_i,
+        input        [31:0]        rd_addr_i,
+        output logic [WIDTH  -1:0] rd_rdata_o
     );
 
+    if (WIDTH < 32 || WIDTH > 512 || (WIDTH & (WIDTH - 1)) != 0) begin
+        $fatal(1, "The RAM word width WIDTH must be a power of two between 32 and 512.  ",
+                  "The current value of %d is invalid.", WIDTH);
+    end
+
     localparam int ADDR_W = $clog2(SIZE);
+    localparam int BYTE_W = $clog2(WIDTH/8);
 
-    logic [31:0] mem[SIZE];
+    logic [WIDTH-1:0] mem[SIZE];
     logic [ADDR_W-1:0] mem_addr;
-    assign mem_addr = addr_i[ADDR_W-1+2:2];
+    assign mem_addr = addr_i[ADDR_W-1+BYTE_W:BYTE_W];
+    logic [ADDR_W-1:0] rd_addr;
+    assign rd_addr  = rd_addr_i[ADDR_W-1+BYTE_W:BYTE_W];
 
     always @(posedge clk_i) begin
         if (req_i && we_i) begin
-            for (int i = 0; i < 4; i++)
+            for (int i = 0; i < WIDTH/8; i++)
                 if (be_i[i] == 1'b1)
                     mem[mem_addr][i*8 +: 8] <= wdata_i[i*8 +: 8];
         end
         rdata_o <= mem[mem_addr];
     end
 
+    always @(posedge clk_i) begin
+        if (rd_req_i)
+            rd_rdata_o <= mem[rd_addr];
+    end
+
     always_ff @(posedge clk_i or negedge rst_ni) begin
         if (!rst_ni) begin
             rvalid_o <= '0;
@@ -45,7 +66,11 @@ module ram32
         end
     end
 
+    logic [31:0] init_words[SIZE*(WIDTH/32)];
     initial begin
-        $readmemh(INIT_FILE, mem);
+        $readmemh(INIT_FILE, init_words);
+        for (int i = 0; i < SIZE; i++)
+            for (int j = 0; j < WIDTH/32; j++)
+                mem[i][j*32 +: 32] = init_words[i*(WIDTH/32) + j];
     end
 endmodule
@@ -25,13 +25,14 @@
 
 module uart_rx #(
         parameter DATA_WIDTH = 8,
-        parameter BAUD_RATE  = 115200,
-        parameter CLK_FREQ   = 100_000_000
+        parameter PULSE_W    = 16   // width of the bit period in clock cycles
     )
     (
         input  logic                  clk_i,
         input  logic                  rst_ni,
 
+        input  logic [PULSE_W-1:0]    pulse_width_i, // bit period (CLK_FREQ / BAUD_RATE)
+
         input  logic                  rx_i,
         input  logic                  ready_i,
         output logic                  valid_o,
@@ -39,9 +40,11 @@ module uart_rx #(
     );
 
     localparam LB_DATA_WIDTH    = $clog2(DATA_WIDTH);
-    localparam PULSE_WIDTH      = CLK_FREQ / BAUD_RATE;
-    localparam LB_PULSE_WIDTH   = $clog2(PULSE_WIDTH);
-    localparam HALF_PULSE_WIDTH = PULSE_WIDTH / 2;
+    localparam LB_PULSE_WIDTH   = PULSE_W;
+
+    logic [LB_PULSE_WIDTH:0]   pulse_width, half_pulse_width;
+    assign pulse_width      = {1'b0, pulse_width_i};
+    assign half_pulse_width = {2'b0, pulse_width_i[PULSE_W-1:1]};
 
     //-----------------------------------------------------------------------------
     // noise removing filter
@@ -127,7 +130,7 @@ module uart_rx #(
                end
                else begin
                   data_tmp_r <= {sig_r, data_tmp_r[DATA_WIDTH-1:1]};
-                  clk_cnt    <= PULSE_WIDTH;
+                  clk_cnt    <= pulse_width;
 
                   if(data_cnt == DATA_WIDTH - 1) begin
                      state <= STT_STOP;
@@ -157,7 +160,7 @@ module uart_rx #(
             // next state : when start bit is observed -> STT_DATA
             STT_WAIT: begin
                if(sig_r == 0) begin
-                  clk_cnt  <= PULSE_WIDTH + HALF_PULSE_WIDTH;
+                  clk_cnt  <= pulse_width + half_pulse_width;
                   data_cnt <= 0;
                   state    <= STT_DATA;
                end
@@ -25,13 +25,14 @@
 
 module uart_tx #(
         parameter DATA_WIDTH = 8,
-        parameter BAUD_RATE  = 115200,
-        parameter CLK_FREQ   = 100_000_000
+        parameter PULSE_W    = 16   // width of the bit period in clock cycles
     )
     (
         input  logic                  clk_i,
         input  logic                  rst_ni,
 
+        input  logic [PULSE_W-1:0]    pulse_width_i, // bit period (CLK_FREQ / BAUD_RATE)
+
         input  logic                  valid_i,
         input  logic [DATA_WIDTH-1:0] data_i,
         output logic                  ready_o,
@@ -39,9 +40,11 @@ module uart_tx #(
     );
 
     localparam LB_DATA_WIDTH    = $clog2(DATA_WIDTH);
-    localparam PULSE_WIDTH      = CLK_FREQ / BAUD_RATE;
-    localparam LB_PULSE_WIDTH   = $clog2(PULSE_WIDTH);
-    localparam HALF_PULSE_WIDTH = PULSE_WIDTH / 2;
+    localparam LB_PULSE_WIDTH   = PULSE_W;
+
+    logic [LB_PULSE_WIDTH:0]   pulse_width, half_pulse_width;
+    assign pulse_width      = {1'b0, pulse_width_i};
+    assign half_pulse_width = {2'b0, pulse_width_i[PULSE_W-1:1]};
 
     typedef enum logic [1:0] {STT_DATA,
                               STT_STOP,
@@ -81,7 +84,7 @@ module uart_tx #(
                end
                else begin
                   sig_r   <= data_r[data_cnt];
-                  clk_cnt <= PULSE_WIDTH;
+                  clk_cnt <= pulse_width;
 
                   if(data_cnt == DATA_WIDTH - 1) begin
                      state <= STT_STOP;
@@ -103,7 +106,7 @@ module uart_tx #(
                else begin
                   state   <= STT_WAIT;
                   sig_r   <= 1;
-                  clk_cnt <= PULSE_WIDTH + HALF_PULSE_WIDTH;
+                  clk_cnt <= pulse_width + half_pulse_width;
                end
             end
 
@@ -124,7 +127,7 @@ module uart_tx #(
                   data_r   <= data_i;
                   ready_r  <= 0;
                   data_cnt <= 0;
-                  clk_cnt  <= PULSE_WIDTH;
+                  clk_cnt  <= pulse_width;
                end
             end
 
@@ -0,0 +1,536 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// AES unit: executes the vector AES instructions of the Zvkned extension,
+// which operate on element groups of 128 bits (four 32-bit elements) holding
+// an AES state or round key.  Bytes are numbered in memory order, hence byte
+// r of the 32-bit column c of a state is found at bits [32*c+8*r +: 8].  The
+// unit processes AES_OP_W bits (i.e., AES_OP_W/128 element groups) per cycle.
+module vproc_aes #(
+        parameter int unsigned        VREG_W          = 128,  // width in bits of vector registers
+        parameter int unsigned        VMSK_W          = 16,   // width of vector register masks (= VREG_W / 8)
+        parameter int unsigned        CFG_VL_W        = 7,    // width of VL reg in bits (= log2(VREG_W))
+        parameter int unsigned        AES_OP_W        = 128,  // AES unit operand width in bits
+        parameter int unsigned        MAX_WR_ATTEMPTS = 1,    // max required vregfile write attempts
+        parameter bit                 BUF_VREG        = 1'b1, // insert pipeline stage after vreg read
+        parameter bit                 BUF_SUBBYTES    = 1'b1, // insert pipeline stage after the S-boxes
+        parameter bit                 BUF_RESULTS     = 1'b1, // insert pipeline stage after computing result
+        parameter bit                 DONT_CARE_ZERO  = 1'b0  // initialize don't care values to zero
+    )(
+        input  logic                  clk_i,
+        input  logic                  async_rst_ni,
+        input  logic                  sync_rst_ni,
+
+        input  vproc_pkg::cfg_lmul    lmul_i,
+        input  logic [CFG_VL_W-1:0]   vl_i,
+        input  logic                  vl_0_i,
+
+        input  logic                  op_rdy_i,
+        output logic                  op_ack_o,
+
+        input  vproc_pkg::op_mode_aes mode_i,
+        input  logic [4:0]            vs2_i,
+        input  logic [4:0]            vd_i,
+
+        output logic [31:0]           clear_rd_hazards_o,
+        output logic [31:0]           clear_wr_hazards_o,
+
+        // connections to register file:
+        input  logic [VREG_W-1:0]     vreg_rd_i,      // round key (vs2)
+        input  logic [VREG_W-1:0]     vreg_rd3_i,     // state (vd)
+        output logic [4:0]            vreg_rd_addr_o,
+        output logic [4:0]            vreg_rd3_addr_o,
+        output logic [VREG_W-1:0]     vreg_wr_o,
+        output logic [4:0]            vreg_wr_addr_o,
+        output logic [VMSK_W-1:0]     vreg_wr_mask_o,
+        output logic                  vreg_wr_en_o
+    );
+
+    import vproc_pkg::*;
+
+    if ((AES_OP_W & (AES_OP_W - 1)) != 0 || AES_OP_W < 128 || AES_OP_W > VREG_W) begin
+        $fatal(1, "The vector AES operand width AES_OP_W must be at least 128, at most ",
+                  "the vector register width VREG_W and a power of two.  ",
+                  "The current value of %d is invalid.", AES_OP_W);
+    end
+
+    // max number of cycles by which a write can be delayed
+    localparam int unsigned MAX_WR_DELAY = (1 << MAX_WR_ATTEMPTS) - 1;
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    // AES UNIT STATE:
+
+    localparam int unsigned AES_CYCLES_PER_VREG = VREG_W / AES_OP_W;
+    localparam int unsigned AES_COUNTER_W       = $clog2(AES_CYCLES_PER_VREG) + 3;
+
+    // number of element groups processed per cycle
+    localparam int unsigned AES_EG_CNT = AES_OP_W / 128;
+
+    // the counter part within a vreg is empty if AES_OP_W == VREG_W, hence the
+    // counter is not split into a packed struct like in the other units
+    localparam bit [AES_COUNTER_W-1:0] AES_COUNTER_LOW = AES_COUNTER_W'(AES_CYCLES_PER_VREG - 1);
+
+    typedef struct packed {
+        // note: busy flag (also used to indicate whether state is valid) moved out of struct
+        logic [AES_COUNTER_W-1:0] count;
+        logic                     first_cycle;
+        logic                     last_cycle;
+        op_mode_aes               mode;
+        cfg_emul                  emul;       // effective MUL factor
+        logic [CFG_VL_W-1:0]      vl;
+        logic                     vl_0;
+        logic [4:0]               vs2;
+        logic                     vs2_fetch;
+        logic [4:0]               vd;
+        logic                     vd_fetch;
+        logic                     vd_store;
+    } aes_state;
+
+    logic     state_busy_q, state_busy_d;
+    aes_state state_q,      state_d;
+    always_ff @(posedge clk_i or negedge async_rst_ni) begin : vproc_aes_state_busy
+        if (~async_rst_ni) begin
+            state_busy_q <= 1'b0;
+        end
+        else if (~sync_rst_ni) begin
+            state_busy_q <= 1'b0;
+        end else begin
+            state_busy_q <= state_busy_d;
+        end
+    end
+    always_ff @(posedge clk_i) begin : vproc_aes_state
+        state_q <= state_d;
+    end
+
+    // vreg index and end of vreg flag of the current cycle
+    logic [2:0] count_mul;
+    logic       count_low_last;
+    assign count_mul      = 3'(state_q.count >> $clog2(AES_CYCLES_PER_VREG));
+    assign count_low_last = (state_q.count & AES_COUNTER_LOW) == AES_COUNTER_LOW;
+
+    logic last_cycle;
+    always_comb begin
+        last_cycle = DONT_CARE_ZERO ? 1'b0 : 1'bx;
+        unique case (state_q.emul)
+            EMUL_1: last_cycle =                           count_low_last;
+            EMUL_2: last_cycle = (count_mul[  0] == '1) & count_low_last;
+            EMUL_4: last_cycle = (count_mul[1:0] == '1) & count_low_last;
+            EMUL_8: last_cycle = (count_mul[2:0] == '1) & count_low_last;
+            default: ;
+        endcase
+    end
+
+    always_comb begin
+        op_ack_o     = 1'b0;
+        state_busy_d = state_busy_q;
+        state_d      = state_q;
+
+        if (((~state_busy_q) | last_cycle) & op_rdy_i) begin
+            op_ack_o            = 1'b1;
+            state_d.count       = '0;
+            state_busy_d        = 1'b1;
+            state_d.first_cycle = 1'b1;
+            state_d.mode        = mode_i;
+            state_d.emul = DONT_CARE_ZERO ? cfg_emul'('0) : cfg_emul'('x);
+            unique case (lmul_i)
+                LMUL_F8,
+                LMUL_F4,
+                LMUL_F2,
+                LMUL_1: state_d.emul = EMUL_1;
+                LMUL_2: state_d.emul = EMUL_2;
+                LMUL_4: state_d.emul = EMUL_4;
+                LMUL_8: state_d.emul = EMUL_8;
+                default: ;
+            endcase
+            state_d.vl          = vl_i;
+            state_d.vl_0        = vl_0_i;
+            state_d.vs2         = vs2_i;
+            state_d.vs2_fetch   = 1'b1;
+            state_d.vd          = vd_i;
+            state_d.vd_fetch    = mode_i.op != AES_VAESKF1;
+        end
+        else if (state_busy_q) begin
+            state_d.count       = state_q.count + 1;
+            state_busy_d        = ~last_cycle;
+            state_d.first_cycle = 1'b0;
+            state_d.vs2_fetch   = 1'b0;
+            state_d.vd_fetch    = 1'b0;
+            if (count_low_last) begin
+                // the .vs variants use element group 0 of vs2 for all groups
+                if (~state_q.mode.scalar) begin
+                    state_d.vs2[2:0]  = state_q.vs2[2:0] + 3'b1;
+                    state_d.vs2_fetch = 1'b1;
+                end
+                state_d.vd[2:0]  = state_q.vd[2:0] + 3'b1;
+                state_d.vd_fetch = state_q.mode.op != AES_VAESKF1;
+            end
+        end
+    end
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    // AES PIPELINE BUFFERS:
+
+    // pass state information along pipeline:
+    logic     state_init_busy, state_vreg_busy_q, state_op_busy_q, state_ex_busy_q, state_res_busy_q, state_vd_busy_q;
+    aes_state state_init,      state_vreg_q,      state_op_q,      state_ex_q,      state_res_q,      state_vd_q;
+    always_comb begin
+        state_init_busy       = state_busy_q;
+        state_init            = state_q;
+        state_init.last_cycle = state_busy_q & last_cycle;
+        state_init.vd_store   = count_low_last;
+    end
+
+    // vreg read registers:
+    logic [VREG_W-1:0] vreg_rd_q,  vreg_rd_d;
+    logic [VREG_W-1:0] vreg_rd3_q, vreg_rd3_d;
+
+    // operand shift registers (vs2 holds the round keys, vs3 the states):
+    logic [VREG_W-1:0] vs2_shift_q, vs2_shift_d;
+    logic [VREG_W-1:0] vs3_shift_q, vs3_shift_d;
+
+    // intermediate values (states after SubBytes and ShiftRows or their
+    // inverse, and substituted words of the key schedule) and round keys:
+    logic [AES_OP_W  -1:0] subst_q,       subst_d;
+    logic [AES_OP_W  -1:0] round_key_q,   round_key_d;
+
+    // result:
+    logic [AES_OP_W  -1:0] result_q,      result_d;
+    logic [AES_OP_W/8-1:0] result_mask_q, result_mask_d;
+
+    // result shift register:
+    logic [VREG_W-1:0] vd_shift_q,    vd_shift_d;
+    logic [VMSK_W-1:0] vdmsk_shift_q, vdmsk_shift_d;
+
+    // vreg write buffers
+    logic              vreg_wr_en_q  [MAX_WR_DELAY], vreg_wr_en_d;
+    logic [4:0]        vreg_wr_addr_q[MAX_WR_DELAY], vreg_wr_addr_d;
+    logic [VMSK_W-1:0] vreg_wr_mask_q[MAX_WR_DELAY], vreg_wr_mask_d;
+    logic [VREG_W-1:0] vreg_wr_q     [MAX_WR_DELAY], vreg_wr_d;
+
+    // hazard clear registers
+    logic [31:0] clear_rd_hazards_q, clear_rd_hazards_d;
+    logic [31:0] clear_wr_hazards_q, clear_wr_hazards_d;
+
+    generate
+        if (BUF_VREG) begin
+            always_ff @(posedge clk_i) begin : vproc_aes_stage_vreg
+                state_vreg_busy_q <= state_init_busy;
+                state_vreg_q      <= state_init;
+                vreg_rd_q         <= vreg_rd_d;
+                vreg_rd3_q        <= vreg_rd3_d;
+            end
+        end else begin
+            always_comb begin
+                state_vreg_busy_q = state_init_busy;
+                state_vreg_q      = state_init;
+                vreg_rd_q         = vreg_rd_d;
+                vreg_rd3_q        = vreg_rd3_d;
+            end
+        end
+
+        always_ff @(posedge clk_i) begin : vproc_aes_stage_op
+            state_op_busy_q <= state_vreg_busy_q;
+            state_op_q      <= state_vreg_q;
+            vs2_shift_q     <= vs2_shift_d;
+            vs3_shift_q     <= vs3_shift_d;
+        end
+
+        if (BUF_SUBBYTES) begin
+            always_ff @(posedge clk_i) begin : vproc_aes_stage_ex
+                state_ex_busy_q <= state_op_busy_q;
+                state_ex_q      <= state_op_q;
+                subst_q         <= subst_d;
+                round_key_q     <= round_key_d;
+            end
+        end else begin
+            always_comb begin
+                state_ex_busy_q = state_op_busy_q;
+                state_ex_q      = state_op_q;
+                subst_q         = subst_d;
+                round_key_q     = round_key_d;
+            end
+        end
+
+        if (BUF_RESULTS) begin
+            always_ff @(posedge clk_i) begin : vproc_aes_stage_res
+                state_res_busy_q <= state_ex_busy_q;
+                state_res_q      <= state_ex_q;
+                result_q         <= result_d;
+                result_mask_q    <= result_mask_d;
+            end
+        end else begin
+            always_comb begin
+                state_res_busy_q = state_ex_busy_q;
+                state_res_q      = state_ex_q;
+                result_q         = result_d;
+                result_mask_q    = result_mask_d;
+            end
+        end
+
+        always_ff @(posedge clk_i) begin : vproc_aes_stage_vd
+            state_vd_busy_q <= state_res_busy_q;
+            state_vd_q      <= state_res_q;
+            vd_shift_q      <= vd_shift_d;
+            vdmsk_shift_q   <= vdmsk_shift_d;
+        end
+
+        if (MAX_WR_DELAY > 0) begin
+            always_ff @(posedge clk_i) begin : vproc_aes_wr_delay
+                vreg_wr_en_q  [0] <= vreg_wr_en_d;
+                vreg_wr_addr_q[0] <= vreg_wr_addr_d;
+                vreg_wr_mask_q[0] <= vreg_wr_mask_d;
+                vreg_wr_q     [0] <= vreg_wr_d;
+                for (int i = 1; i < MAX_WR_DELAY; i++) begin
+                    vreg_wr_en_q  [i] <= vreg_wr_en_q  [i-1];
+                    vreg_wr_addr_q[i] <= vreg_wr_addr_q[i-1];
+                    vreg_wr_mask_q[i] <= vreg_wr_mask_q[i-1];
+                    vreg_wr_q     [i] <= vreg_wr_q     [i-1];
+                end
+            end
+        end
+
+        always_ff @(posedge clk_i) begin
+            clear_rd_hazards_q <= clear_rd_hazards_d;
+            clear_wr_hazards_q <= clear_wr_hazards_d;
+        end
+    endgenerate
+
+    always_comb begin
+        vreg_wr_en_o   = vreg_wr_en_d;
+        vreg_wr_addr_o = vreg_wr_addr_d;
+        vreg_wr_mask_o = vreg_wr_mask_d;
+        vreg_wr_o      = vreg_wr_d;
+        for (int i = 0; i < MAX_WR_DELAY; i++) begin
+            if ((((i + 1) & (i + 2)) == 0) & vreg_wr_en_q[i]) begin
+                vreg_wr_en_o   = 1'b1;
+                vreg_wr_addr_o = vreg_wr_addr_q[i];
+                vreg_wr_mask_o = vreg_wr_mask_q[i];
+                vreg_wr_o      = vreg_wr_q     [i];
+            end
+        end
+    end
+
+    // write hazard clearing
+    always_comb begin
+        clear_wr_hazards_d     = vreg_wr_en_d                 ? (32'b1 << vreg_wr_addr_d                ) : 32'b0;
+        if (MAX_WR_DELAY > 0) begin
+            clear_wr_hazards_d = vreg_wr_en_q[MAX_WR_DELAY-1] ? (32'b1 << vreg_wr_addr_q[MAX_WR_DELAY-1]) : 32'b0;
+        end
+    end
+    assign clear_wr_hazards_o = clear_wr_hazards_q;
+
+    // read hazard clearing (vs2 and vd are read simultaneously)
+    assign clear_rd_hazards_d = state_init_busy ? (
+        (state_init.vs2_fetch ? (32'b1 << state_init.vs2) : 32'b0) |
+        (state_init.vd_fetch  ? (32'b1 << state_init.vd ) : 32'b0)
+    ) : 32'b0;
+    assign clear_rd_hazards_o = clear_rd_hazards_q;
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    // AES REGISTER READ/WRITE:
+
+    // source register addressing and read:
+    assign vreg_rd_addr_o  = state_init.vs2;
+    assign vreg_rd3_addr_o = state_init.vd;
+    assign vreg_rd_d       = vreg_rd_i;
+    assign vreg_rd3_d      = vreg_rd3_i;
+
+    // operand shift registers assignment; the .vs variants replicate element
+    // group 0 of vs2 across the whole shift register and never shift it
+    always_comb begin
+        vs2_shift_d = vs2_shift_q;
+        if (state_vreg_q.vs2_fetch) begin
+            vs2_shift_d = state_vreg_q.mode.scalar ? {(VREG_W/128){vreg_rd_q[127:0]}} : vreg_rd_q;
+        end
+        else if (~state_vreg_q.mode.scalar) begin
+            vs2_shift_d = vs2_shift_q >> AES_OP_W;
+        end
+        vs3_shift_d = state_vreg_q.vd_fetch ? vreg_rd3_q : (vs3_shift_q >> AES_OP_W);
+    end
+
+    // result byte mask (element groups beyond VL are not written)
+    logic [VREG_W-1:0] vl_mask;
+    assign vl_mask       = state_ex_q.vl_0 ? {VREG_W{1'b0}} : ({VREG_W{1'b1}} >> (~state_ex_q.vl));
+    assign result_mask_d = vl_mask[state_ex_q.count*AES_OP_W/8 +: AES_OP_W/8];
+
+    // result shift register assignment:
+    assign vd_shift_d    = (vd_shift_q    >> AES_OP_W  ) | (VREG_W'(result_q)      << (VREG_W - AES_OP_W  ));
+    assign vdmsk_shift_d = (vdmsk_shift_q >> AES_OP_W/8) | (VMSK_W'(result_mask_q) << (VMSK_W - AES_OP_W/8));
+
+    assign vreg_wr_en_d   = state_vd_busy_q & state_vd_q.vd_store;
+    assign vreg_wr_addr_d = state_vd_q.vd;
+    assign vreg_wr_mask_d = vreg_wr_en_o ? vdmsk_shift_q : '0;
+    assign vreg_wr_d      = vd_shift_q;
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    // AES ROUND OPERATIONS:
+
+    // S-box (SubBytes) and its inverse (InvSubBytes)
+    localparam logic [7:0] AES_SBOX [256] = '{
+        8'h63, 8'h7C, 8'h77, 8'h7B, 8'hF2, 8'h6B, 8'h6F, 8'hC5, 8'h30, 8'h01, 8'h67, 8'h2B, 8'hFE, 8'hD7, 8'hAB, 8'h76,
+        8'hCA, 8'h82, 8'hC9, 8'h7D, 8'hFA, 8'h59, 8'h47, 8'hF0, 8'hAD, 8'hD4, 8'hA2, 8'hAF, 8'h9C, 8'hA4, 8'h72, 8'hC0,
+        8'hB7, 8'hFD, 8'h93, 8'h26, 8'h36, 8'h3F, 8'hF7, 8'hCC, 8'h34, 8'hA5, 8'hE5, 8'hF1, 8'h71, 8'hD8, 8'h31, 8'h15,
+        8'h04, 8'hC7, 8'h23, 8'hC3, 8'h18, 8'h96, 8'h05, 8'h9A, 8'h07, 8'h12, 8'h80, 8'hE2, 8'hEB, 8'h27, 8'hB2, 8'h75,
+        8'h09, 8'h83, 8'h2C, 8'h1A, 8'h1B, 8'h6E, 8'h5A, 8'hA0, 8'h52, 8'h3B, 8'hD6, 8'hB3, 8'h29, 8'hE3, 8'h2F, 8'h84,
+        8'h53, 8'hD1, 8'h00, 8'hED, 8'h20, 8'hFC, 8'hB1, 8'h5B, 8'h6A, 8'hCB, 8'hBE, 8'h39, 8'h4A, 8'h4C, 8'h58, 8'hCF,
+        8'hD0, 8'hEF, 8'hAA, 8'hFB, 8'h43, 8'h4D, 8'h33, 8'h85, 8'h45, 8'hF9, 8'h02, 8'h7F, 8'h50, 8'h3C, 8'h9F, 8'hA8,
+        8'h51, 8'hA3, 8'h40, 8'h8F, 8'h92, 8'h9D, 8'h38, 8'hF5, 8'hBC, 8'hB6, 8'hDA, 8'h21, 8'h10, 8'hFF, 8'hF3, 8'hD2,
+        8'hCD, 8'h0C, 8'h13, 8'hEC, 8'h5F, 8'h97, 8'h44, 8'h17, 8'hC4, 8'hA7, 8'h7E, 8'h3D, 8'h64, 8'h5D, 8'h19, 8'h73,
+        8'h60, 8'h81, 8'h4F, 8'hDC, 8'h22, 8'h2A, 8'h90, 8'h88, 8'h46, 8'hEE, 8'hB8, 8'h14, 8'hDE, 8'h5E, 8'h0B, 8'hDB,
+        8'hE0, 8'h32, 8'h3A, 8'h0A, 8'h49, 8'h06, 8'h24, 8'h5C, 8'hC2, 8'hD3, 8'hAC, 8'h62, 8'h91, 8'h95, 8'hE4, 8'h79,
+        8'hE7, 8'hC8, 8'h37, 8'h6D, 8'h8D, 8'hD5, 8'h4E, 8'hA9, 8'h6C, 8'h56, 8'hF4, 8'hEA, 8'h65, 8'h7A, 8'hAE, 8'h08,
+        8'hBA, 8'h78, 8'h25, 8'h2E, 8'h1C, 8'hA6, 8'hB4, 8'hC6, 8'hE8, 8'hDD, 8'h74, 8'h1F, 8'h4B, 8'hBD, 8'h8B, 8'h8A,
+        8'h70, 8'h3E, 8'hB5, 8'h66, 8'h48, 8'h03, 8'hF6, 8'h0E, 8'h61, 8'h35, 8'h57, 8'hB9, 8'h86, 8'hC1, 8'h1D, 8'h9E,
+        8'hE1, 8'hF8, 8'h98, 8'h11, 8'h69, 8'hD9, 8'h8E, 8'h94, 8'h9B, 8'h1E, 8'h87, 8'hE9, 8'hCE, 8'h55, 8'h28, 8'hDF,
+        8'h8C, 8'hA1, 8'h89, 8'h0D, 8'hBF, 8'hE6, 8'h42, 8'h68, 8'h41, 8'h99, 8'h2D, 8'h0F, 8'hB0, 8'h54, 8'hBB, 8'h16
+    };
+    localparam logic [7:0] AES_INV_SBOX [256] = '{
+        8'h52, 8'h09, 8'h6A, 8'hD5, 8'h30, 8'h36, 8'hA5, 8'h38, 8'hBF, 8'h40, 8'hA3, 8'h9E, 8'h81, 8'hF3, 8'hD7, 8'hFB,
+        8'h7C, 8'hE3, 8'h39, 8'h82, 8'h9B, 8'h2F, 8'hFF, 8'h87, 8'h34, 8'h8E, 8'h43, 8'h44, 8'hC4, 8'hDE, 8'hE9, 8'hCB,
+        8'h54, 8'h7B, 8'h94, 8'h32, 8'hA6, 8'hC2, 8'h23, 8'h3D, 8'hEE, 8'h4C, 8'h95, 8'h0B, 8'h42, 8'hFA, 8'hC3, 8'h4E,
+        8'h08, 8'h2E, 8'hA1, 8'h66, 8'h28, 8'hD9, 8'h24, 8'hB2, 8'h76, 8'h5B, 8'hA2, 8'h49, 8'h6D, 8'h8B, 8'hD1, 8'h25,
+        8'h72, 8'hF8, 8'hF6, 8'h64, 8'h86, 8'h68, 8'h98, 8'h16, 8'hD4, 8'hA4, 8'h5C, 8'hCC, 8'h5D, 8'h65, 8'hB6, 8'h92,
+        8'h6C, 8'h70, 8'h48, 8'h50, 8'hFD, 8'hED, 8'hB9, 8'hDA, 8'h5E, 8'h15, 8'h46, 8'h57, 8'hA7, 8'h8D, 8'h9D, 8'h84,
+        8'h90, 8'hD8, 8'hAB, 8'h00, 8'h8C, 8'hBC, 8'hD3, 8'h0A, 8'hF7, 8'hE4, 8'h58, 8'h05, 8'hB8, 8'hB3, 8'h45, 8'h06,
+        8'hD0, 8'h2C, 8'h1E, 8'h8F, 8'hCA, 8'h3F, 8'h0F, 8'h02, 8'hC1, 8'hAF, 8'hBD, 8'h03, 8'h01, 8'h13, 8'h8A, 8'h6B,
+        8'h3A, 8'h91, 8'h11, 8'h41, 8'h4F, 8'h67, 8'hDC, 8'hEA, 8'h97, 8'hF2, 8'hCF, 8'hCE, 8'hF0, 8'hB4, 8'hE6, 8'h73,
+        8'h96, 8'hAC, 8'h74, 8'h22, 8'hE7, 8'hAD, 8'h35, 8'h85, 8'hE2, 8'hF9, 8'h37, 8'hE8, 8'h1C, 8'h75, 8'hDF, 8'h6E,
+        8'h47, 8'hF1, 8'h1A, 8'h71, 8'h1D, 8'h29, 8'hC5, 8'h89, 8'h6F, 8'hB7, 8'h62, 8'h0E, 8'hAA, 8'h18, 8'hBE, 8'h1B,
+        8'hFC, 8'h56, 8'h3E, 8'h4B, 8'hC6, 8'hD2, 8'h79, 8'h20, 8'h9A, 8'hDB, 8'hC0, 8'hFE, 8'h78, 8'hCD, 8'h5A, 8'hF4,
+        8'h1F, 8'hDD, 8'hA8, 8'h33, 8'h88, 8'h07, 8'hC7, 8'h31, 8'hB1, 8'h12, 8'h10, 8'h59, 8'h27, 8'h80, 8'hEC, 8'h5F,
+        8'h60, 8'h51, 8'h7F, 8'hA9, 8'h19, 8'hB5, 8'h4A, 8'h0D, 8'h2D, 8'hE5, 8'h7A, 8'h9F, 8'h93, 8'hC9, 8'h9C, 8'hEF,
+        8'hA0, 8'hE0, 8'h3B, 8'h4D, 8'hAE, 8'h2A, 8'hF5, 8'hB0, 8'hC8, 8'hEB, 8'hBB, 8'h3C, 8'h83, 8'h53, 8'h99, 8'h61,
+        8'h17, 8'h2B, 8'h04, 8'h7E, 8'hBA, 8'h77, 8'hD6, 8'h26, 8'hE1, 8'h69, 8'h14, 8'h63, 8'h55, 8'h21, 8'h0C, 8'h7D
+    };
+
+    // multiplication by x (i.e., {02}) in GF(2^8)
+    function automatic logic [7:0] aes_xtime(logic [7:0] b);
+        return {b[6:0], 1'b0} ^ (b[7] ? 8'h1B : 8'h00);
+    endfunction
+
+    // MixColumns transformation of a single column
+    function automatic logic [31:0] aes_mix_column(logic [31:0] col);
+        logic [31:0] res;
+        for (int r = 0; r < 4; r++) begin
+            res[8*r +: 8] = aes_xtime(col[8*r +: 8] ^ col[8*((r+1)%4) +: 8]) ^
+                            col[8*((r+1)%4) +: 8] ^ col[8*((r+2)%4) +: 8] ^ col[8*((r+3)%4) +: 8];
+        end
+        return res;
+    endfunction
+
+    // InvMixColumns is MixColumns preceded by a multiplication with the
+    // circulant matrix {05, 00, 04, 00}, which allows sharing the logic
+    function automatic logic [31:0] aes_inv_mix_pre(logic [31:0] col);
+        logic [7:0] u, v;
+        u = aes_xtime(aes_xtime(col[ 7: 0] ^ col[23:16]));
+        v = aes_xtime(aes_xtime(col[15: 8] ^ col[31:24]));
+        return col ^ {v, u, v, u};
+    endfunction
+
+    // round constant of the round rnd of the AES-128 key schedule; round
+    // numbers outside of the range 1 to 10 are mapped into it by inverting
+    // bit 3, as specified for vaeskf1
+    function automatic logic [7:0] aes_rcon(logic [3:0] rnd);
+        logic [3:0] idx;
+        logic [7:0] rcon;
+        idx = (rnd > 4'd10 || rnd == 4'd0) ? (rnd ^ 4'b1000) : rnd;
+        rcon = DONT_CARE_ZERO ? '0 : 'x;
+        unique case (idx)
+            4'd1:  rcon = 8'h01;
+            4'd2:  rcon = 8'h02;
+            4'd3:  rcon = 8'h04;
+            4'd4:  rcon = 8'h08;
+            4'd5:  rcon = 8'h10;
+            4'd6:  rcon = 8'h20;
+            4'd7:  rcon = 8'h40;
+            4'd8:  rcon = 8'h80;
+            4'd9:  rcon = 8'h1B;
+            4'd10: rcon = 8'h36;
+            default: ;
+        endcase
+        return rcon;
+    endfunction
+
+    // first step: SubBytes and ShiftRows (or InvShiftRows and InvSubBytes for
+    // decryption) of the states, which are equivalent when the rows are
+    // shifted before substituting the bytes; the key schedule substitutes the
+    // rotated last word of the previous round key
+    always_comb begin
+        subst_d     = DONT_CARE_ZERO ? '0 : 'x;
+        round_key_d = vs2_shift_q[AES_OP_W-1:0];
+        for (int g = 0; g < AES_EG_CNT; g++) begin
+            logic [127:0] st;
+            logic [31:0]  rot;
+            st  = vs3_shift_q[g*128 +: 128];
+            rot = {vs2_shift_q[g*128+96 +: 8], vs2_shift_q[g*128+104 +: 24]};
+            unique case (state_op_q.mode.op)
+                AES_VAESEF, AES_VAESEM: begin
+                    for (int c = 0; c < 4; c++) begin
+                        for (int r = 0; r < 4; r++) begin
+                            subst_d[g*128+32*c+8*r +: 8] = AES_SBOX[st[32*((c+r)%4)+8*r +: 8]];
+                        end
+                    end
+                end
+                AES_VAESDF, AES_VAESDM: begin
+                    for (int c = 0; c < 4; c++) begin
+                        for (int r = 0; r < 4; r++) begin
+                            subst_d[g*128+32*c+8*r +: 8] = AES_INV_SBOX[st[32*((c+4-r)%4)+8*r +: 8]];
+                        end
+                    end
+                end
+                AES_VAESZ: begin
+                    subst_d[g*128 +: 128] = st;
+                end
+                AES_VAESKF1: begin
+                    for (int r = 0; r < 4; r++) begin
+                        subst_d[g*128+8*r +: 8] = AES_SBOX[rot[8*r +: 8]];
+                    end
+                end
+                default: ;
+            endcase
+        end
+    end
+
+    // second step: round key addition and (Inv)MixColumns, or the remaining
+    // steps of the key schedule
+    always_comb begin
+        result_d = DONT_CARE_ZERO ? '0 : 'x;
+        for (int g = 0; g < AES_EG_CNT; g++) begin
+            logic [127:0] st, rk, tmp;
+            logic [31:0]  w;
+            st  = subst_q    [g*128 +: 128];
+            rk  = round_key_q[g*128 +: 128];
+            tmp = st ^ rk;
+            unique case (state_ex_q.mode.op)
+                AES_VAESEF, AES_VAESDF, AES_VAESZ: begin
+                    result_d[g*128 +: 128] = tmp;
+                end
+                AES_VAESEM: begin
+                    for (int c = 0; c < 4; c++) begin
+                        result_d[g*128+32*c +: 32] = aes_mix_column(st[32*c +: 32]) ^ rk[32*c +: 32];
+                    end
+                end
+                AES_VAESDM: begin
+                    for (int c = 0; c < 4; c++) begin
+                        result_d[g*128+32*c +: 32] = aes_mix_column(aes_inv_mix_pre(tmp[32*c +: 32]));
+                    end
+                end
+                AES_VAESKF1: begin
+                    w = st[31:0] ^ {24'b0, aes_rcon(state_ex_q.mode.rnd)};
+                    for (int c = 0; c < 4; c++) begin
+                        w                          = w ^ rk[32*c +: 32];
+                        result_d[g*128+32*c +: 32] = w;
+                    end
+                end
+                default: ;
+            endcase
+        end
+    end
+
+endmodule
@@ -785,6 +785,31 @@ module vproc_alu #(
                 for (int i = 0; i < ALU_OP_W / 32; i++)
                     shift_res_d[32*i +: 32] = $signed(operand2_32[32*i +: 32]) >>> operand1_32[32*i +: 5];
             end
+
+            // vror.* and vrol.*: rotating left is rotating right by the
+            // negated amount, hence for vrol.* operand 1 is inverted and the
+            // missing increment of the two's complement is added here
+            {ALU_SHIFT_VROR, VSEW_8}: begin
+                for (int i = 0; i < ALU_OP_W / 8 ; i++) begin
+                    logic [2:0] amount;
+                    amount                  = operand1_32[8 *i +: 3] + {2'b0, state_ex1_q.mode.inv_op1};
+                    shift_res_d[8 *i +: 8 ] = 8'({2{operand2_32[8 *i +: 8 ]}} >> amount);
+                end
+            end
+            {ALU_SHIFT_VROR, VSEW_16}: begin
+                for (int i = 0; i < ALU_OP_W / 16; i++) begin
+                    logic [3:0] amount;
+                    amount                  = operand1_32[16*i +: 4] + {3'b0, state_ex1_q.mode.inv_op1};
+                    shift_res_d[16*i +: 16] = 16'({2{operand2_32[16*i +: 16]}} >> amount);
+                end
+            end
+            {ALU_SHIFT_VROR, VSEW_32}: begin
+                for (int i = 0; i < ALU_OP_W / 32; i++) begin
+                    logic [4:0] amount;
+                    amount                  = operand1_32[32*i +: 5] + {4'b0, state_ex1_q.mode.inv_op1};
+                    shift_res_d[32*i +: 32] = 32'({2{operand2_32[32*i +: 32]}} >> amount);
+                end
+            end
             default: ;
         endcase
     end
@@ -830,6 +855,126 @@ module vproc_alu #(
                     result_alu_d[8*i +: 8] = cmp_q[i] ? operand2_tmp_q[8*i +: 8] : ~operand1_tmp_q[8*i +: 8];
                 end
             end
+
+            // unary bit manipulation operations on operand 2
+            ALU_VBREV8: begin
+                for (int i = 0; i < ALU_OP_W / 8; i++) begin
+                    for (int j = 0; j < 8; j++) begin
+                        result_alu_d[8*i + j] = operand2_tmp_q[8*i + 7 - j];
+                    end
+                end
+            end
+            ALU_VREV8: begin
+                unique case (state_ex2_q.eew)
+                    VSEW_8:  result_alu_d = operand2_tmp_q;
+                    VSEW_16: begin
+                        for (int i = 0; i < ALU_OP_W / 16; i++) begin
+                            result_alu_d[16*i +: 16] = {operand2_tmp_q[16*i    +: 8], operand2_tmp_q[16*i+8  +: 8]};
+                        end
+                    end
+                    VSEW_32: begin
+                        for (int i = 0; i < ALU_OP_W / 32; i++) begin
+                            result_alu_d[32*i +: 32] = {operand2_tmp_q[32*i    +: 8], operand2_tmp_q[32*i+8  +: 8],
+                                                        operand2_tmp_q[32*i+16 +: 8], operand2_tmp_q[32*i+24 +: 8]};
+                        end
+                    end
+                    default: ;
+                endcase
+            end
+
+            // leading zeroes: the most significant set bit is the last one
+            // encountered when scanning upwards
+            ALU_VCLZ: begin
+                unique case (state_ex2_q.eew)
+                    VSEW_8: begin
+                        for (int i = 0; i < ALU_OP_W / 8 ; i++) begin
+                            result_alu_d[8 *i +: 8 ] = 8'd8;
+                            for (int j = 0; j < 8 ; j++) begin
+                                if (operand2_tmp_q[8 *i + j]) result_alu_d[8 *i +: 8 ] = 8'(7  - j);
+                            end
+                        end
+                    end
+                    VSEW_16: begin
+                        for (int i = 0; i < ALU_OP_W / 16; i++) begin
+                            result_alu_d[16*i +: 16] = 16'd16;
+                            for (int j = 0; j < 16; j++) begin
+                                if (operand2_tmp_q[16*i + j]) result_alu_d[16*i +: 16] = 16'(15 - j);
+                            end
+                        end
+                    end
+                    VSEW_32: begin
+                        for (int i = 0; i < ALU_OP_W / 32; i++) begin
+                            result_alu_d[32*i +: 32] = 32'd32;
+                            for (int j = 0; j < 32; j++) begin
+                                if (operand2_tmp_q[32*i + j]) result_alu_d[32*i +: 32] = 32'(31 - j);
+                            end
+                        end
+                    end
+                    default: ;
+                endcase
+            end
+
+            // trailing zeroes: the least significant set bit is the last one
+            // encountered when scanning downwards
+            ALU_VCTZ: begin
+                unique case (state_ex2_q.eew)
+                    VSEW_8: begin
+                        for (int i = 0; i < ALU_OP_W / 8 ; i++) begin
+                            result_alu_d[8 *i +: 8 ] = 8'd8;
+                            for (int j = 7 ; j >= 0; j--) begin
+                                if (operand2_tmp_q[8 *i + j]) result_alu_d[8 *i +: 8 ] = 8'(j);
+                            end
+                        end
+                    end
+                    VSEW_16: begin
+                        for (int i = 0; i < ALU_OP_W / 16; i++) begin
+                            result_alu_d[16*i +: 16] = 16'd16;
+                            for (int j = 15; j >= 0; j--) begin
+                                if (operand2_tmp_q[16*i + j]) result_alu_d[16*i +: 16] = 16'(j);
+                            end
+                        end
+                    end
+                    VSEW_32: begin
+                        for (int i = 0; i < ALU_OP_W / 32; i++) begin
+                            result_alu_d[32*i +: 32] = 32'd32;
+                            for (int j = 31; j >= 0; j--) begin
+                                if (operand2_tmp_q[32*i + j]) result_alu_d[32*i +: 32] = 32'(j);
+                            end
+                        end
+                    end
+                    default: ;
+                endcase
+            end
+
+            ALU_VCPOP: begin
+                unique case (state_ex2_q.eew)
+                    VSEW_8: begin
+                        for (int i = 0; i < ALU_OP_W / 8 ; i++) begin
+                            result_alu_d[8 *i +: 8 ] = '0;
+                            for (int j = 0; j < 8 ; j++) begin
+                                result_alu_d[8 *i +: 8 ] += {7'b0 , operand2_tmp_q[8 *i + j]};
+                            end
+                        end
+                    end
+                    VSEW_16: begin
+                        for (int i = 0; i < ALU_OP_W / 16; i++) begin
+                            result_alu_d[16*i +: 16] = '0;
+                            for (int j = 0; j < 16; j++) begin
+                                result_alu_d[16*i +: 16] += {15'b0, operand2_tmp_q[16*i + j]};
+                            end
+                        end
+                    end
+                    VSEW_32: begin
+                        for (int i = 0; i < ALU_OP_W / 32; i++) begin
+                            result_alu_d[32*i +: 32] = '0;
+                            for (int j = 0; j < 32; j++) begin
+                                result_alu_d[32*i +: 32] += {31'b0, operand2_tmp_q[32*i + j]};
+                            end
+                        end
+                    end
+                    default: ;
+                endcase
+            end
             default: ;
         endcase
     end
@@ -4,11 +4,12 @@
 
 
 module vproc_cache #(
-        parameter int unsigned ADDR_BIT_W  = 16, // Address width (bits)
-        parameter int unsigned CPU_BYTE_W  = 4,  // CPU data width (bytes)
-        parameter int unsigned MEM_BYTE_W  = 4,  // Memory data width (bytes)
-        parameter int unsigned LINE_BYTE_W = 16, // Cache line width (bytes)
-        parameter int unsigned WAY_LEN     = 256 // Cache way length (lines)
+        parameter int unsigned ADDR_BIT_W    = 16,         // Address width (bits)
+        parameter int unsigned CPU_BYTE_W    = 4,          // CPU data width (bytes)
+        parameter int unsigned MEM_BYTE_W    = 4,          // Memory data width (bytes)
+        parameter int unsigned LINE_BYTE_W   = 16,         // Cache line width (bytes)
+        parameter int unsigned WAY_LEN       = 256,        // Cache way length (lines)
+        parameter int unsigned SECTOR_BYTE_W = LINE_BYTE_W // Sector width (bytes)
     )
     (
         input  logic                    clk_i,
@@ -35,11 +36,42 @@ module vproc_cache #(
         input  logic                    mem_gnt_i,
         input  logic                    mem_rvalid_i,
         input  logic [MEM_BYTE_W*8-1:0] mem_rdata_i,
-        input  logic                    mem_err_i
+        input  logic                    mem_err_i,
+
+        // Cache maintenance interface
+        input  logic                    ctrl_req_i,   // start a maintenance operation
+        input  logic                    ctrl_clean_i, // write back dirty lines
+        input  logic                    ctrl_inval_i, // invalidate lines
+        input  logic                    ctrl_all_i,   // whole cache (ignores address range)
+        input  logic [ADDR_BIT_W-1:0]   ctrl_start_i, // start address of range
+        input  logic [ADDR_BIT_W-1:0]   ctrl_end_i,   // end address of range (exclusive)
+        output logic                    ctrl_gnt_o,
+        output logic                    ctrl_busy_o,  // maintenance operation in progress
+
+        // Way locking (locked ways are not replaced upon a miss; locking both
+        // ways has the same effect as locking none)
+        input  logic [1:0]              lock_i,
+
+        // Miss indicator (asserted for one cycle per miss)
+        output logic                    miss_o
     );
 
-    // number of memory requests required to fill or spill a cache line:
+    // Lines are divided into sectors, which are filled individually (i.e.,
+    // a miss only fetches the sector holding the requested data, whereas the
+    // tag and LRU state are shared by all sectors of a line).  A CPU request
+    // must not span several sectors.
+    if (SECTOR_BYTE_W < CPU_BYTE_W || SECTOR_BYTE_W < MEM_BYTE_W || SECTOR_BYTE_W > LINE_BYTE_W ||
+        (SECTOR_BYTE_W & (SECTOR_BYTE_W - 1)) != 0) begin
+        $fatal(1, "The sector width SECTOR_BYTE_W must be a power of two that is at least as large as ",
+                  "the CPU and memory data widths and at most as large as the line width.  ",
+                  "The current value of %d is invalid.", SECTOR_BYTE_W);
+    end
+
+    // number of memory requests required to fill or spill a cache line and
+    // number of sectors per line as well as memory requests per sector:
     localparam int unsigned LINE_FILL_REQ_CNT = LINE_BYTE_W / MEM_BYTE_W;
+    localparam int unsigned SECTOR_CNT        = LINE_BYTE_W / SECTOR_BYTE_W;
+    localparam int unsigned SECTOR_REQ_CNT    = SECTOR_BYTE_W / MEM_BYTE_W;
 
     typedef union packed {
         logic [$clog2(LINE_FILL_REQ_CNT):0] val; // intentionally one bit more
@@ -120,14 +152,26 @@ module vproc_cache #(
     // cache state:
     logic                    check_tag_q,    check_tag_d;
     logic [WAY_LEN-1:0]      lru_q,          lru_d;          // LRU bits
-    logic [WAY_LEN-1:0]      way0_valid_q,   way0_valid_d;   // way 0 valid bits
-    logic [WAY_LEN-1:0]      way1_valid_q,   way1_valid_d;   // way 1 valid bits
+    logic [WAY_LEN-1:0][SECTOR_CNT-1:0] way0_valid_q, way0_valid_d; // way 0 sector valid bits
+    logic [WAY_LEN-1:0][SECTOR_CNT-1:0] way1_valid_q, way1_valid_d; // way 1 sector valid bits
     cpu_addr_t               cpu_addr_q,     cpu_addr_d;     // CPU address buffer
     logic                    cpu_we_q,       cpu_we_d;       // CPU write request
     logic [CPU_BYTE_W-1:0]   cpu_wbe_q,      cpu_wbe_d;      // CPU write byte enable
     logic [CPU_BYTE_W*8-1:0] cpu_wdata_q,    cpu_wdata_d;    // CPU write data
     mem_counter_t            mem_req_cnt_q,  mem_req_cnt_d;  // memory request counter
     mem_counter_t            mem_data_cnt_q, mem_data_cnt_d; // memory data counter
+    logic                    repl_way1_q,    repl_way1_d;    // way filled by current miss
+    logic                    fill_dirty_q,   fill_dirty_d;   // dirty bit of the filled line
+    logic [SECTOR_CNT-1:0]   spill_valid_q,  spill_valid_d;  // valid sectors of spilled line
+
+    // cache maintenance state (the current line address is held in cpu_addr_q):
+    logic                    maint_q,        maint_d;        // maintenance in progress
+    logic                    maint_check_q,  maint_check_d;  // check current line
+    logic                    maint_clean_q,  maint_clean_d;  // write back dirty lines
+    logic                    maint_inval_q,  maint_inval_d;  // invalidate lines
+    logic                    maint_all_q,    maint_all_d;    // iterate over all lines
+    logic                    maint_way1_q,   maint_way1_d;   // way of the line being spilled
+    logic [ADDR_BIT_W-1:0]   maint_end_q,    maint_end_d;    // end of address range
 
     always_ff @(posedge clk_i or negedge rst_ni) begin
         if (!rst_ni) begin
@@ -143,6 +187,16 @@ module vproc_cache #(
             mem_req_cnt_q.part.cnt   <= '0;
             mem_data_cnt_q.part.done <= 1'b1;
             mem_data_cnt_q.part.cnt  <= '0;
+            repl_way1_q              <= 1'b0;
+            fill_dirty_q             <= 1'b0;
+            spill_valid_q            <= '0;
+            maint_q                  <= 1'b0;
+            maint_check_q            <= 1'b0;
+            maint_clean_q            <= 1'b0;
+            maint_inval_q            <= 1'b0;
+            maint_all_q              <= 1'b0;
+            maint_way1_q             <= 1'b0;
+            maint_end_q              <= '0;
         end else begin
             check_tag_q    <= check_tag_d;
             lru_q          <= lru_d;
@@ -154,23 +208,105 @@ module vproc_cache #(
             cpu_wdata_q    <= cpu_wdata_d;
             mem_req_cnt_q  <= mem_req_cnt_d;
             mem_data_cnt_q <= mem_data_cnt_d;
+            repl_way1_q    <= repl_way1_d;
+            fill_dirty_q   <= fill_dirty_d;
+            spill_valid_q  <= spill_valid_d;
+            maint_q        <= maint_d;
+            maint_check_q  <= maint_check_d;
+            maint_clean_q  <= maint_clean_d;
+            maint_inval_q  <= maint_inval_d;
+            maint_all_q    <= maint_all_d;
+            maint_way1_q   <= maint_way1_d;
+            maint_end_q    <= maint_end_d;
         end
     end
 
-    logic                     tag_match_way0, tag_match_way1;
+    // sector of the current CPU request
+    logic [$clog2(SECTOR_CNT+1)-1:0] cpu_sector;
+    assign cpu_sector = cpu_addr_q.part.offset / SECTOR_BYTE_W;
+
+    // a line matches if its tag matches and any of its sectors is valid; a
+    // request only hits if the sector that it accesses is valid as well
+    logic                     tag_match_way0, tag_match_way1, sector_hit_way0, sector_hit_way1;
     logic [LINE_BYTE_W*8-1:0] tag_match_line;
-    assign tag_match_way0 = way0_valid_q[cpu_addr_q.part.index] & (way0_rtag == cpu_addr_q.part.tag);
-    assign tag_match_way1 = way1_valid_q[cpu_addr_q.part.index] & (way1_rtag == cpu_addr_q.part.tag);
-    assign tag_match_line = tag_match_way0 ? way0_rline : way1_rline;
+    assign tag_match_way0  = (|way0_valid_q[cpu_addr_q.part.index]) & (way0_rtag == cpu_addr_q.part.tag);
+    assign tag_match_way1  = (|way1_valid_q[cpu_addr_q.part.index]) & (way1_rtag == cpu_addr_q.part.tag);
+    assign sector_hit_way0 = tag_match_way0 & way0_valid_q[cpu_addr_q.part.index][cpu_sector];
+    assign sector_hit_way1 = tag_match_way1 & way1_valid_q[cpu_addr_q.part.index][cpu_sector];
+    assign tag_match_line  = tag_match_way0 ? way0_rline : way1_rline;
+
+    // lines affected by a maintenance operation (for range operations only
+    // lines with a matching tag, otherwise all valid lines) and lines that
+    // need to be written back
+    logic maint_line0, maint_line1, maint_spill0, maint_spill1, maint_spill;
+    assign maint_line0  = maint_all_q ? (|way0_valid_q[cpu_addr_q.part.index]) : tag_match_way0;
+    assign maint_line1  = maint_all_q ? (|way1_valid_q[cpu_addr_q.part.index]) : tag_match_way1;
+    assign maint_spill0 = maint_check_q & maint_clean_q & maint_line0 & way0_rdirty;
+    assign maint_spill1 = maint_check_q & maint_clean_q & maint_line1 & way1_rdirty;
+    assign maint_spill  = maint_spill0 | maint_spill1;
+
+    // way replaced upon a miss (the LRU way unless one of the ways is locked)
+    logic repl_way1;
+    always_comb begin
+        repl_way1 = lru_q[cpu_addr_q.part.index];
+        unique case (lock_i)
+            2'b01: repl_way1 = 1'b1;
+            2'b10: repl_way1 = 1'b0;
+            default: ;
+        endcase
+    end
 
-    logic                     cache_hit, cache_miss, cache_spill;
+    // way of the line that is replaced or written back
+    logic spill_way1;
+    always_comb begin
+        spill_way1 = check_tag_q ? repl_way1 : repl_way1_q;
+        if (maint_q) begin
+            spill_way1 = maint_check_q ? ~maint_spill0 : maint_way1_q;
+        end
+    end
+
+    // a miss either replaces a line (line miss) or only fills the missing
+    // sector of a line with a matching tag (sector miss)
+    logic                     cache_hit, cache_miss, line_miss, cache_spill;
     logic [TAG_BIT_W-1:0]     spill_tag;
     logic [LINE_BYTE_W*8-1:0] spill_line;
-    assign cache_hit   = check_tag_q & (tag_match_way0 | tag_match_way1);
-    assign cache_miss  = check_tag_q & ~tag_match_way0 & ~tag_match_way1;
-    assign cache_spill = cache_miss & (lru_q[cpu_addr_q.part.index] ? way1_rdirty : way0_rdirty);
-    assign spill_tag   = lru_q[cpu_addr_q.part.index] ? way1_rtag   : way0_rtag;
-    assign spill_line  = lru_q[cpu_addr_q.part.index] ? way1_rline  : way0_rline;
+    logic [SECTOR_CNT-1:0]    spill_valid;
+    assign cache_hit   = check_tag_q & (sector_hit_way0 | sector_hit_way1);
+    assign cache_miss  = check_tag_q & ~sector_hit_way0 & ~sector_hit_way1;
+    assign line_miss   = cache_miss & ~tag_match_way0 & ~tag_match_way1;
+    assign cache_spill = line_miss & (repl_way1 ? way1_rdirty : way0_rdirty);
+    assign spill_tag   = spill_way1 ? way1_rtag   : way0_rtag;
+    assign spill_line  = spill_way1 ? way1_rline  : way0_rline;
+    assign spill_valid = (check_tag_q | maint_check_q) ?
+                         (spill_way1 ? way1_valid_q[cpu_addr_q.part.index] : way0_valid_q[cpu_addr_q.part.index]) :
+                         spill_valid_q;
+
+    // memory request counter of the current cycle (a spill starts with the
+    // first word of the line, a fill with the first word of the sector of the
+    // CPU request) and the counter values following a request (a fill ends
+    // after the last word of the sector; a spill skips invalid sectors, for
+    // which no requests are issued)
+    mem_counter_t fill_start, mem_req_cnt, mem_req_cnt_next, mem_req_cnt_adv, mem_data_cnt_next;
+    logic         mem_req_skip;
+    always_comb begin
+        fill_start.val = cpu_sector * SECTOR_REQ_CNT;
+        mem_req_cnt    = mem_req_cnt_q;
+        if (cache_miss | maint_spill) begin
+            mem_req_cnt.val = (cache_spill | maint_spill) ? '0 : fill_start.val;
+        end
+        mem_req_skip = mem_we_o & ~spill_valid[mem_req_cnt.part.cnt / SECTOR_REQ_CNT];
+        if (mem_we_o) begin
+            mem_req_cnt_next.val = mem_req_skip ? (mem_req_cnt.val | (SECTOR_REQ_CNT - 1)) + 1 : mem_req_cnt.val + 1;
+        end else begin
+            mem_req_cnt_next.val = ((mem_req_cnt.val + 1) % SECTOR_REQ_CNT == 0) ? LINE_FILL_REQ_CNT : mem_req_cnt.val + 1;
+        end
+        mem_req_cnt_adv      = (mem_gnt_i | mem_req_skip) ? mem_req_cnt_next : mem_req_cnt;
+        mem_data_cnt_next.val = ((mem_data_cnt_q.val + 1) % SECTOR_REQ_CNT == 0) ? LINE_FILL_REQ_CNT : mem_data_cnt_q.val + 1;
+    end
+
+    // next line address of range maintenance operations
+    logic [ADDR_BIT_W:0] maint_next_addr;
+    assign maint_next_addr = {1'b0, cpu_addr_q.addr} + LINE_BYTE_W;
 
     logic [OFFSET_BIT_W-1:0] cpu_addr_offset;
     generate
@@ -192,15 +328,75 @@ module vproc_cache #(
         cpu_wdata_d    = cpu_wdata_q;
         mem_req_cnt_d  = mem_req_cnt_q;
         mem_data_cnt_d = mem_data_cnt_q;
+        repl_way1_d    = repl_way1_q;
+        fill_dirty_d   = fill_dirty_q;
+        spill_valid_d  = spill_valid_q;
+        maint_d        = maint_q;
+        maint_check_d  = '0;
+        maint_clean_d  = maint_clean_q;
+        maint_inval_d  = maint_inval_q;
+        maint_all_d    = maint_all_q;
+        maint_way1_d   = maint_way1_q;
+        maint_end_d    = maint_end_q;
 
         if (mem_data_cnt_q.part.done) begin
             // no fill operation in progress
 
-            if (mem_req_cnt_q.part.done) begin
+            if (mem_req_cnt_q.part.done & maint_q) begin
+                // a maintenance operation is in progress
+
+                if (maint_check_q) begin
+                    if (maint_spill) begin
+                        // write back a dirty line (its dirty bit is cleared
+                        // now and the line is checked again afterwards)
+                        mem_req_cnt_d = mem_req_cnt_adv;
+                        maint_way1_d  = ~maint_spill0;
+                        spill_valid_d = spill_valid;
+                    end else begin
+                        if (maint_inval_q) begin
+                            if (maint_line0) begin
+                                way0_valid_d[cpu_addr_q.part.index] = '0;
+                            end
+                            if (maint_line1) begin
+                                way1_valid_d[cpu_addr_q.part.index] = '0;
+                            end
+                        end
+
+                        // proceed with the next line
+                        if (maint_all_q) begin
+                            cpu_addr_d.part.index = cpu_addr_q.part.index + 1;
+                            if (cpu_addr_q.part.index == INDEX_BIT_W'(WAY_LEN - 1)) begin
+                                maint_d = 1'b0;
+                            end
+                        end else begin
+                            cpu_addr_d.addr = maint_next_addr[ADDR_BIT_W-1:0];
+                            if (maint_next_addr >= {1'b0, maint_end_q}) begin
+                                maint_d = 1'b0;
+                            end
+                        end
+                        maint_check_d = maint_d;
+                    end
+                end
+
+            end else if (mem_req_cnt_q.part.done) begin
                 // no spill operation in progress
 
+                // if there is a maintenance request, start it with the first
+                // line in the next cycle (takes precedence over CPU requests)
+                if (ctrl_req_i & ~cache_miss) begin
+                    maint_d                = ctrl_all_i | (ctrl_start_i < ctrl_end_i);
+                    maint_check_d          = maint_d;
+                    maint_clean_d          = ctrl_clean_i;
+                    maint_inval_d          = ctrl_inval_i;
+                    maint_all_d            = ctrl_all_i;
+                    maint_end_d            = ctrl_end_i;
+                    cpu_addr_d.addr        = ctrl_all_i ? '0 : ctrl_start_i;
+                    cpu_addr_d.part.offset = '0;
+                    cpu_we_d               = 1'b0;
+                end
+
                 // if there is a CPU request, schedule tag check for next cycle
-                if (cpu_req_i & ~cache_miss) begin
+                else if (cpu_req_i & ~cache_miss) begin
                     check_tag_d     = 1'b1;
                     cpu_addr_d.addr = cpu_addr_i;
                     cpu_we_d        = cpu_we_i;
@@ -214,25 +410,43 @@ module vproc_cache #(
                     lru_d[cpu_addr_q.part.index] = tag_match_way0;
                 end
 
-                // start a spill or fill operation if a tag check failed (miss)
+                // start a spill or fill operation if a tag check failed (miss);
+                // a line miss invalidates all sectors of the replaced line,
+                // whereas a sector miss fills the line with the matching tag
                 if (cache_miss & ~hold_mem_i) begin
-                    mem_req_cnt_d.val = mem_gnt_i ? 1 : '0;
+                    mem_req_cnt_d = mem_req_cnt_adv;
+                    repl_way1_d   = line_miss ? repl_way1 : tag_match_way1;
+                    fill_dirty_d  = ~line_miss & (tag_match_way1 ? way1_rdirty : way0_rdirty);
+                    spill_valid_d = spill_valid;
+
+                    if (line_miss) begin
+                        if (~repl_way1) begin
+                            way0_valid_d[cpu_addr_q.part.index] = '0;
+                        end else begin
+                            way1_valid_d[cpu_addr_q.part.index] = '0;
+                        end
+                    end
 
                     if (~cache_spill) begin
-                        mem_data_cnt_d.val = '0;
+                        mem_data_cnt_d = fill_start;
                     end
                 end
 
             end else begin
                 // a line spill operation is in progress
 
-                if (mem_gnt_i) begin
-                    mem_req_cnt_d.val = mem_req_cnt_q.val + 1;
+                if (mem_gnt_i | mem_req_skip) begin
+                    mem_req_cnt_d = mem_req_cnt_next;
 
-                    // start refilling once the spill is done
+                    // start refilling once the spill is done (or check the
+                    // line again in case of a maintenance operation)
                     if (mem_req_cnt_d.part.done) begin
-                        mem_req_cnt_d.val  = '0;
-                        mem_data_cnt_d.val = '0;
+                        if (maint_q) begin
+                            maint_check_d = 1'b1;
+                        end else begin
+                            mem_req_cnt_d  = fill_start;
+                            mem_data_cnt_d = fill_start;
+                        end
                     end
                 end
 
@@ -241,18 +455,18 @@ module vproc_cache #(
         end else begin
             // a line fill operation is in progress
 
-            if (~lru_q[cpu_addr_q.part.index]) begin
-                way0_valid_d[cpu_addr_q.part.index] = 1'b1;
+            if (~repl_way1_q) begin
+                way0_valid_d[cpu_addr_q.part.index][cpu_sector] = 1'b1;
             end else begin
-                way1_valid_d[cpu_addr_q.part.index] = 1'b1;
+                way1_valid_d[cpu_addr_q.part.index][cpu_sector] = 1'b1;
             end
 
             if (~mem_req_cnt_q.part.done & mem_gnt_i) begin
-                mem_req_cnt_d.val = mem_req_cnt_q.val + 1;
+                mem_req_cnt_d = mem_req_cnt_next;
             end
 
             if (mem_rvalid_i) begin
-                mem_data_cnt_d.val = mem_data_cnt_q.val + 1;
+                mem_data_cnt_d = mem_data_cnt_next;
 
                 if (mem_data_cnt_d.part.done) begin
                     check_tag_d = 1'b1;
@@ -267,28 +481,35 @@ module vproc_cache #(
     assign cpu_addr.addr = cpu_addr_i;
 
     // Cache way interface signals
-    assign way_rindex     = mem_data_cnt_q.part.done ? cpu_addr.part.index : cpu_addr_q.part.index;
+    // (during maintenance operations the next line is read in advance and
+    // the dirty bit of a line is cleared when it is written back)
+    assign way_rindex     = maint_d ? cpu_addr_d.part.index : (mem_data_cnt_q.part.done ? cpu_addr.part.index : cpu_addr_q.part.index);
     assign way_windex     = cpu_addr_q.part.index;
-    assign way0_we        = mem_data_cnt_q.part.done ? (check_tag_q & tag_match_way0 & cpu_we_q) : ~lru_q[cpu_addr_q.part.index];
-    assign way1_we        = mem_data_cnt_q.part.done ? (check_tag_q & tag_match_way1 & cpu_we_q) :  lru_q[cpu_addr_q.part.index];
-    assign way_wtag       = cpu_addr_q.part.tag;
-    assign way_wline_be   = mem_data_cnt_q.part.done ?
+    assign way0_we        = mem_data_cnt_q.part.done ? (check_tag_q & tag_match_way0 & cpu_we_q) | (maint_spill & ~spill_way1) : ~repl_way1_q;
+    assign way1_we        = mem_data_cnt_q.part.done ? (check_tag_q & tag_match_way1 & cpu_we_q) | (maint_spill &  spill_way1) :  repl_way1_q;
+    assign way_wtag       = maint_q ? spill_tag : cpu_addr_q.part.tag;
+    assign way_wline_be   = maint_q ? '0 : (mem_data_cnt_q.part.done ?
                             {{(LINE_BYTE_W - CPU_BYTE_W){1'b0}}, cpu_wbe_q         } << cpu_addr_offset :
-                            {{(LINE_BYTE_W - MEM_BYTE_W){1'b0}}, {MEM_BYTE_W{1'b1}}} << (MEM_BYTE_W * mem_data_cnt_q.part.cnt);
+                            {{(LINE_BYTE_W - MEM_BYTE_W){1'b0}}, {MEM_BYTE_W{1'b1}}} << (MEM_BYTE_W * mem_data_cnt_q.part.cnt));
     assign way_wline_data = mem_data_cnt_q.part.done ? {(LINE_BYTE_W / CPU_BYTE_W){cpu_wdata_q}} : {(LINE_BYTE_W / MEM_BYTE_W){mem_rdata_i}};
-    assign way_wdirty     = mem_data_cnt_q.part.done & cpu_we_q;
+    assign way_wdirty     = mem_data_cnt_q.part.done ? cpu_we_q & ~maint_q : fill_dirty_q;
 
     // CPU interface signals
-    assign cpu_gnt_o    = mem_req_cnt_q.part.done & mem_data_cnt_q.part.done & ~cache_miss;
+    assign cpu_gnt_o    = mem_req_cnt_q.part.done & mem_data_cnt_q.part.done & ~cache_miss & ~maint_q & ~ctrl_req_i;
     assign cpu_rvalid_o = cache_hit; // & ~cpu_we_q;
     assign cpu_rdata_o  = tag_match_line[cpu_addr_offset * 8 +: CPU_BYTE_W * 8];
     assign cpu_err_o    = '0;
+    assign miss_o       = cache_miss & ~hold_mem_i;
+
+    // maintenance interface signals
+    assign ctrl_gnt_o  = mem_req_cnt_q.part.done & mem_data_cnt_q.part.done & ~cache_miss & ~maint_q;
+    assign ctrl_busy_o = maint_q;
 
     // memory interface signals
-    assign mem_req_o   = ~mem_req_cnt_q.part.done | cache_miss;
-    assign mem_we_o    = (~mem_req_cnt_q.part.done & mem_data_cnt_q.part.done) | cache_spill;
-    assign mem_addr_o  = {mem_we_o ? spill_tag : cpu_addr_q.part.tag, cpu_addr_q.part.index, mem_req_cnt_q.part.cnt, {$clog2(MEM_BYTE_W){1'b0}}};
-    assign mem_wdata_o = spill_line[mem_req_cnt_q.part.cnt * MEM_BYTE_W * 8 +: MEM_BYTE_W * 8];
+    assign mem_req_o   = (~mem_req_cnt_q.part.done | cache_miss | maint_spill) & ~mem_req_skip;
+    assign mem_we_o    = (~mem_req_cnt_q.part.done & mem_data_cnt_q.part.done) | cache_spill | maint_spill;
+    assign mem_addr_o  = {mem_we_o ? spill_tag : cpu_addr_q.part.tag, cpu_addr_q.part.index, mem_req_cnt.part.cnt, {$clog2(MEM_BYTE_W){1'b0}}};
+    assign mem_wdata_o = spill_line[mem_req_cnt.part.cnt * MEM_BYTE_W * 8 +: MEM_BYTE_W * 8];
 
 endmodule
 
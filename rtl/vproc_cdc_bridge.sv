@@ -0,0 +1,753 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// Clock domain bridge between the main core (clk_i) and the vector unit
+// (vclk_i, i.e., vproc_core, the data arbiter, and the data cache).  If ASYNC
+// is not set, both sides run on the same clock and are connected directly.
+// Otherwise, the interfaces cross the clock domains as follows:
+// - Vector instructions, CSR writes, and data cache maintenance operations
+//   are sent to the vector domain in program order through a command FIFO.
+//   An offloaded instruction is granted once the response of the vector core
+//   (grant and illegal flag) has returned through the response FIFO, hence
+//   the main core observes the same behavior as with a single clock, only
+//   with a longer latency.  Results for x registers follow the same path.
+// - Every response carries a snapshot of the vector CSRs and of the status
+//   flags of the vector core, from which the CSRs are read in the main
+//   domain; further snapshots are sent whenever that state changes.  Values
+//   written by the main core take effect immediately and are only replaced
+//   by a snapshot once the vector domain has applied all writes.
+// - The performance and trace events of the vector domain are counted until
+//   the next response is sent, which carries the number of occurrences of
+//   each event to the main domain (events_o holds these counts for a single
+//   cycle).  The counts saturate at 2**EVT_CNT_W - 1, which is only reached
+//   if the vector clock is about that many times faster than the main clock.
+// - Scalar data requests of the main core and the memory requests of the
+//   data cache (or of the data arbiter without data cache) cross through a
+//   pair of request and response FIFOs each.  Instructions and cache
+//   operations are only sent once all scalar data requests have completed,
+//   such that they remain ordered.  The number of outstanding memory
+//   requests is limited to the depth of the response FIFO.
+// - The level signals for the vector memory suspension and the data cache
+//   way locking pass through two-stage synchronizers.
+module vproc_cdc_bridge #(
+        parameter bit                    ASYNC      = 1'b0, // asynchronous clocks
+        parameter int unsigned           MEM_W      = 32,   // memory bus width in bits
+        parameter int unsigned           EVT_W      = 1,    // number of vector domain events
+        parameter int unsigned           EVT_CNT_W  = 4,    // width of the event counts
+        parameter int unsigned           FIFO_DEPTH = 4     // depth of the CDC FIFOs
+    )(
+        input  logic                     clk_i,
+        input  logic                     vclk_i,
+        input  logic                     rst_ni,
+
+        // main clock domain: offload interface
+        input  logic                     instr_valid_i,
+        input  logic [31:0]              instr_i,
+        input  logic [31:0]              x_rs1_i,
+        input  logic [31:0]              x_rs2_i,
+        output logic                     instr_gnt_o,
+        output logic                     instr_illegal_o,
+        output logic                     xreg_wait_o,
+        output logic                     xreg_valid_o,
+        output logic [31:0]              xreg_o,
+
+        // main clock domain: vector CSRs and status
+        output logic [31:0]              csr_vtype_o,
+        output logic [31:0]              csr_vl_o,
+        output logic [31:0]              csr_vstart_o,
+        input  logic [31:0]              csr_vstart_i,
+        input  logic                     csr_vstart_set_i,
+        output logic [1:0]               csr_vxrm_o,
+        input  logic [1:0]               csr_vxrm_i,
+        input  logic                     csr_vxrm_set_i,
+        output logic                     csr_vxsat_o,
+        input  logic                     csr_vxsat_i,
+        input  logic                     csr_vxsat_set_i,
+        output logic                     pending_disp_o,
+        output logic                     mem_busy_o,     // vector memory request or pending load/store
+        output logic [31:0]              dirty_vregs_o,
+        output logic                     dirty_cfg_o,
+        output logic [EVT_W-1:0][EVT_CNT_W-1:0] events_o, // occurrences of each event
+
+        // main clock domain: scalar data interface
+        input  logic                     sdata_req_i,
+        input  logic [31:0]              sdata_addr_i,
+        input  logic                     sdata_we_i,
+        input  logic [3:0]               sdata_be_i,
+        input  logic [31:0]              sdata_wdata_i,
+        output logic                     sdata_gnt_o,
+        output logic                     sdata_rvalid_o,
+        output logic                     sdata_err_o,
+        output logic [31:0]              sdata_rdata_o,
+
+        // main clock domain: data cache control
+        input  logic                     dcache_ctrl_req_i,
+        input  logic [2:0]               dcache_ctrl_op_i,    // {all, inval, clean}
+        input  logic [31:0]              dcache_ctrl_start_i,
+        input  logic [31:0]              dcache_ctrl_end_i,
+        output logic                     dcache_ctrl_gnt_o,
+        output logic                     dcache_ctrl_busy_o,
+        input  logic [1:0]               dcache_lock_i,
+        input  logic                     cache_hold_i,        // hold scalar data requests
+        input  logic                     vsusp_i,
+
+        // main clock domain: data memory interface
+        output logic                     dmem_req_o,
+        output logic [31:0]              dmem_addr_o,
+        output logic                     dmem_we_o,
+        output logic [MEM_W/8-1:0]       dmem_be_o,
+        output logic [MEM_W  -1:0]       dmem_wdata_o,
+        input  logic                     dmem_gnt_i,
+        input  logic                     dmem_rvalid_i,
+        input  logic                     dmem_err_i,
+        input  logic [MEM_W  -1:0]       dmem_rdata_i,
+
+        // vector clock domain: offload interface
+        output logic                     vinstr_valid_o,
+        output logic [31:0]              vinstr_o,
+        output logic [31:0]              vx_rs1_o,
+        output logic [31:0]              vx_rs2_o,
+        input  logic                     vinstr_gnt_i,
+        input  logic                     vinstr_illegal_i,
+        input  logic                     vxreg_wait_i,
+        input  logic                     vxreg_valid_i,
+        input  logic [31:0]              vxreg_i,
+
+        // vector clock domain: vector CSRs and status
+        input  logic [31:0]              vcsr_vtype_i,
+        input  logic [31:0]              vcsr_vl_i,
+        input  logic [31:0]              vcsr_vstart_i,
+        output logic [31:0]              vcsr_vstart_o,
+        output logic                     vcsr_vstart_set_o,
+        input  logic [1:0]               vcsr_vxrm_i,
+        output logic [1:0]               vcsr_vxrm_o,
+        output logic                     vcsr_vxrm_set_o,
+        input  logic                     vcsr_vxsat_i,
+        output logic                     vcsr_vxsat_o,
+        output logic                     vcsr_vxsat_set_o,
+        input  logic                     vpending_disp_i,
+        input  logic                     vmem_busy_i,
+        input  logic [31:0]              vdirty_vregs_i,
+        input  logic                     vdirty_cfg_i,
+        input  logic [EVT_W-1:0]         vevents_i,
+
+        // vector clock domain: scalar data interface
+        output logic                     vsdata_req_o,
+        output logic [31:0]              vsdata_addr_o,
+        output logic                     vsdata_we_o,
+        output logic [3:0]               vsdata_be_o,
+        output logic [31:0]              vsdata_wdata_o,
+        input  logic                     vsdata_gnt_i,
+        input  logic                     vsdata_rvalid_i,
+        input  logic                     vsdata_err_i,
+        input  logic [31:0]              vsdata_rdata_i,
+
+        // vector clock domain: data cache control
+        output logic                     vdcache_ctrl_req_o,
+        output logic [2:0]               vdcache_ctrl_op_o,
+        output logic [31:0]              vdcache_ctrl_start_o,
+        output logic [31:0]              vdcache_ctrl_end_o,
+        input  logic                     vdcache_ctrl_gnt_i,
+        input  logic                     vdcache_ctrl_busy_i,
+        output logic [1:0]               vdcache_lock_o,
+        output logic                     vcache_hold_o,
+        output logic                     vsusp_o,
+
+        // vector clock domain: data memory interface
+        input  logic                     vdmem_req_i,
+        input  logic [31:0]              vdmem_addr_i,
+        input  logic                     vdmem_we_i,
+        input  logic [MEM_W/8-1:0]       vdmem_be_i,
+        input  logic [MEM_W  -1:0]       vdmem_wdata_i,
+        output logic                     vdmem_gnt_o,
+        output logic                     vdmem_rvalid_o,
+        output logic                     vdmem_err_o,
+        output logic [MEM_W  -1:0]       vdmem_rdata_o
+    );
+
+    localparam bit [1:0] CMD_INSTR = 2'd0;
+    localparam bit [1:0] CMD_CSR   = 2'd1;
+    localparam bit [1:0] CMD_CACHE = 2'd2;
+
+    localparam bit [1:0] RESP_STATE = 2'd0; // state snapshot only
+    localparam bit [1:0] RESP_GNT   = 2'd1; // instruction granted
+    localparam bit [1:0] RESP_XREG  = 2'd2; // x register result
+    localparam bit [1:0] RESP_CACHE = 2'd3; // cache operation completed
+
+    typedef struct packed {
+        logic [1:0]  kind;
+        logic [95:0] payload;
+    } cmd_t;
+
+    typedef struct packed {
+        logic        vstart_set;
+        logic        vxrm_set;
+        logic        vxsat_set;
+        logic [31:0] vstart;
+        logic [1:0]  vxrm;
+        logic        vxsat;
+    } csr_wr_t;
+
+    typedef struct packed {
+        logic [3:0]  csr_cnt;       // number of CSR write commands applied
+        logic [31:0] vtype;
+        logic [31:0] vl;
+        logic [31:0] vstart;
+        logic [1:0]  vxrm;
+        logic        vxsat;
+        logic        pending_disp;
+        logic        mem_busy;
+    } state_t;
+
+    typedef struct packed {
+        logic [1:0]       kind;
+        logic             illegal;
+        logic             xreg_wait;
+        logic [31:0]      xreg;
+        state_t           state;
+        logic [31:0]      dirty_vregs;  // accumulated since the last response
+        logic             dirty_cfg;
+        logic [EVT_W-1:0][EVT_CNT_W-1:0] events;
+    } resp_t;
+
+    generate
+        if (!ASYNC) begin
+            assign vinstr_valid_o       = instr_valid_i;
+            assign vinstr_o             = instr_i;
+            assign vx_rs1_o             = x_rs1_i;
+            assign vx_rs2_o             = x_rs2_i;
+            assign instr_gnt_o          = vinstr_gnt_i;
+            assign instr_illegal_o      = vinstr_illegal_i;
+            assign xreg_wait_o          = vxreg_wait_i;
+            assign xreg_valid_o         = vxreg_valid_i;
+            assign xreg_o               = vxreg_i;
+
+            assign csr_vtype_o          = vcsr_vtype_i;
+            assign csr_vl_o             = vcsr_vl_i;
+            assign csr_vstart_o         = vcsr_vstart_i;
+            assign vcsr_vstart_o        = csr_vstart_i;
+            assign vcsr_vstart_set_o    = csr_vstart_set_i;
+            assign csr_vxrm_o           = vcsr_vxrm_i;
+            assign vcsr_vxrm_o          = csr_vxrm_i;
+            assign vcsr_vxrm_set_o      = csr_vxrm_set_i;
+            assign csr_vxsat_o          = vcsr_vxsat_i;
+            assign vcsr_vxsat_o         = csr_vxsat_i;
+            assign vcsr_vxsat_set_o     = csr_vxsat_set_i;
+            assign pending_disp_o       = vpending_disp_i;
+            assign mem_busy_o           = vmem_busy_i;
+            assign dirty_vregs_o        = vdirty_vregs_i;
+            assign dirty_cfg_o          = vdirty_cfg_i;
+            always_comb begin
+                for (int i = 0; i < EVT_W; i++) begin
+                    events_o[i] = EVT_CNT_W'(vevents_i[i]);
+                end
+            end
+
+            assign vsdata_req_o         = sdata_req_i;
+            assign vsdata_addr_o        = sdata_addr_i;
+            assign vsdata_we_o          = sdata_we_i;
+            assign vsdata_be_o          = sdata_be_i;
+            assign vsdata_wdata_o       = sdata_wdata_i;
+            assign sdata_gnt_o          = vsdata_gnt_i;
+            assign sdata_rvalid_o       = vsdata_rvalid_i;
+            assign sdata_err_o          = vsdata_err_i;
+            assign sdata_rdata_o        = vsdata_rdata_i;
+
+            assign vdcache_ctrl_req_o   = dcache_ctrl_req_i;
+            assign vdcache_ctrl_op_o    = dcache_ctrl_op_i;
+            assign vdcache_ctrl_start_o = dcache_ctrl_start_i;
+            assign vdcache_ctrl_end_o   = dcache_ctrl_end_i;
+            assign dcache_ctrl_gnt_o    = vdcache_ctrl_gnt_i;
+            assign dcache_ctrl_busy_o   = vdcache_ctrl_busy_i;
+            assign vdcache_lock_o       = dcache_lock_i;
+            assign vcache_hold_o        = cache_hold_i;
+            assign vsusp_o              = vsusp_i;
+
+            assign dmem_req_o           = vdmem_req_i;
+            assign dmem_addr_o          = vdmem_addr_i;
+            assign dmem_we_o            = vdmem_we_i;
+            assign dmem_be_o            = vdmem_be_i;
+            assign dmem_wdata_o         = vdmem_wdata_i;
+            assign vdmem_gnt_o          = dmem_gnt_i;
+            assign vdmem_rvalid_o       = dmem_rvalid_i;
+            assign vdmem_err_o          = dmem_err_i;
+            assign vdmem_rdata_o        = dmem_rdata_i;
+        end else begin
+
+            ///////////////////////////////////////////////////////////////////
+            // Command and response FIFOs
+
+            logic  cmd_enq_ready, cmd_enq_valid, cmd_deq_ready, cmd_deq_valid;
+            cmd_t  cmd_enq,       cmd_deq;
+            vproc_cdc_fifo #(
+                .WIDTH        ( $bits(cmd_t)  ),
+                .DEPTH        ( FIFO_DEPTH    )
+            ) cmd_fifo (
+                .rst_ni       ( rst_ni        ),
+                .enq_clk_i    ( clk_i         ),
+                .enq_ready_o  ( cmd_enq_ready ),
+                .enq_valid_i  ( cmd_enq_valid ),
+                .enq_data_i   ( cmd_enq       ),
+                .deq_clk_i    ( vclk_i        ),
+                .deq_ready_i  ( cmd_deq_ready ),
+                .deq_valid_o  ( cmd_deq_valid ),
+                .deq_data_o   ( cmd_deq       )
+            );
+
+            logic  resp_enq_ready, resp_enq_valid, resp_deq_valid;
+            resp_t resp_enq,       resp_deq;
+            vproc_cdc_fifo #(
+                .WIDTH        ( $bits(resp_t)  ),
+                .DEPTH        ( FIFO_DEPTH     )
+            ) resp_fifo (
+                .rst_ni       ( rst_ni         ),
+                .enq_clk_i    ( vclk_i         ),
+                .enq_ready_o  ( resp_enq_ready ),
+                .enq_valid_i  ( resp_enq_valid ),
+                .enq_data_i   ( resp_enq       ),
+                .deq_clk_i    ( clk_i          ),
+                .deq_ready_i  ( 1'b1           ), // responses are consumed immediately
+                .deq_valid_o  ( resp_deq_valid ),
+                .deq_data_o   ( resp_deq       )
+            );
+
+
+            ///////////////////////////////////////////////////////////////////
+            // Main clock domain side of the command and response FIFOs
+
+            // CSR writes cannot be stalled, hence they are collected in a
+            // register (a later write replaces an earlier one to the same CSR)
+            // and sent as soon as the command FIFO accepts them; instructions
+            // and cache operations are only sent once all preceding CSR writes
+            // have been sent
+            csr_wr_t    csr_wr_q, csr_wr_d;
+            logic [3:0] csr_cnt_q;          // number of CSR write commands sent
+            logic       csr_wr_pend, csr_wr_now, csr_wr_push;
+            assign csr_wr_pend = csr_wr_q.vstart_set | csr_wr_q.vxrm_set | csr_wr_q.vxsat_set;
+            assign csr_wr_now  = csr_vstart_set_i | csr_vxrm_set_i | csr_vxsat_set_i;
+            assign csr_wr_push = csr_wr_pend & cmd_enq_ready;
+            always_comb begin
+                csr_wr_d = csr_wr_q;
+                if (csr_wr_push) begin
+                    csr_wr_d.vstart_set = 1'b0;
+                    csr_wr_d.vxrm_set   = 1'b0;
+                    csr_wr_d.vxsat_set  = 1'b0;
+                end
+                if (csr_vstart_set_i) begin
+                    csr_wr_d.vstart_set = 1'b1;
+                    csr_wr_d.vstart     = csr_vstart_i;
+                end
+                if (csr_vxrm_set_i) begin
+                    csr_wr_d.vxrm_set   = 1'b1;
+                    csr_wr_d.vxrm       = csr_vxrm_i;
+                end
+                if (csr_vxsat_set_i) begin
+                    csr_wr_d.vxsat_set  = 1'b1;
+                    csr_wr_d.vxsat      = csr_vxsat_i;
+                end
+            end
+
+            // offloaded instructions wait for their response; a data cache
+            // operation is granted once sent and busy until completed; since
+            // scalar data requests cross through a separate FIFO, neither is
+            // sent while a scalar data request is outstanding
+            logic instr_wait_q;
+            logic instr_push, cache_push;
+            logic cache_busy_q;
+            logic sdata_idle;
+            assign instr_push = instr_valid_i & ~instr_wait_q & ~csr_wr_pend & ~csr_wr_now & sdata_idle &
+                                cmd_enq_ready;
+            assign cache_push = dcache_ctrl_req_i & ~(instr_valid_i & ~instr_wait_q) & ~csr_wr_pend &
+                                ~csr_wr_now & sdata_idle & cmd_enq_ready;
+            always_comb begin
+                cmd_enq_valid = csr_wr_push | instr_push | cache_push;
+                cmd_enq.kind    = CMD_INSTR;
+                cmd_enq.payload = {instr_i, x_rs1_i, x_rs2_i};
+                if (csr_wr_push) begin
+                    cmd_enq.kind    = CMD_CSR;
+                    cmd_enq.payload = 96'(csr_wr_q);
+                end
+                else if (cache_push) begin
+                    cmd_enq.kind    = CMD_CACHE;
+                    cmd_enq.payload = 96'({dcache_ctrl_op_i, dcache_ctrl_start_i, dcache_ctrl_end_i});
+                end
+            end
+            assign dcache_ctrl_gnt_o  = cache_push;
+            assign dcache_ctrl_busy_o = cache_busy_q;
+
+            // values of the vector CSRs and status flags in the main domain
+            state_t state_q;
+            logic   csr_sync;       // the vector domain has applied all CSR writes
+            assign csr_sync = (resp_deq.state.csr_cnt == csr_cnt_q) & ~csr_wr_pend & ~csr_wr_now;
+            always_ff @(posedge clk_i or negedge rst_ni) begin
+                if (~rst_ni) begin
+                    csr_wr_q     <= '0;
+                    csr_cnt_q    <= '0;
+                    instr_wait_q <= 1'b0;
+                    cache_busy_q <= 1'b0;
+                    state_q      <= '{vtype: 32'h80000000, default: '0};
+                end else begin
+                    csr_wr_q <= csr_wr_d;
+                    if (csr_wr_push) begin
+                        csr_cnt_q <= csr_cnt_q + 1;
+                    end
+                    if (instr_push) begin
+                        instr_wait_q <= 1'b1;
+                    end
+                    else if (resp_deq_valid & (resp_deq.kind == RESP_GNT)) begin
+                        instr_wait_q <= 1'b0;
+                    end
+                    if (cache_push) begin
+                        cache_busy_q <= 1'b1;
+                    end
+                    else if (resp_deq_valid & (resp_deq.kind == RESP_CACHE)) begin
+                        cache_busy_q <= 1'b0;
+                    end
+                    if (resp_deq_valid) begin
+                        state_q.vtype        <= resp_deq.state.vtype;
+                        state_q.vl           <= resp_deq.state.vl;
+                        state_q.pending_disp <= resp_deq.state.pending_disp;
+                        state_q.mem_busy     <= resp_deq.state.mem_busy;
+                        if (csr_sync) begin
+                            state_q.vstart <= resp_deq.state.vstart;
+                            state_q.vxrm   <= resp_deq.state.vxrm;
+                            state_q.vxsat  <= resp_deq.state.vxsat;
+                        end
+                    end
+                    // written values take effect immediately
+                    if (csr_vstart_set_i) begin
+                        state_q.vstart <= csr_vstart_i;
+                    end
+                    if (csr_vxrm_set_i) begin
+                        state_q.vxrm   <= csr_vxrm_i;
+                    end
+                    if (csr_vxsat_set_i) begin
+                        state_q.vxsat  <= csr_vxsat_i;
+                    end
+                end
+            end
+            assign csr_vtype_o    = state_q.vtype;
+            assign csr_vl_o       = state_q.vl;
+            assign csr_vstart_o   = state_q.vstart;
+            assign csr_vxrm_o     = state_q.vxrm;
+            assign csr_vxsat_o    = state_q.vxsat;
+            assign pending_disp_o = state_q.pending_disp;
+            assign mem_busy_o     = state_q.mem_busy;
+
+            assign instr_gnt_o     = instr_wait_q & resp_deq_valid & (resp_deq.kind == RESP_GNT);
+            assign instr_illegal_o = instr_gnt_o & resp_deq.illegal;
+            assign xreg_wait_o     = instr_gnt_o & resp_deq.xreg_wait;
+            assign xreg_valid_o    = resp_deq_valid & (resp_deq.kind == RESP_XREG);
+            assign xreg_o          = resp_deq.xreg;
+
+            assign dirty_vregs_o = resp_deq_valid ? resp_deq.dirty_vregs : '0;
+            assign dirty_cfg_o   = resp_deq_valid & resp_deq.dirty_cfg;
+            assign events_o      = resp_deq_valid ? resp_deq.events : '0;
+
+
+            ///////////////////////////////////////////////////////////////////
+            // Vector clock domain side of the command and response FIFOs
+
+            logic             gnt_pend_q;   // grant waiting to be sent
+            logic             gnt_illegal_q, gnt_xreg_wait_q;
+            logic             xreg_pend_q;  // x register result waiting to be sent
+            logic [31:0]      xreg_q;
+            logic             cache_op_q;   // cache operation waiting to be accepted
+            logic             cache_wait_q; // cache operation waiting to complete
+            logic             cache_pend_q; // completion waiting to be sent
+            logic [2:0]       cache_op_type_q;
+            logic [31:0]      cache_start_q, cache_end_q;
+            logic [3:0]       vcsr_cnt_q;
+            state_t           vstate, vstate_sent_q;
+            logic [31:0]      vdirty_vregs_q;
+            logic             vdirty_cfg_q;
+            logic [EVT_W-1:0][EVT_CNT_W-1:0] vevents_q; // occurrences since the last response
+
+            // the next command is only processed once the preceding one has
+            // completed
+            logic    cmd_idle;
+            csr_wr_t cmd_csr;
+            assign cmd_idle = ~gnt_pend_q & ~xreg_pend_q & ~cache_op_q & ~cache_wait_q & ~cache_pend_q;
+            assign cmd_csr  = csr_wr_t'(cmd_deq.payload[$bits(csr_wr_t)-1:0]);
+
+            assign vinstr_valid_o = cmd_idle & cmd_deq_valid & (cmd_deq.kind == CMD_INSTR);
+            assign {vinstr_o, vx_rs1_o, vx_rs2_o} = cmd_deq.payload;
+
+            assign vcsr_vstart_o     = cmd_csr.vstart;
+            assign vcsr_vxrm_o       = cmd_csr.vxrm;
+            assign vcsr_vxsat_o      = cmd_csr.vxsat;
+            assign vcsr_vstart_set_o = cmd_idle & cmd_deq_valid & (cmd_deq.kind == CMD_CSR) & cmd_csr.vstart_set;
+            assign vcsr_vxrm_set_o   = cmd_idle & cmd_deq_valid & (cmd_deq.kind == CMD_CSR) & cmd_csr.vxrm_set;
+            assign vcsr_vxsat_set_o  = cmd_idle & cmd_deq_valid & (cmd_deq.kind == CMD_CSR) & cmd_csr.vxsat_set;
+
+            always_comb begin
+                cmd_deq_ready = 1'b0;
+                if (cmd_idle) begin
+                    unique case (cmd_deq.kind)
+                        CMD_INSTR: cmd_deq_ready = vinstr_gnt_i;
+                        CMD_CSR:   cmd_deq_ready = 1'b1;
+                        CMD_CACHE: cmd_deq_ready = 1'b1;
+                        default:   cmd_deq_ready = 1'b1;
+                    endcase
+                end
+            end
+
+            // cache operations wait for pending vector loads and stores
+            assign vdcache_ctrl_req_o   = cache_op_q & ~vmem_busy_i;
+            assign vdcache_ctrl_op_o    = cache_op_type_q;
+            assign vdcache_ctrl_start_o = cache_start_q;
+            assign vdcache_ctrl_end_o   = cache_end_q;
+            assign vcache_hold_o        = cache_op_q | cache_wait_q | vdcache_ctrl_busy_i;
+
+            assign vstate.csr_cnt      = vcsr_cnt_q;
+            assign vstate.vtype        = vcsr_vtype_i;
+            assign vstate.vl           = vcsr_vl_i;
+            assign vstate.vstart       = vcsr_vstart_i;
+            assign vstate.vxrm         = vcsr_vxrm_i;
+            assign vstate.vxsat        = vcsr_vxsat_i;
+            assign vstate.pending_disp = vpending_disp_i;
+            assign vstate.mem_busy     = vmem_busy_i;
+
+            // responses in order of priority; a state snapshot is sent
+            // whenever the state has changed or events have occurred
+            always_comb begin
+                resp_enq             = '0;
+                resp_enq.state       = vstate;
+                resp_enq.dirty_vregs = vdirty_vregs_q | vdirty_vregs_i;
+                resp_enq.dirty_cfg   = vdirty_cfg_q   | vdirty_cfg_i;
+                for (int i = 0; i < EVT_W; i++) begin
+                    resp_enq.events[i] = vevents_q[i] + EVT_CNT_W'(vevents_i[i] & (vevents_q[i] != '1));
+                end
+                resp_enq.kind        = RESP_STATE;
+                resp_enq.illegal     = gnt_illegal_q;
+                resp_enq.xreg_wait   = gnt_xreg_wait_q;
+                resp_enq.xreg        = xreg_q;
+                resp_enq_valid       = (vstate != vstate_sent_q) | (resp_enq.dirty_vregs != '0) |
+                                       resp_enq.dirty_cfg | (resp_enq.events != '0);
+                if (gnt_pend_q) begin
+                    resp_enq.kind  = RESP_GNT;
+                    resp_enq_valid = 1'b1;
+                end
+                else if (xreg_pend_q) begin
+                    resp_enq.kind  = RESP_XREG;
+                    resp_enq_valid = 1'b1;
+                end
+                else if (cache_pend_q) begin
+                    resp_enq.kind  = RESP_CACHE;
+                    resp_enq_valid = 1'b1;
+                end
+            end
+
+            always_ff @(posedge vclk_i or negedge rst_ni) begin
+                if (~rst_ni) begin
+                    gnt_pend_q      <= 1'b0;
+                    gnt_illegal_q   <= 1'b0;
+                    gnt_xreg_wait_q <= 1'b0;
+                    xreg_pend_q     <= 1'b0;
+                    xreg_q          <= '0;
+                    cache_op_q      <= 1'b0;
+                    cache_wait_q    <= 1'b0;
+                    cache_pend_q    <= 1'b0;
+                    cache_op_type_q <= '0;
+                    cache_start_q   <= '0;
+                    cache_end_q     <= '0;
+                    vcsr_cnt_q      <= '0;
+                    vstate_sent_q   <= '0;
+                    vdirty_vregs_q  <= '0;
+                    vdirty_cfg_q    <= 1'b0;
+                    vevents_q       <= '0;
+                end else begin
+                    // the grant is sent in the cycle after the instruction
+                    // has been accepted, such that the snapshot includes its
+                    // effect on the CSRs
+                    if (vinstr_valid_o & vinstr_gnt_i) begin
+                        gnt_pend_q      <= 1'b1;
+                        gnt_illegal_q   <= vinstr_illegal_i;
+                        gnt_xreg_wait_q <= vxreg_wait_i & ~vinstr_illegal_i;
+                    end
+                    if (vxreg_valid_i) begin
+                        xreg_pend_q <= 1'b1;
+                        xreg_q      <= vxreg_i;
+                    end
+                    if (cmd_idle & cmd_deq_valid & (cmd_deq.kind == CMD_CSR)) begin
+                        vcsr_cnt_q <= vcsr_cnt_q + 1;
+                    end
+                    if (cmd_idle & cmd_deq_valid & (cmd_deq.kind == CMD_CACHE)) begin
+                        cache_op_q                                    <= 1'b1;
+                        {cache_op_type_q, cache_start_q, cache_end_q} <= cmd_deq.payload[66:0];
+                    end
+                    if (vdcache_ctrl_req_o & vdcache_ctrl_gnt_i) begin
+                        cache_op_q   <= 1'b0;
+                        cache_wait_q <= 1'b1;
+                    end
+                    if (cache_wait_q & ~vdcache_ctrl_busy_i) begin
+                        cache_wait_q <= 1'b0;
+                        cache_pend_q <= 1'b1;
+                    end
+                    if (resp_enq_valid & resp_enq_ready) begin
+                        unique case (resp_enq.kind)
+                            RESP_GNT:   gnt_pend_q   <= 1'b0;
+                            RESP_XREG:  xreg_pend_q  <= 1'b0;
+                            RESP_CACHE: cache_pend_q <= 1'b0;
+                            default: ;
+                        endcase
+                        vstate_sent_q  <= vstate;
+                        vdirty_vregs_q <= '0;
+                        vdirty_cfg_q   <= 1'b0;
+                        vevents_q      <= '0;
+                    end else begin
+                        vdirty_vregs_q <= resp_enq.dirty_vregs;
+                        vdirty_cfg_q   <= resp_enq.dirty_cfg;
+                        vevents_q      <= resp_enq.events;
+                    end
+                end
+            end
+
+
+            ///////////////////////////////////////////////////////////////////
+            // Scalar data interface
+
+            logic        sdata_push;
+            logic        sreq_enq_ready, sreq_deq_valid, sreq_deq_ready;
+            logic [68:0] sreq_deq;
+            vproc_cdc_fifo #(
+                .WIDTH        ( 69                                                  ),
+                .DEPTH        ( FIFO_DEPTH                                          )
+            ) sreq_fifo (
+                .rst_ni       ( rst_ni                                              ),
+                .enq_clk_i    ( clk_i                                               ),
+                .enq_ready_o  ( sreq_enq_ready                                      ),
+                .enq_valid_i  ( sdata_push                                          ),
+                .enq_data_i   ( {sdata_addr_i, sdata_we_i, sdata_be_i, sdata_wdata_i} ),
+                .deq_clk_i    ( vclk_i                                              ),
+                .deq_ready_i  ( sreq_deq_ready                                      ),
+                .deq_valid_o  ( sreq_deq_valid                                      ),
+                .deq_data_o   ( sreq_deq                                            )
+            );
+            // scalar data requests are held during cache operations
+            assign sdata_push  = sdata_req_i & ~cache_hold_i & sreq_enq_ready;
+            assign sdata_gnt_o = sdata_push;
+
+            logic [$clog2(FIFO_DEPTH):0] sdata_cnt_q;   // outstanding requests (main domain)
+            always_ff @(posedge clk_i or negedge rst_ni) begin
+                if (~rst_ni) begin
+                    sdata_cnt_q <= '0;
+                end else begin
+                    sdata_cnt_q <= sdata_cnt_q + {{$clog2(FIFO_DEPTH){1'b0}}, sdata_push}
+                                               - {{$clog2(FIFO_DEPTH){1'b0}}, sdata_rvalid_o};
+                end
+            end
+            assign sdata_idle = sdata_cnt_q == '0;
+
+            logic sresp_enq_ready;
+            vproc_cdc_fifo #(
+                .WIDTH        ( 33                              ),
+                .DEPTH        ( FIFO_DEPTH                      )
+            ) sresp_fifo (
+                .rst_ni       ( rst_ni                          ),
+                .enq_clk_i    ( vclk_i                          ),
+                .enq_ready_o  ( sresp_enq_ready                 ),
+                .enq_valid_i  ( vsdata_rvalid_i                 ),
+                .enq_data_i   ( {vsdata_err_i, vsdata_rdata_i}  ),
+                .deq_clk_i    ( clk_i                           ),
+                .deq_ready_i  ( 1'b1                            ),
+                .deq_valid_o  ( sdata_rvalid_o                  ),
+                .deq_data_o   ( {sdata_err_o, sdata_rdata_o}    )
+            );
+
+            // one scalar request at a time, issued only if its response can
+            // be accepted
+            logic sdata_out_q;
+            always_ff @(posedge vclk_i or negedge rst_ni) begin
+                if (~rst_ni) begin
+                    sdata_out_q <= 1'b0;
+                end else begin
+                    if (vsdata_req_o & vsdata_gnt_i) begin
+                        sdata_out_q <= 1'b1;
+                    end
+                    else if (vsdata_rvalid_i) begin
+                        sdata_out_q <= 1'b0;
+                    end
+                end
+            end
+            assign vsdata_req_o   = sreq_deq_valid & ~sdata_out_q & sresp_enq_ready;
+            assign sreq_deq_ready = vsdata_req_o & vsdata_gnt_i;
+            assign {vsdata_addr_o, vsdata_we_o, vsdata_be_o, vsdata_wdata_o} = sreq_deq;
+
+
+            ///////////////////////////////////////////////////////////////////
+            // Data memory interface
+
+            localparam int unsigned DREQ_W = 33 + MEM_W / 8 + MEM_W;
+
+            logic              dreq_enq_ready, dreq_deq_valid;
+            logic [DREQ_W-1:0] dreq_deq;
+            vproc_cdc_fifo #(
+                .WIDTH        ( DREQ_W                                              ),
+                .DEPTH        ( FIFO_DEPTH                                          )
+            ) dreq_fifo (
+                .rst_ni       ( rst_ni                                              ),
+                .enq_clk_i    ( vclk_i                                              ),
+                .enq_ready_o  ( dreq_enq_ready                                      ),
+                .enq_valid_i  ( vdmem_gnt_o                                         ),
+                .enq_data_i   ( {vdmem_addr_i, vdmem_we_i, vdmem_be_i, vdmem_wdata_i} ),
+                .deq_clk_i    ( clk_i                                               ),
+                .deq_ready_i  ( dmem_gnt_i                                          ),
+                .deq_valid_o  ( dreq_deq_valid                                      ),
+                .deq_data_o   ( dreq_deq                                            )
+            );
+            assign dmem_req_o = dreq_deq_valid;
+            assign {dmem_addr_o, dmem_we_o, dmem_be_o, dmem_wdata_o} = dreq_deq;
+
+            // the memory does not wait for its responses to be accepted,
+            // hence the number of outstanding requests is limited to the
+            // capacity of the response FIFO
+            logic unused_dresp_ready;
+            vproc_cdc_fifo #(
+                .WIDTH        ( MEM_W + 1                       ),
+                .DEPTH        ( FIFO_DEPTH                      )
+            ) dresp_fifo (
+                .rst_ni       ( rst_ni                          ),
+                .enq_clk_i    ( clk_i                           ),
+                .enq_ready_o  ( unused_dresp_ready              ),
+                .enq_valid_i  ( dmem_rvalid_i                   ),
+                .enq_data_i   ( {dmem_err_i, dmem_rdata_i}      ),
+                .deq_clk_i    ( vclk_i                          ),
+                .deq_ready_i  ( 1'b1                            ),
+                .deq_valid_o  ( vdmem_rvalid_o                  ),
+                .deq_data_o   ( {vdmem_err_o, vdmem_rdata_o}    )
+            );
+
+            logic [$clog2(FIFO_DEPTH):0] dmem_out_q;   // outstanding requests
+            always_ff @(posedge vclk_i or negedge rst_ni) begin
+                if (~rst_ni) begin
+                    dmem_out_q <= '0;
+                end else begin
+                    dmem_out_q <= dmem_out_q + {{$clog2(FIFO_DEPTH){1'b0}}, vdmem_gnt_o}
+                                             - {{$clog2(FIFO_DEPTH){1'b0}}, vdmem_rvalid_o};
+                end
+            end
+            assign vdmem_gnt_o = vdmem_req_i & dreq_enq_ready & (dmem_out_q != ($clog2(FIFO_DEPTH)+1)'(FIFO_DEPTH));
+
+
+            ///////////////////////////////////////////////////////////////////
+            // Level signals
+
+            logic [2:0] level_sync_q[2];
+            always_ff @(posedge vclk_i or negedge rst_ni) begin
+                if (~rst_ni) begin
+                    level_sync_q[0] <= '0;
+                    level_sync_q[1] <= '0;
+                end else begin
+                    level_sync_q[0] <= {vsusp_i, dcache_lock_i};
+                    level_sync_q[1] <= level_sync_q[0];
+                end
+            end
+            assign vsusp_o        = level_sync_q[1][2];
+            assign vdcache_lock_o = level_sync_q[1][1:0];
+        end
+    endgenerate
+
+endmodule
@@ -0,0 +1,101 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// Asynchronous FIFO for clock domain crossings: the read and write pointers
+// are exchanged between the two clock domains as Gray code through two-stage
+// synchronizers.  An entry becomes visible on the dequeue side two to three
+// cycles of the dequeue clock after it has been enqueued, and its space is
+// released two to three cycles of the enqueue clock after it has been
+// dequeued.  Both sides are reset asynchronously by rst_ni.
+module vproc_cdc_fifo #(
+        parameter int unsigned   WIDTH = 8,
+        parameter int unsigned   DEPTH = 4    // number of entries (power of two)
+    )(
+        input  logic             rst_ni,
+
+        input  logic             enq_clk_i,
+        output logic             enq_ready_o,
+        input  logic             enq_valid_i,
+        input  logic [WIDTH-1:0] enq_data_i,
+
+        input  logic             deq_clk_i,
+        input  logic             deq_ready_i,
+        output logic             deq_valid_o,
+        output logic [WIDTH-1:0] deq_data_o
+    );
+
+    if (DEPTH < 2 || (DEPTH & (DEPTH - 1)) != 0) begin
+        $fatal(1, "The depth DEPTH of a CDC FIFO must be a power of two and at least 2.  ",
+                  "The current value of %d is invalid.", DEPTH);
+    end
+
+    // the pointers have one additional bit to distinguish a full from an
+    // empty FIFO
+    localparam int unsigned PTR_W = $clog2(DEPTH) + 1;
+
+    function automatic logic [PTR_W-1:0] bin2gray(logic [PTR_W-1:0] bin);
+        return bin ^ (bin >> 1);
+    endfunction
+
+    function automatic logic [PTR_W-1:0] gray2bin(logic [PTR_W-1:0] gray);
+        logic [PTR_W-1:0] bin;
+        bin[PTR_W-1] = gray[PTR_W-1];
+        for (int i = PTR_W - 2; i >= 0; i--) begin
+            bin[i] = bin[i+1] ^ gray[i];
+        end
+        return bin;
+    endfunction
+
+    logic [WIDTH-1:0] data[DEPTH];
+
+    // enqueue side
+    logic [PTR_W-1:0] wr_bin_q, wr_gray_q;
+    logic [PTR_W-1:0] rd_gray_sync_q[2];    // read pointer synchronized to enq_clk_i
+    always_ff @(posedge enq_clk_i or negedge rst_ni) begin
+        if (~rst_ni) begin
+            wr_bin_q          <= '0;
+            wr_gray_q         <= '0;
+            rd_gray_sync_q[0] <= '0;
+            rd_gray_sync_q[1] <= '0;
+        end else begin
+            rd_gray_sync_q[0] <= rd_gray_q;
+            rd_gray_sync_q[1] <= rd_gray_sync_q[0];
+            if (enq_ready_o & enq_valid_i) begin
+                wr_bin_q  <= wr_bin_q + 1;
+                wr_gray_q <= bin2gray(wr_bin_q + 1);
+            end
+        end
+    end
+    always_ff @(posedge enq_clk_i) begin
+        if (enq_ready_o & enq_valid_i) begin
+            data[wr_bin_q[PTR_W-2:0]] <= enq_data_i;
+        end
+    end
+    assign enq_ready_o = (wr_bin_q - gray2bin(rd_gray_sync_q[1])) != PTR_W'(DEPTH);
+
+    // dequeue side
+    logic [PTR_W-1:0] rd_bin_q, rd_gray_q;
+    logic [PTR_W-1:0] wr_gray_sync_q[2];    // write pointer synchronized to deq_clk_i
+    always_ff @(posedge deq_clk_i or negedge rst_ni) begin
+        if (~rst_ni) begin
+            rd_bin_q          <= '0;
+            rd_gray_q         <= '0;
+            wr_gray_sync_q[0] <= '0;
+            wr_gray_sync_q[1] <= '0;
+        end else begin
+            wr_gray_sync_q[0] <= wr_gray_q;
+            wr_gray_sync_q[1] <= wr_gray_sync_q[0];
+            if (deq_ready_i & deq_valid_o) begin
+                rd_bin_q  <= rd_bin_q + 1;
+                rd_gray_q <= bin2gray(rd_bin_q + 1);
+            end
+        end
+    end
+    // an entry is only read once the write pointer that covers it has been
+    // synchronized, hence its content is stable
+    assign deq_valid_o = rd_gray_q != wr_gray_sync_q[1];
+    assign deq_data_o  = data[rd_bin_q[PTR_W-2:0]];
+
+endmodule
@@ -10,6 +10,8 @@ module vproc_core #(
         parameter int unsigned        MUL_OP_W       = 64,   // MUL unit operand width in bits
         parameter int unsigned        SLD_OP_W       = 64,   // SLD unit operand width in bits
         parameter int unsigned        GATHER_OP_W    = 32,   // ELEM unit GATHER operand width in bits
+        parameter int unsigned        AES_OP_W       = 128,  // AES unit operand width in bits
+        parameter bit                 AES_UNIT       = 1'b0, // instantiate the AES unit (Zvkned)
         parameter int unsigned        QUEUE_SZ       = 2,    // instruction queue size
         parameter vproc_pkg::ram_type RAM_TYPE       = vproc_pkg::RAM_GENERIC,
         parameter vproc_pkg::mul_type MUL_TYPE       = vproc_pkg::MUL_GENERIC,
@@ -36,12 +38,21 @@ module vproc_core #(
 
         output logic                  pending_load_o,
         output logic                  pending_store_o,
+        output logic                  queued_load_o,    // pending loads that have not reached the LSU
+        output logic                  queued_store_o,   // pending stores that have not reached the LSU
+
+        output vproc_pkg::core_events perf_events_o,    // performance events
+
+        // vector state modifications (for context switching)
+        output logic [31:0]           dirty_vregs_o,    // vregs written by the instruction being dispatched
+        output logic                  dirty_cfg_o,      // vtype, vl, vxrm, or vxsat written
+        output logic                  pending_disp_o,   // instructions waiting for dispatch
 
         // CSR connections
         output logic [31:0]           csr_vtype_o,
         output logic [31:0]           csr_vl_o,
         output logic [31:0]           csr_vlenb_o,
-        output logic [31:0]           csr_vstart_o,
+        output logic [31:0]           csr_vstart_o,     // progress of the vector load/store in progress
         input  logic [31:0]           csr_vstart_i,
         input  logic                  csr_vstart_set_i,
         output logic [1:0]            csr_vxrm_o,
@@ -72,6 +83,12 @@ module vproc_core #(
 
     localparam int unsigned VMSK_W = VREG_W / 8;   // single register mask size
 
+    // the AES unit processes element groups of 128 bits, which requires
+    // vector registers of at least that width; it reads two vregs, hence the
+    // register file has two additional read ports if it is instantiated
+    localparam bit          AES_EN   = AES_UNIT & (VREG_W >= 128);
+    localparam int unsigned PORTS_RD = AES_EN ? 9 : 7;
+
     // The current vector length (VL) actually counts bytes instead of elements.
     // Also, the vector lenght is actually one more element than what VL suggests;
     // hence, when VSEW = 8, the value in VL is the current length - 1,
@@ -135,7 +152,6 @@ module vproc_core #(
     assign csr_vtype_o  = cfg_valid ? {24'b0, agnostic_q, 1'b0, vsew_q, lmul_q} : 32'h80000000;
     assign csr_vl_o     = {{(32-CFG_VL_W-1){1'b0}}, vl_csr_q};
     assign csr_vlenb_o  = VREG_W / 8;
-    assign csr_vstart_o = '0;
     assign csr_vxrm_o   = vxrm_q;
     assign csr_vxsat_o  = vxsat_q;
 
@@ -207,6 +223,7 @@ module vproc_core #(
     assign dec_buf_ready = ~dec_buf_valid_q | queue_ready;
 
     vproc_decoder #(
+        .AES_EN         ( AES_EN                ),
         .DONT_CARE_ZERO ( DONT_CARE_ZERO        )
     ) dec (
         .instr_i        ( instr_i               ),
@@ -385,12 +402,17 @@ module vproc_core #(
 
     // keep track of pending loads and stores
     logic pending_load_lsu, pending_store_lsu;
-    assign pending_load_o  = (dec_buf_valid_q & (dec_data_q.unit   == UNIT_LSU) & ~dec_data_q.mode.lsu.store  ) |
-                             (queue_valid_q   & (queue_data_q.unit == UNIT_LSU) & ~queue_data_q.mode.lsu.store) |
-                             pending_load_lsu;
-    assign pending_store_o = (dec_buf_valid_q & (dec_data_q.unit   == UNIT_LSU) &  dec_data_q.mode.lsu.store  ) |
-                             (queue_valid_q   & (queue_data_q.unit == UNIT_LSU) &  queue_data_q.mode.lsu.store) |
-                             pending_store_lsu;
+    assign queued_load_o   = (dec_buf_valid_q & (dec_data_q.unit   == UNIT_LSU) & ~dec_data_q.mode.lsu.store  ) |
+                             (queue_valid_q   & (queue_data_q.unit == UNIT_LSU) & ~queue_data_q.mode.lsu.store);
+    assign queued_store_o  = (dec_buf_valid_q & (dec_data_q.unit   == UNIT_LSU) &  dec_data_q.mode.lsu.store  ) |
+                             (queue_valid_q   & (queue_data_q.unit == UNIT_LSU) &  queue_data_q.mode.lsu.store);
+    assign pending_load_o  = queued_load_o  | pending_load_lsu;
+    assign pending_store_o = queued_store_o | pending_store_lsu;
+
+    // vstart reports the progress of the LSU, since memory accesses are the
+    // only vector operations that can be suspended (see vproc_top)
+    logic [31:0] lsu_vstart;
+    assign csr_vstart_o = lsu_vstart;
 
 
     ///////////////////////////////////////////////////////////////////////////
@@ -431,12 +453,14 @@ module vproc_core #(
     logic op_rdy_mul,  op_ack_mul;
     logic op_rdy_sld,  op_ack_sld;
     logic op_rdy_elem, op_ack_elem;
+    logic op_rdy_aes,  op_ack_aes;
     always_comb begin
         op_rdy_lsu  = 1'b0;
         op_rdy_alu  = 1'b0;
         op_rdy_mul  = 1'b0;
         op_rdy_sld  = 1'b0;
         op_rdy_elem = 1'b0;
+        op_rdy_aes  = 1'b0;
         // hold back ready signal until hazards are cleared:
         if (queue_valid_q && ~pending_hazards) begin
             unique case (queue_data_q.unit)
@@ -447,6 +471,7 @@ module vproc_core #(
                 UNIT_MUL:  op_rdy_mul  = queue_data_q.vsew != VSEW_INVALID;
                 UNIT_SLD:  op_rdy_sld  = queue_data_q.vsew != VSEW_INVALID;
                 UNIT_ELEM: op_rdy_elem = queue_data_q.vsew != VSEW_INVALID;
+                UNIT_AES:  op_rdy_aes  = queue_data_q.vsew != VSEW_INVALID;
                 default: ;
             endcase
         end
@@ -459,29 +484,74 @@ module vproc_core #(
             (op_rdy_alu  & op_ack_alu ) |
             (op_rdy_mul  & op_ack_mul ) |
             (op_rdy_sld  & op_ack_sld ) |
-            (op_rdy_elem & op_ack_elem)) begin
+            (op_rdy_elem & op_ack_elem) |
+            (op_rdy_aes  & op_ack_aes )) begin
             op_ack              = 1'b1;
             vreg_rd_hazard_map_set = queue_rd_hazard_q;
             vreg_wr_hazard_map_set = queue_wr_hazard_q;
         end
     end
 
+    // performance events of the dispatcher
+    assign perf_events_o.dispatch_lsu  = op_rdy_lsu  & op_ack_lsu;
+    assign perf_events_o.dispatch_alu  = op_rdy_alu  & op_ack_alu;
+    assign perf_events_o.dispatch_mul  = op_rdy_mul  & op_ack_mul;
+    assign perf_events_o.dispatch_sld  = op_rdy_sld  & op_ack_sld;
+    assign perf_events_o.dispatch_elem = op_rdy_elem & op_ack_elem;
+    assign perf_events_o.dispatch_aes  = op_rdy_aes  & op_ack_aes;
+    assign perf_events_o.stall_hazard  = queue_valid_q &  pending_hazards;
+    assign perf_events_o.stall_unit    = queue_valid_q & ~pending_hazards & ~op_ack;
+    assign perf_events_o.queue_empty   = ~queue_valid_q;
+
+    // Vector state modifications: destination registers are reported when an
+    // instruction is dispatched rather than when it writes back, such that the
+    // reported set is complete once all instructions have been dispatched,
+    // while any pending write is ordered before subsequent reads of the same
+    // register by the hazard logic.
+    assign dirty_vregs_o  = vreg_wr_hazard_map_set;
+    assign dirty_cfg_o    = (dec_valid & (dec_data_d.unit == UNIT_CFG)) | csr_vxrm_set_i | csr_vxsat_set_i;
+    assign pending_disp_o = dec_buf_valid_q | queue_valid_d | queue_valid_q;
+
     // vreg hazard clearing:
     logic [31:0] vreg_rd_hazard_clr_lsu,  vreg_wr_hazard_clr_lsu;
     logic [31:0] vreg_rd_hazard_clr_alu,  vreg_wr_hazard_clr_alu;
     logic [31:0] vreg_rd_hazard_clr_mul,  vreg_wr_hazard_clr_mul;
     logic [31:0] vreg_rd_hazard_clr_sld,  vreg_wr_hazard_clr_sld;
     logic [31:0] vreg_rd_hazard_clr_elem, vreg_wr_hazard_clr_elem;
+    logic [31:0] vreg_rd_hazard_clr_aes,  vreg_wr_hazard_clr_aes;
     assign vreg_rd_hazard_map_clr = vreg_rd_hazard_clr_lsu  |
                                     vreg_rd_hazard_clr_alu  |
                                     vreg_rd_hazard_clr_mul  |
                                     vreg_rd_hazard_clr_sld  |
-                                    vreg_rd_hazard_clr_elem;
+                                    vreg_rd_hazard_clr_elem |
+                                    vreg_rd_hazard_clr_aes;
     assign vreg_wr_hazard_map_clr = vreg_wr_hazard_clr_lsu  |
                                     vreg_wr_hazard_clr_alu  |
                                     vreg_wr_hazard_clr_mul  |
                                     vreg_wr_hazard_clr_sld  |
-                                    vreg_wr_hazard_clr_elem;
+                                    vreg_wr_hazard_clr_elem |
+                                    vreg_wr_hazard_clr_aes;
+
+    // completion events: a unit releases the write hazard of a destination
+    // vector register (i.e., once for each register of a register group), or
+    // the LSU has no more pending stores
+    logic pending_store_lsu_q;
+    always_ff @(posedge clk_i or negedge async_rst_n) begin
+        if (~async_rst_n) begin
+            pending_store_lsu_q <= 1'b0;
+        end
+        else if (~sync_rst_n) begin
+            pending_store_lsu_q <= 1'b0;
+        end else begin
+            pending_store_lsu_q <= pending_store_lsu;
+        end
+    end
+    assign perf_events_o.complete_lsu  = (vreg_wr_hazard_clr_lsu  != '0) | (pending_store_lsu_q & ~pending_store_lsu);
+    assign perf_events_o.complete_alu  =  vreg_wr_hazard_clr_alu  != '0;
+    assign perf_events_o.complete_mul  =  vreg_wr_hazard_clr_mul  != '0;
+    assign perf_events_o.complete_sld  =  vreg_wr_hazard_clr_sld  != '0;
+    assign perf_events_o.complete_elem =  vreg_wr_hazard_clr_elem != '0;
+    assign perf_events_o.complete_aes  =  vreg_wr_hazard_clr_aes  != '0;
 
 
     ///////////////////////////////////////////////////////////////////////////
@@ -492,12 +562,12 @@ module vproc_core #(
     logic [4:0]        vregfile_wr_addr_q[2], vregfile_wr_addr_d[2];
     logic [VREG_W-1:0] vregfile_wr_data_q[2], vregfile_wr_data_d[2];
     logic [VMSK_W-1:0] vregfile_wr_mask_q[2], vregfile_wr_mask_d[2];
-    logic [4:0]        vregfile_rd_addr[7];
-    logic [VREG_W-1:0] vregfile_rd_data[7];
+    logic [4:0]        vregfile_rd_addr[PORTS_RD];
+    logic [VREG_W-1:0] vregfile_rd_data[PORTS_RD];
     vproc_vregfile #(
         .VREG_W       ( VREG_W             ),
         .PORT_W       ( VREG_W             ),
-        .PORTS_RD     ( 7                  ),
+        .PORTS_RD     ( PORTS_RD           ),
         .PORTS_WR     ( 2                  ),
         .RAM_TYPE     ( RAM_TYPE           )
     ) vregfile (
@@ -569,6 +639,7 @@ module vproc_core #(
         .vd_i               ( queue_data_q.rd.addr          ),
         .pending_load_o     ( pending_load_lsu              ),
         .pending_store_o    ( pending_store_lsu             ),
+        .vstart_o           ( lsu_vstart                    ),
         .clear_rd_hazards_o ( vreg_rd_hazard_clr_lsu        ),
         .clear_wr_hazards_o ( vreg_wr_hazard_clr_lsu        ),
         .vreg_mask_i        ( vreg_mask                     ),
@@ -758,6 +829,57 @@ module vproc_core #(
     assign xreg_o       = vl_updated_q ? csr_vl_o : elem_xreg;
 
 
+    // AES unit (not instantiated unless AES_UNIT is set and VREG_W is at least
+    // 128, otherwise the decoder rejects the vector AES instructions and the
+    // read ports 7 and 8 of the register file do not exist)
+    logic [VREG_W-1:0] aes_wr_data;
+    logic [VMSK_W-1:0] aes_wr_mask;
+    logic [4:0]        aes_wr_addr;
+    logic              aes_wr_en;
+    generate
+        if (AES_EN) begin
+            vproc_aes #(
+                .VREG_W             ( VREG_W                   ),
+                .VMSK_W             ( VMSK_W                   ),
+                .CFG_VL_W           ( CFG_VL_W                 ),
+                .AES_OP_W           ( AES_OP_W                 ),
+                .MAX_WR_ATTEMPTS    ( 3                        ),
+                .DONT_CARE_ZERO     ( DONT_CARE_ZERO           )
+            ) aes (
+                .clk_i              ( clk_i                    ),
+                .async_rst_ni       ( async_rst_n              ),
+                .sync_rst_ni        ( sync_rst_n               ),
+                .lmul_i             ( queue_data_q.lmul        ),
+                .vl_i               ( queue_data_q.vl          ),
+                .vl_0_i             ( queue_data_q.vl_0        ),
+                .op_rdy_i           ( op_rdy_aes               ),
+                .op_ack_o           ( op_ack_aes               ),
+                .mode_i             ( queue_data_q.mode.aes    ),
+                .vs2_i              ( queue_data_q.rs2.r.vaddr ),
+                .vd_i               ( queue_data_q.rd.addr     ),
+                .clear_rd_hazards_o ( vreg_rd_hazard_clr_aes   ),
+                .clear_wr_hazards_o ( vreg_wr_hazard_clr_aes   ),
+                .vreg_rd_i          ( vregfile_rd_data[7]      ),
+                .vreg_rd3_i         ( vregfile_rd_data[8]      ),
+                .vreg_rd_addr_o     ( vregfile_rd_addr[7]      ),
+                .vreg_rd3_addr_o    ( vregfile_rd_addr[8]      ),
+                .vreg_wr_o          ( aes_wr_data              ),
+                .vreg_wr_addr_o     ( aes_wr_addr              ),
+                .vreg_wr_mask_o     ( aes_wr_mask              ),
+                .vreg_wr_en_o       ( aes_wr_en                )
+            );
+        end else begin
+            assign op_ack_aes             = 1'b0;
+            assign vreg_rd_hazard_clr_aes = '0;
+            assign vreg_wr_hazard_clr_aes = '0;
+            assign aes_wr_data            = '0;
+            assign aes_wr_addr            = '0;
+            assign aes_wr_mask            = '0;
+            assign aes_wr_en              = 1'b0;
+        end
+    endgenerate
+
+
     // LSU/ALU/ELEM write multiplexer:
     always_comb begin
         vregfile_wr_en_d  [0] = lsu_wr_en | alu_wr_en | elem_wr_en;
@@ -767,12 +889,68 @@ module vproc_core #(
     end
 
 
-    // MUL/SLD write multiplexer:
+    // MUL/SLD/AES write multiplexer:
     always_comb begin
-        vregfile_wr_en_d  [1] = mul_wr_en | sld_wr_en;
-        vregfile_wr_addr_d[1] = mul_wr_en ? mul_wr_addr : sld_wr_addr;
-        vregfile_wr_data_d[1] = mul_wr_en ? mul_wr_data : sld_wr_data;
-        vregfile_wr_mask_d[1] = mul_wr_en ? mul_wr_mask : sld_wr_mask;
+        vregfile_wr_en_d  [1] = mul_wr_en | sld_wr_en | aes_wr_en;
+        vregfile_wr_addr_d[1] = mul_wr_en ? mul_wr_addr : (sld_wr_en ? sld_wr_addr : aes_wr_addr);
+        vregfile_wr_data_d[1] = mul_wr_en ? mul_wr_data : (sld_wr_en ? sld_wr_data : aes_wr_data);
+        vregfile_wr_mask_d[1] = mul_wr_en ? mul_wr_mask : (sld_wr_en ? sld_wr_mask : aes_wr_mask);
+    end
+
+
+`ifdef VPROC_PROFILE
+    ///////////////////////////////////////////////////////////////////////////
+    // PROFILING SIGNALS (simulation only, read by the Verilator harness)
+
+    // Number of elements (vl) and of active elements of masked instructions.
+    // The mask is sampled two cycles after dispatch, since by then any write
+    // to v0 by a preceding instruction has reached the register file, while
+    // subsequent instructions writing v0 are still held back by the read
+    // hazard of the masked instruction.
+    logic              prof_masked_d;
+    logic [CFG_VL_W:0] prof_elems_d;
+    always_comb begin
+        prof_masked_d = 1'b0;
+        unique case (queue_data_q.unit)
+            UNIT_LSU:  prof_masked_d = queue_data_q.mode.lsu.masked;
+            UNIT_ALU:  prof_masked_d = queue_data_q.mode.alu.masked;
+            UNIT_MUL:  prof_masked_d = queue_data_q.mode.mul.masked;
+            UNIT_SLD:  prof_masked_d = queue_data_q.mode.sld.masked;
+            UNIT_ELEM: prof_masked_d = queue_data_q.mode.elem.masked;
+            default: ;
+        endcase
+        prof_masked_d = prof_masked_d & op_ack & ~queue_data_q.vl_0;
+        prof_elems_d  = '0;
+        unique case (queue_data_q.vsew)
+            VSEW_8:  prof_elems_d =  {1'b0, queue_data_q.vl} + 1;
+            VSEW_16: prof_elems_d = ({1'b0, queue_data_q.vl} + 1) >> 1;
+            VSEW_32: prof_elems_d = ({1'b0, queue_data_q.vl} + 1) >> 2;
+            default: ;
+        endcase
+    end
+
+    logic              prof_masked_q[2];
+    logic [CFG_VL_W:0] prof_elems_q [2];
+    always_ff @(posedge clk_i) begin
+        prof_masked_q[0] <= prof_masked_d;
+        prof_elems_q [0] <= prof_elems_d;
+        prof_masked_q[1] <= prof_masked_q[0];
+        prof_elems_q [1] <= prof_elems_q [0];
+    end
+
+    logic              prof_masked /*verilator public*/;
+    logic [CFG_VL_W:0] prof_elems  /*verilator public*/;
+    logic [CFG_VL_W:0] prof_active /*verilator public*/;
+    always_comb begin
+        prof_masked = prof_masked_q[1];
+        prof_elems  = prof_elems_q [1];
+        prof_active = '0;
+        for (int i = 0; i < VREG_W; i++) begin
+            if ((i < prof_elems) & vreg_mask[i]) begin
+                prof_active = prof_active + 1;
+            end
+        end
     end
+`endif
 
 endmodule
@@ -4,7 +4,8 @@
 
 
 module vproc_decoder #(
-        parameter bit                   DONT_CARE_ZERO = 1'b0 // initialize don't care values to zero
+        parameter bit                   AES_EN         = 1'b1, // decode the vector AES instructions (Zvkned)
+        parameter bit                   DONT_CARE_ZERO = 1'b0  // initialize don't care values to zero
     )(
         input  logic                    instr_valid_i,
         input  logic [31:0]             instr_i,
@@ -338,6 +339,16 @@ module vproc_decoder #(
                             mode_o.alu.cmp      = 1'b0;
                             mode_o.alu.masked   = instr_masked;
                         end
+                        {6'b000001, 3'b000},        // vandn VV
+                        {6'b000001, 3'b100}: begin  // vandn VX
+                            unit_o              = UNIT_ALU;
+                            mode_o.alu.opx2.res = ALU_VAND;
+                            mode_o.alu.inv_op1  = 1'b1;
+                            mode_o.alu.inv_op2  = 1'b0;
+                            mode_o.alu.op_mask  = ALU_MASK_NONE;
+                            mode_o.alu.cmp      = 1'b0;
+                            mode_o.alu.masked   = instr_masked;
+                        end
                         {6'b001001, 3'b000},        // vand VV
                         {6'b001001, 3'b011},        // vand VI
                         {6'b001001, 3'b100}: begin  // vand VX
@@ -407,6 +418,30 @@ module vproc_decoder #(
                             mode_o.alu.cmp        = 1'b0;
                             mode_o.alu.masked     = instr_masked;
                         end
+                        {6'b010100, 3'b000},        // vror VV
+                        {6'b010100, 3'b011},        // vror VI (uimm[5] == 0)
+                        {6'b010101, 3'b011},        // vror VI (uimm[5] == 1)
+                        {6'b010100, 3'b100}: begin  // vror VX
+                            unit_o                = UNIT_ALU;
+                            mode_o.alu.opx2.res   = ALU_VSHIFT;
+                            mode_o.alu.opx1.shift = ALU_SHIFT_VROR;
+                            mode_o.alu.inv_op1    = 1'b0;
+                            mode_o.alu.inv_op2    = 1'b0;
+                            mode_o.alu.op_mask    = ALU_MASK_NONE;
+                            mode_o.alu.cmp        = 1'b0;
+                            mode_o.alu.masked     = instr_masked;
+                        end
+                        {6'b010101, 3'b000},        // vrol VV
+                        {6'b010101, 3'b100}: begin  // vrol VX
+                            unit_o                = UNIT_ALU;
+                            mode_o.alu.opx2.res   = ALU_VSHIFT;
+                            mode_o.alu.opx1.shift = ALU_SHIFT_VROR;
+                            mode_o.alu.inv_op1    = 1'b1;  // rotate right by negated amount
+                            mode_o.alu.inv_op2    = 1'b0;
+                            mode_o.alu.op_mask    = ALU_MASK_NONE;
+                            mode_o.alu.cmp        = 1'b0;
+                            mode_o.alu.masked     = instr_masked;
+                        end
                         {6'b101100, 3'b000},        // vnsrl VV
                         {6'b101100, 3'b011},        // vnsrl VI
                         {6'b101100, 3'b100}: begin  // vnsrl VX
@@ -561,9 +596,8 @@ module vproc_decoder #(
                             mode_o.alu.cmp      = 1'b0;
                             mode_o.alu.masked   = 1'b0;
                         end
-                        {6'b010010, 3'b010}: begin  // v[z|s]ext.vf2 VV
+                        {6'b010010, 3'b010}: begin  // VXUNARY0
                             unit_o              = UNIT_ALU;
-                            mode_o.alu.opx2.res = ALU_VSEL;
                             mode_o.alu.opx1.sel = ALU_SEL_MASK;
                             mode_o.alu.inv_op1  = 1'b0;
                             mode_o.alu.inv_op2  = 1'b0;
@@ -572,8 +606,19 @@ module vproc_decoder #(
                             mode_o.alu.masked   = instr_masked;
                             mode_o.alu.sigext   = instr_vs1[0];
                             rs1_o.vreg          = 1'b0;
-                            instr_illegal       = (instr_vs1[4:1] != 4'b0011);
-                            widenarrow_o        = OP_WIDENING;
+                            unique case (instr_vs1)
+                                5'b00110,                               // vzext.vf2
+                                5'b00111: begin                         // vsext.vf2
+                                    mode_o.alu.opx2.res = ALU_VSEL;
+                                    widenarrow_o        = OP_WIDENING;
+                                end
+                                5'b01000: mode_o.alu.opx2.res = ALU_VBREV8; // vbrev8
+                                5'b01001: mode_o.alu.opx2.res = ALU_VREV8;  // vrev8
+                                5'b01100: mode_o.alu.opx2.res = ALU_VCLZ;   // vclz
+                                5'b01101: mode_o.alu.opx2.res = ALU_VCTZ;   // vctz
+                                5'b01110: mode_o.alu.opx2.res = ALU_VCPOP;  // vcpop
+                                default:  instr_illegal       = 1'b1;
+                            endcase
                         end
                         {6'b011000, 3'b010}: begin  // vmandnot VV
                             unit_o              = UNIT_ALU;
@@ -869,6 +914,28 @@ module vproc_decoder #(
 
 
                         // MUL unit:
+                        {6'b001100, 3'b010},        // vclmul VV
+                        {6'b001100, 3'b110}: begin  // vclmul VX
+                            unit_o                = UNIT_MUL;
+                            mode_o.mul.op         = MUL_VCLMUL;
+                            mode_o.mul.rounding   = VXRM_RDN;
+                            mode_o.mul.accsub     = 1'b0;
+                            mode_o.mul.op1_signed = 1'b0;
+                            mode_o.mul.op2_signed = 1'b0;
+                            mode_o.mul.op2_is_vd  = 1'b0;
+                            mode_o.mul.masked     = instr_masked;
+                        end
+                        {6'b001101, 3'b010},        // vclmulh VV
+                        {6'b001101, 3'b110}: begin  // vclmulh VX
+                            unit_o                = UNIT_MUL;
+                            mode_o.mul.op         = MUL_VCLMULH;
+                            mode_o.mul.rounding   = VXRM_RDN;
+                            mode_o.mul.accsub     = 1'b0;
+                            mode_o.mul.op1_signed = 1'b0;
+                            mode_o.mul.op2_signed = 1'b0;
+                            mode_o.mul.op2_is_vd  = 1'b0;
+                            mode_o.mul.masked     = instr_masked;
+                        end
                         {6'b100100, 3'b010},        // vmulhu VV
                         {6'b100100, 3'b110}: begin  // vmulhu VX
                             unit_o                = UNIT_MUL;
@@ -1177,6 +1244,19 @@ module vproc_decoder #(
                                 instr_illegal      = instr_vs1[3:1] != 3'b000;
                                 rs1_o.vreg         = 1'b0;
                                 rs2_o.vreg         = ~instr_vs1[0]; // vid has no source reg
+                            end else begin
+                                unit_o             = UNIT_ELEM;
+                                mode_o.elem.op     = DONT_CARE_ZERO ? opcode_elem'('0) : opcode_elem'('x);
+                                unique case (instr_vs1[1:0])
+                                    2'b01:   mode_o.elem.op = ELEM_VMSBF;   // vmsbf
+                                    2'b10:   mode_o.elem.op = ELEM_VMSOF;   // vmsof
+                                    2'b11:   mode_o.elem.op = ELEM_VMSIF;   // vmsif
+                                    default: instr_illegal  = 1'b1;
+                                endcase
+                                mode_o.elem.xreg   = 1'b0;
+                                mode_o.elem.masked = instr_masked;
+                                instr_illegal      = instr_illegal | (instr_vs1[3:2] != 2'b00);
+                                rs1_o.vreg         = 1'b0;
                             end
                         end
 
@@ -1188,6 +1268,50 @@ module vproc_decoder #(
 
             end
 
+            // OPCODE OP-VE (vector crypto instructions of the Zvkned extension):
+            7'h77: begin
+                unit_o            = UNIT_AES;
+                mode_o.aes.op     = DONT_CARE_ZERO ? opcode_aes'('0) : opcode_aes'('x);
+                mode_o.aes.scalar = 1'b0;
+                mode_o.aes.rnd    = instr_i[18:15];
+
+                rs1_o.vreg    = 1'b0; // vs1 selects the operation
+                rs2_o.vreg    = 1'b1;
+                rs2_o.r.vaddr = instr_vs2;
+                rd_o.vreg     = 1'b1;
+                rd_o.addr     = instr_vd;
+
+                unique case (instr_i[31:26])
+                    6'b101000,              // AES .vv (round keys in vs2)
+                    6'b101001: begin        // AES .vs (round key in element group 0 of vs2)
+                        mode_o.aes.scalar = instr_i[26];
+                        unique case (instr_vs1)
+                            5'b00000: mode_o.aes.op = AES_VAESDM;
+                            5'b00001: mode_o.aes.op = AES_VAESDF;
+                            5'b00010: mode_o.aes.op = AES_VAESEM;
+                            5'b00011: mode_o.aes.op = AES_VAESEF;
+                            5'b00111: begin
+                                mode_o.aes.op = AES_VAESZ;
+                                instr_illegal = ~instr_i[26]; // vaesz only exists as .vs
+                            end
+                            default:  instr_illegal = 1'b1;
+                        endcase
+                    end
+                    6'b100010: begin        // vaeskf1.vi
+                        mode_o.aes.op = AES_VAESKF1;
+                    end
+                    default: begin
+                        instr_illegal = 1'b1;
+                    end
+                endcase
+
+                // the element groups consist of four 32-bit elements and the
+                // instructions are always unmasked
+                if (~AES_EN | (instr_i[14:12] != 3'b010) | instr_masked | (vsew_i != VSEW_32)) begin
+                    instr_illegal = 1'b1;
+                end
+            end
+
             default: begin
                 instr_illegal = 1'b1;
             end
@@ -1257,11 +1381,15 @@ module vproc_decoder #(
         endcase
 
         // special cases (e.g. mask operations):
-        if ((unit_o == UNIT_ALU) & (mode_o.alu.op_mask == ALU_MASK_ARIT)) begin
+        if (((unit_o == UNIT_ALU) & (mode_o.alu.op_mask == ALU_MASK_ARIT)) |
+            ((unit_o == UNIT_ELEM) & ((mode_o.elem.op == ELEM_VMSBF) | (mode_o.elem.op == ELEM_VMSIF) | (mode_o.elem.op == ELEM_VMSOF)))) begin
             vs1_invalid = 1'b0;
             vs2_invalid = 1'b0;
             vd_invalid  = 1'b0;
         end
+        if ((unit_o == UNIT_AES) & mode_o.aes.scalar) begin
+            vs2_invalid = 1'b0; // vs2 of the .vs variants is a single register
+        end
 
         // register addresses are always valid if it is not a vector register:
         if (~rs1_o.vreg) begin
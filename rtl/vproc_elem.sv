@@ -133,6 +133,9 @@ module vproc_elem #(
             ELEM_VRGATHER:  op_reduction = 1'b0;
             ELEM_VCOMPRESS: op_reduction = 1'b0;
             ELEM_FLUSH:     op_reduction = 1'b0;
+            ELEM_VMSBF:     op_reduction = 1'b0;
+            ELEM_VMSIF:     op_reduction = 1'b0;
+            ELEM_VMSOF:     op_reduction = 1'b0;
             ELEM_VREDSUM:   op_reduction = 1'b1;
             ELEM_VREDAND:   op_reduction = 1'b1;
             ELEM_VREDOR:    op_reduction = 1'b1;
@@ -145,6 +148,25 @@ module vproc_elem #(
         endcase
     end
 
+    // mask-producing instructions that are computed for the entire mask vreg
+    // at once (see the mask results below)
+    logic op_mask;
+    assign op_mask = (mode_i.op == ELEM_VMSBF) | (mode_i.op == ELEM_VMSIF) | (mode_i.op == ELEM_VMSOF);
+
+    // a mask result is pending from the vs1 stage until it is written in the
+    // vd stage, during which no further mask-producing instruction is accepted
+    logic mask_res_pend_q, mask_res_pend_d;
+    always_ff @(posedge clk_i or negedge async_rst_ni) begin : vproc_elem_mask_res_pend
+        if (~async_rst_ni) begin
+            mask_res_pend_q <= 1'b0;
+        end
+        else if (~sync_rst_ni) begin
+            mask_res_pend_q <= 1'b0;
+        end else begin
+            mask_res_pend_q <= mask_res_pend_d;
+        end
+    end
+
     logic last_cycle;
     always_comb begin
         last_cycle = DONT_CARE_ZERO ? 1'b0 : 1'bx;
@@ -162,7 +184,7 @@ module vproc_elem #(
         state_busy_d = state_busy_q;
         state_d      = state_q;
 
-        if (((~state_busy_q) | (last_cycle & ~state_q.requires_flush)) & op_rdy_i) begin
+        if (((~state_busy_q) | (last_cycle & ~state_q.requires_flush)) & op_rdy_i & ~(op_mask & mask_res_pend_q)) begin
             op_ack_o               = 1'b1;
             state_d.count.val      = '0;
             state_d.count.val[1:0] = DONT_CARE_ZERO ? '0 : 'x;
@@ -189,6 +211,23 @@ module vproc_elem #(
                 LMUL_8: state_d.emul = EMUL_8;
                 default: ;
             endcase
+            // instructions returning a scalar and mask-producing instructions
+            // compute their result at once (see XREG write-back and mask
+            // results below), hence they finish early; except for vmv.x.s they
+            // take a second cycle such that the vreg read port is free for
+            // fetching the mask vreg in the cycle following the first one
+            if (mode_i.xreg | op_mask) begin
+                state_d.emul           = EMUL_1;
+                state_d.count.part.low = '1;
+                if (mode_i.op != ELEM_XMV) begin
+                    unique case (vsew_i)
+                        VSEW_8:  state_d.count.part.low[0] = 1'b0;
+                        VSEW_16: state_d.count.part.low[1] = 1'b0;
+                        VSEW_32: state_d.count.part.low[2] = 1'b0;
+                        default: ;
+                    endcase
+                end
+            end
             state_d.vl             = vl_i;
             state_d.vl_0           = vl_0_i;
             state_d.vl_mask        = ~vl_0_i;
@@ -587,9 +626,118 @@ module vproc_elem #(
         end
     end
 
-    // XREG write-back
-    assign xreg_valid_o = state_res_busy_q & state_res_q.mode.xreg & ((state_res_q.mode.op == ELEM_XMV) ? state_res_q.first_cycle : state_res_q.last_cycle);
-    assign xreg_o       = result_q;
+    // active elements of the source mask vreg of vpopc, vfirst, vmsbf, vmsif,
+    // and vmsof in the first cycle of the vs1 stage, where the entire mask vreg
+    // is in the vreg read register (body elements that are not masked off)
+    logic [VREG_W-1:0] vsm_act, vsm_msk;
+    always_comb begin
+        logic [CFG_VL_W-1:0] vl_last;   // index of the last body element
+        vl_last = DONT_CARE_ZERO ? '0 : 'x;
+        unique case (state_vs1_q.eew)
+            VSEW_8:  vl_last = state_vs1_q.vl;
+            VSEW_16: vl_last = state_vs1_q.vl >> 1;
+            VSEW_32: vl_last = state_vs1_q.vl >> 2;
+            default: ;
+        endcase
+        for (int i = 0; i < VREG_W; i++) begin
+            vsm_act[i] = ~state_vs1_q.vl_0 & (i <= vl_last) & (~state_vs1_q.mode.masked | vreg_mask_i[i]);
+        end
+        vsm_msk = vreg_rd_q & vsm_act;
+    end
+
+    // XREG write-back: the result of vmv.x.s, vpopc, and vfirst is computed
+    // directly from the source vreg in the first cycle of the vs1 stage, where
+    // element 0 is at the bottom of the vs1 shift register; the set bits of
+    // all active elements are counted or searched at once rather than one
+    // element per cycle
+    logic              xreg_valid_q, xreg_valid_d;
+    logic [31:0]       xreg_q,       xreg_d;
+    always_ff @(posedge clk_i or negedge async_rst_ni) begin : vproc_elem_xreg_valid
+        if (~async_rst_ni) begin
+            xreg_valid_q <= 1'b0;
+        end
+        else if (~sync_rst_ni) begin
+            xreg_valid_q <= 1'b0;
+        end else begin
+            xreg_valid_q <= xreg_valid_d;
+        end
+    end
+    always_ff @(posedge clk_i) begin : vproc_elem_xreg
+        xreg_q <= xreg_d;
+    end
+    always_comb begin
+        xreg_valid_d = state_vs1_busy_q & state_vs1_q.first_cycle & state_vs1_q.mode.xreg;
+        xreg_d       = DONT_CARE_ZERO ? '0 : 'x;
+        unique case (state_vs1_q.mode.op)
+            ELEM_XMV: begin
+                unique case (state_vs1_q.eew)
+                    VSEW_8:  xreg_d = {{24{vs1_shift_q[7 ]}}, vs1_shift_q[7 :0]};
+                    VSEW_16: xreg_d = {{16{vs1_shift_q[15]}}, vs1_shift_q[15:0]};
+                    VSEW_32: xreg_d =                         vs1_shift_q[31:0] ;
+                    default: ;
+                endcase
+            end
+            ELEM_VPOPC: begin
+                xreg_d = '0;
+                for (int i = 0; i < VREG_W; i++) begin
+                    xreg_d = xreg_d + {31'b0, vsm_msk[i]};
+                end
+            end
+            ELEM_VFIRST: begin
+                xreg_d = '1;
+                for (int i = VREG_W - 1; i >= 0; i--) begin
+                    if (vsm_msk[i]) begin
+                        xreg_d = i;
+                    end
+                end
+            end
+            default: ;
+        endcase
+    end
+    assign xreg_valid_o = xreg_valid_q;
+    assign xreg_o       = xreg_q;
+
+    // Mask results: vmsbf, vmsif, and vmsof are likewise computed for the
+    // entire mask vreg in the first cycle of the vs1 stage; the result is
+    // held until the instruction reaches the vd stage, where it is written
+    // instead of the content of the result shift register; inactive and tail
+    // elements are set to 1 (as for compare instructions)
+    logic [VREG_W-1:0] mask_res_q, mask_res_d;
+    logic              mask_res_en, mask_res_wr;
+    always_ff @(posedge clk_i) begin : vproc_elem_mask_res
+        if (mask_res_en) begin
+            mask_res_q <= mask_res_d;
+        end
+    end
+    always_comb begin
+        logic found;    // an active set bit has been found
+        found      = 1'b0;
+        mask_res_d = '1;
+        for (int i = 0; i < VREG_W; i++) begin
+            if (vsm_act[i]) begin
+                unique case (state_vs1_q.mode.op)
+                    ELEM_VMSBF: mask_res_d[i] = ~found & ~vsm_msk[i];
+                    ELEM_VMSIF: mask_res_d[i] = ~found;
+                    ELEM_VMSOF: mask_res_d[i] = ~found &  vsm_msk[i];
+                    default: ;
+                endcase
+            end
+            found = found | vsm_msk[i];
+        end
+    end
+    assign mask_res_en = state_vs1_busy_q & state_vs1_q.first_cycle &
+                         ((state_vs1_q.mode.op == ELEM_VMSBF) | (state_vs1_q.mode.op == ELEM_VMSIF) | (state_vs1_q.mode.op == ELEM_VMSOF));
+    assign mask_res_wr = state_vd_busy_q & state_vd_q.first_cycle &
+                         ((state_vd_q.mode.op == ELEM_VMSBF) | (state_vd_q.mode.op == ELEM_VMSIF) | (state_vd_q.mode.op == ELEM_VMSOF));
+    always_comb begin
+        mask_res_pend_d = mask_res_pend_q;
+        if (mask_res_wr) begin
+            mask_res_pend_d = 1'b0;
+        end
+        if (op_ack_o & op_mask) begin
+            mask_res_pend_d = 1'b1;
+        end
+    end
 
     //
     always_comb begin
@@ -623,10 +771,10 @@ module vproc_elem #(
     assign vd_store_d = ~state_res_q.mode.xreg & (count_store_d.part.low == '1);
 
     //
-    assign vreg_wr_en_d    = state_vd_busy_q & state_vd_q.vd_store;
-    assign vreg_wr_addr_d  = state_vd_q.vd | {2'b0, state_vd_q.count_store.part.mul[2:0]};
-    assign vreg_wr_mask_d  = vreg_wr_en_o ? vdmsk_shift_q : '0;
-    assign vreg_wr_d       = vd_shift_q;
+    assign vreg_wr_en_d    = (state_vd_busy_q & state_vd_q.vd_store) | mask_res_wr;
+    assign vreg_wr_addr_d  = mask_res_wr ? state_vd_q.vd : (state_vd_q.vd | {2'b0, state_vd_q.count_store.part.mul[2:0]});
+    assign vreg_wr_mask_d  = vreg_wr_en_o ? (mask_res_wr ? '1 : vdmsk_shift_q) : '0;
+    assign vreg_wr_d       = mask_res_wr ? mask_res_q : vd_shift_q;
     assign vreg_wr_clear_d = state_vd_busy_q & state_vd_q.last_cycle & ~state_vd_q.requires_flush & ~state_vd_q.mode.xreg;
     assign vreg_wr_base_d  = state_vd_q.vd;
     assign vreg_wr_emul_d  = state_vd_q.emul;
@@ -710,6 +858,14 @@ module vproc_elem #(
                 result_mask_d  = state_ex_q.vl_mask & v0msk;
                 result_valid_d = state_ex_q.count_gather == '1;
             end
+            // vmsbf, vmsif, and vmsof produce no element results, their
+            // result is computed for the whole mask vreg at once
+            ELEM_VMSBF,
+            ELEM_VMSIF,
+            ELEM_VMSOF: begin
+                result_mask_d  = 1'b0;
+                result_valid_d = 1'b0;
+            end
             // flush the destination register after a vcompress or reduction
             // (note that a flush might potentially write to more registers
             // than are part of the vreg group, but for these the write mask
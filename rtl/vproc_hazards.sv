@@ -235,6 +235,19 @@ module vproc_hazards #(
                 if (mode_i.elem.xreg) begin
                     wr_hazards_o = '0;
                 end
+                if ((mode_i.elem.op == ELEM_VMSBF) | (mode_i.elem.op == ELEM_VMSIF) | (mode_i.elem.op == ELEM_VMSOF)) begin
+                    wr_hazards_o = rd_i.vreg ? (32'h1 << rd_i.addr) : 32'b0;
+                end
+            end
+            UNIT_AES: begin
+                // the .vs variants only read element group 0 of vs2; all
+                // instructions except vaeskf1 read the state from vd
+                if (mode_i.aes.scalar) begin
+                    rd_hazards_o = rs2_i.vreg ? (32'h1 << rs2_i.r.vaddr) : 32'b0;
+                end
+                if (mode_i.aes.op != AES_VAESKF1) begin
+                    rd_hazards_o |= vd_hazards;
+                end
             end
             default: ;
         endcase
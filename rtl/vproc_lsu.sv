@@ -37,6 +37,7 @@ module vproc_lsu #(
 
         output logic                  pending_load_o,
         output logic                  pending_store_o,
+        output logic [31:0]           vstart_o,         // index of the next element to be requested
 
         output logic [31:0]           clear_rd_hazards_o,
         output logic [31:0]           clear_wr_hazards_o,
@@ -374,6 +375,29 @@ module vproc_lsu #(
                              (state_vs3_busy_q  &  state_vs3_q.mode.store ) |
                              (state_req_busy_q  &  state_req_q.mode.store );
 
+    // index of the next element of the current load or store for which a
+    // memory request is issued; all requests for the preceding elements have
+    // been granted (in case of unit-stride accesses, the first element of the
+    // next VMEM_W-bit word); the pipeline advances in lockstep, hence if the
+    // request stage is idle no request of the current instruction has been
+    // issued yet
+    logic [LSU_COUNTER_W-1:0] req_byte;
+    always_comb begin
+        req_byte = state_req_q.count.val;
+        if (state_req_q.mode.stride == LSU_UNITSTRIDE) begin
+            req_byte[LSU_STRI_COUNTER_EXT_W-1:0] = '0;
+        end
+        vstart_o = '0;
+        if (state_req_busy_q) begin
+            unique case (state_req_q.mode.eew)
+                VSEW_8:  vstart_o = 32'(req_byte);
+                VSEW_16: vstart_o = 32'(req_byte >> 1);
+                VSEW_32: vstart_o = 32'(req_byte >> 2);
+                default: ;
+            endcase
+        end
+    end
+
     // common vreg read register:
     logic [VREG_W-1:0] vreg_rd_q, vreg_rd_d;
 
@@ -626,14 +626,18 @@ module vproc_mul #(
             MUL_VMULH: mul_accflag = 1'b0;
             MUL_VSMUL: mul_accflag = 1'b1;
             MUL_VMACC: mul_accflag = 1'b1;
+            MUL_VCLMUL,
+            MUL_VCLMULH: mul_accflag = 1'b0;
             default: ;
         endcase
     end
     assign mul_accsub = state_ex2_q.mode.accsub;
     assign mul_round  = (state_ex2_q.mode.rounding == VXRM_RNU) | (state_ex2_q.mode.rounding == VXRM_RNE);
 
-    // perform signed multiplication of 17-bit integers and add 16-bit accumulator values
+    // perform signed multiplication of 17-bit integers and add 16-bit accumulator values;
+    // the blocks also compute the carry-less products of the lower 16 bits
     logic [(MUL_OP_W/8)*33-1:0] mul_res;
+    logic [(MUL_OP_W/8)*31-1:0] clmul_res;
     genvar g;
     generate
         for (g = 0; g < MUL_OP_W / 8; g++) begin
@@ -651,7 +655,8 @@ module vproc_mul #(
                 .acc_i        ( mul_acc    [16*g +: 16] ),
                 .acc_flag_i   ( mul_accflag             ),
                 .acc_sub_i    ( mul_accsub              ),
-                .res_o        ( mul_res    [33*g +: 33] )
+                .res_o        ( mul_res    [33*g +: 33] ),
+                .clmul_res_o  ( clmul_res  [31*g +: 31] )
             );
         end
     endgenerate
@@ -667,6 +672,18 @@ module vproc_mul #(
         end
     end
 
+    // carry-less result for 32-bit mode; the partial products are arranged
+    // as for res32, but combined with XOR instead of addition
+    logic [MUL_OP_W*2-1:0] clres32;
+    always_comb begin
+        for (int i = 0; i < MUL_OP_W / 32; i++) begin
+            clres32[64*i +: 64] = {33'b0, clmul_res[124*i    +: 31]       } ^
+                                  {17'b0, clmul_res[124*i+31 +: 31], 16'b0} ^
+                                  {17'b0, clmul_res[124*i+93 +: 31], 16'b0} ^
+                                  {1'b0 , clmul_res[124*i+62 +: 31], 32'b0};
+        end
+    end
+
     // compose result
     always_comb begin
         result_d = DONT_CARE_ZERO ? '0 : 'x;
@@ -730,6 +747,46 @@ module vproc_mul #(
                 endcase
             end
 
+            // carry-less multiplication retaining low part (operands are
+            // zero-extended, hence the 8-bit and 16-bit products are
+            // computed by a single block)
+            MUL_VCLMUL: begin
+                unique case (state_ex3_q.eew)
+                    VSEW_8: begin
+                        for (int i = 0; i < (MUL_OP_W / 8 ); i++)
+                            result_d[8 *i +: 8 ] = clmul_res[31*i    +: 8 ];
+                    end
+                    VSEW_16: begin
+                        for (int i = 0; i < (MUL_OP_W / 16); i++)
+                            result_d[16*i +: 16] = clmul_res[62*i    +: 16];
+                    end
+                    VSEW_32: begin
+                        for (int i = 0; i < (MUL_OP_W / 32); i++)
+                            result_d[32*i +: 32] = clres32  [64*i    +: 32];
+                    end
+                    default: ;
+                endcase
+            end
+
+            // carry-less multiplication retaining high part
+            MUL_VCLMULH: begin
+                unique case (state_ex3_q.eew)
+                    VSEW_8: begin
+                        for (int i = 0; i < (MUL_OP_W / 8 ); i++)
+                            result_d[8 *i +: 8 ] = {1'b0, clmul_res[31*i+8  +: 7 ]};
+                    end
+                    VSEW_16: begin
+                        for (int i = 0; i < (MUL_OP_W / 16); i++)
+                            result_d[16*i +: 16] = {1'b0, clmul_res[62*i+16 +: 15]};
+                    end
+                    VSEW_32: begin
+                        for (int i = 0; i < (MUL_OP_W / 32); i++)
+                            result_d[32*i +: 32] = clres32  [64*i+32 +: 32];
+                    end
+                    default: ;
+                endcase
+            end
+
             default: ;
 
         endcase
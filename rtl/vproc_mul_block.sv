@@ -21,7 +21,11 @@ module vproc_mul_block #(
         input  logic                  acc_flag_i, // use accumulator (otherwise it is replaced with 0)
         input  logic                  acc_sub_i,  // subtract multiplication result from accumulator instead of adding
 
-        output logic [32:0] res_o
+        output logic [32:0] res_o,
+
+        // carry-less product of the lower 16 bits of the operands, which has
+        // the same latency as res_o
+        output logic [30:0] clmul_res_o
     );
 
     generate
@@ -164,4 +168,54 @@ module vproc_mul_block #(
         endcase
     endgenerate
 
+    // The carry-less product is computed in fabric logic for all multiplier
+    // types, since the XOR of the partial products cannot be mapped to the
+    // adder tree of the multiplier.  It is buffered like the regular product.
+    logic [15:0] clmul_op1_q, clmul_op2_q;
+    logic [30:0] clmul_mul_q, clmul_mul_d;
+    logic [30:0] clmul_res_q;
+    generate
+        if (BUF_OPS) begin
+            always_ff @(posedge clk_i) begin
+                clmul_op1_q <= op1_i[15:0];
+                clmul_op2_q <= op2_i[15:0];
+            end
+        end else begin
+            always_comb begin
+                clmul_op1_q = op1_i[15:0];
+                clmul_op2_q = op2_i[15:0];
+            end
+        end
+
+        if (BUF_MUL) begin
+            always_ff @(posedge clk_i) begin
+                clmul_mul_q <= clmul_mul_d;
+            end
+        end else begin
+            always_comb begin
+                clmul_mul_q = clmul_mul_d;
+            end
+        end
+
+        if (BUF_RES) begin
+            always_ff @(posedge clk_i) begin
+                clmul_res_q <= clmul_mul_q;
+            end
+        end else begin
+            always_comb begin
+                clmul_res_q = clmul_mul_q;
+            end
+        end
+    endgenerate
+
+    always_comb begin
+        clmul_mul_d = '0;
+        for (int i = 0; i < 16; i++) begin
+            if (clmul_op2_q[i]) begin
+                clmul_mul_d = clmul_mul_d ^ ({15'b0, clmul_op1_q} << i);
+            end
+        end
+    end
+    assign clmul_res_o = clmul_res_q;
+
 endmodule
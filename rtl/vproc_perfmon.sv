@@ -0,0 +1,82 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// Performance monitor: CNT_NUM 64-bit counters, each of which increments in
+// every cycle by the largest number of occurrences among the events selected
+// by its event selector (a bit mask over the EVT_NUM event inputs), i.e., by
+// one if at least one of them is asserted when each event occurs at most once
+// per cycle (events that cross from a faster clock domain may occur several
+// times).  Counters and selectors are written through separate write enables
+// for the lower and upper half of the counters and for the selectors, matching
+// the layout of the mhpmcounter, mhpmcounterh, and mhpmevent CSRs.
+module vproc_perfmon #(
+        parameter int unsigned       CNT_NUM   = 4,   // number of counters
+        parameter int unsigned       EVT_NUM   = 32,  // number of events (at most 32)
+        parameter int unsigned       EVT_CNT_W = 1    // width of the event counts
+    )(
+        input  logic                 clk_i,
+        input  logic                 rst_ni,
+
+        input  logic [EVT_NUM-1:0][EVT_CNT_W-1:0] events_i, // occurrences of each event
+
+        input  logic                 cnt_we_i   [CNT_NUM], // write lower 32 bits of counter
+        input  logic                 cnth_we_i  [CNT_NUM], // write upper 32 bits of counter
+        input  logic                 sel_we_i   [CNT_NUM], // write event selector
+        input  logic [31:0]          wdata_i    [CNT_NUM],
+        output logic [63:0]          cnt_o      [CNT_NUM],
+        output logic [EVT_NUM-1:0]   sel_o      [CNT_NUM]
+    );
+
+    if (EVT_NUM == 0 || EVT_NUM > 32) begin
+        $fatal(1, "The number of performance events EVT_NUM must be between 1 and 32.  ",
+                  "The current value of %d is invalid.", EVT_NUM);
+    end
+
+    logic [63:0]        cnt_q[CNT_NUM];
+    logic [EVT_NUM-1:0] sel_q[CNT_NUM];
+
+    // increment of each counter
+    logic [EVT_CNT_W-1:0] cnt_inc[CNT_NUM];
+    always_comb begin
+        for (int i = 0; i < CNT_NUM; i++) begin
+            cnt_inc[i] = '0;
+            for (int j = 0; j < EVT_NUM; j++) begin
+                if (sel_q[i][j] & (events_i[j] > cnt_inc[i])) begin
+                    cnt_inc[i] = events_i[j];
+                end
+            end
+        end
+    end
+
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (~rst_ni) begin
+            for (int i = 0; i < CNT_NUM; i++) begin
+                cnt_q[i] <= '0;
+                sel_q[i] <= '0;
+            end
+        end else begin
+            for (int i = 0; i < CNT_NUM; i++) begin
+                // a CSR write takes precedence over the increment in the same
+                // cycle (as for the mhpmcounters of Ibex)
+                if (cnt_we_i[i]) begin
+                    cnt_q[i][31:0]  <= wdata_i[i];
+                end
+                else if (cnth_we_i[i]) begin
+                    cnt_q[i][63:32] <= wdata_i[i];
+                end
+                else begin
+                    cnt_q[i] <= cnt_q[i] + 64'(cnt_inc[i]);
+                end
+                if (sel_we_i[i]) begin
+                    sel_q[i] <= wdata_i[i][EVT_NUM-1:0];
+                end
+            end
+        end
+    end
+
+    assign cnt_o = cnt_q;
+    assign sel_o = sel_q;
+
+endmodule
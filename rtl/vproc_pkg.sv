@@ -64,6 +64,7 @@ typedef enum logic [2:0] {
     UNIT_MUL,
     UNIT_SLD,
     UNIT_ELEM,
+    UNIT_AES,
     // pseudo-units (used for instructions that require no unit):
     UNIT_CFG
 } op_unit;
@@ -81,7 +82,7 @@ typedef struct packed {
     cfg_vsew    eew;
     logic       sigext;
 `ifdef VPROC_OP_MODE_UNION
-    logic [4:0] unused;
+    logic [5:0] unused;
 `endif
 } op_mode_lsu;
 
@@ -95,10 +96,11 @@ typedef enum logic [1:0] {
 typedef enum logic [1:0] {
     ALU_SHIFT_VSLL,
     ALU_SHIFT_VSRL,
-    ALU_SHIFT_VSRA
+    ALU_SHIFT_VSRA,
+    ALU_SHIFT_VROR  // rotate right (rotate left if operand 1 is inverted)
 } opcode_alu_shift;
 
-typedef enum logic [2:0] {
+typedef enum logic [3:0] {
     ALU_VADD,
     ALU_VAADD,
     ALU_VAND,
@@ -106,10 +108,15 @@ typedef enum logic [2:0] {
     ALU_VXOR,
     ALU_VSHIFT,
     ALU_VSEL,
-    ALU_VSELN
+    ALU_VSELN,
+    ALU_VBREV8,     // reverse the bits in each byte of operand 2
+    ALU_VREV8,      // reverse the bytes in each element of operand 2
+    ALU_VCLZ,       // count leading zeroes of operand 2
+    ALU_VCTZ,       // count trailing zeroes of operand 2
+    ALU_VCPOP       // count set bits of operand 2
 } opcode_alu_res;
 
-typedef enum logic [2:0] {
+typedef enum logic [3:0] {
     ALU_CMP_CMP,
     ALU_CMP_CMPN,
     ALU_CMP_EQ,
@@ -142,11 +149,13 @@ typedef struct packed {
     logic           sigext;
 } op_mode_alu;
 
-typedef enum logic [1:0] {
+typedef enum logic [2:0] {
     MUL_VMUL,   // regular multiplication
     MUL_VMULH,  // multiplication retaining high part
     MUL_VSMUL,  // multiplication with rounding and saturation
-    MUL_VMACC   // multiply-accumulate
+    MUL_VMACC,  // multiply-accumulate
+    MUL_VCLMUL, // carry-less multiplication retaining low part
+    MUL_VCLMULH // carry-less multiplication retaining high part
 } opcode_mul;
 
 typedef struct packed {
@@ -173,11 +182,11 @@ typedef struct packed {
     logic       masked;
     opcode_sld  op;
 `ifdef VPROC_OP_MODE_UNION
-    logic [8:0] unused;
+    logic [9:0] unused;
 `endif
 } op_mode_sld;
 
-typedef enum logic [3:0] {
+typedef enum logic [4:0] {
     ELEM_XMV,
     ELEM_VPOPC,
     ELEM_VFIRST,
@@ -193,7 +202,10 @@ typedef enum logic [3:0] {
     ELEM_VREDMINU,
     ELEM_VREDMIN,
     ELEM_VREDMAXU,
-    ELEM_VREDMAX
+    ELEM_VREDMAX,
+    ELEM_VMSBF,
+    ELEM_VMSIF,
+    ELEM_VMSOF
 } opcode_elem;
 
 typedef struct packed {
@@ -212,13 +224,31 @@ typedef struct packed {
     logic       vlmax;
     logic       keep_vl;
 `ifdef VPROC_OP_MODE_UNION
-    logic [2:0] unused;
+    logic [3:0] unused;
 `endif
 } op_mode_cfg;
 
+typedef enum logic [2:0] {
+    AES_VAESEF,     // final encryption round
+    AES_VAESEM,     // middle encryption round
+    AES_VAESDF,     // final decryption round
+    AES_VAESDM,     // middle decryption round
+    AES_VAESZ,      // round zero (round key addition only)
+    AES_VAESKF1     // AES-128 forward key schedule round
+} opcode_aes;
+
+typedef struct packed {
+    opcode_aes  op;
+    logic       scalar;     // round key is element group 0 of vs2 (.vs variant)
+    logic [3:0] rnd;        // round number of vaeskf1 (1 to 10)
+`ifdef VPROC_OP_MODE_UNION
+    logic [4:0] unused;
+`endif
+} op_mode_aes;
+
 `ifdef VPROC_OP_MODE_UNION
 typedef union packed {
-    logic [11:0]  unused;
+    logic [12:0]  unused;
 `else
 typedef struct packed {
 `endif
@@ -227,6 +257,7 @@ typedef struct packed {
     op_mode_mul  mul;
     op_mode_sld  sld;
     op_mode_elem elem;
+    op_mode_aes  aes;
     op_mode_cfg  cfg;
 } op_mode;
 
@@ -290,4 +321,24 @@ typedef struct packed {
     logic       shift;
 } store_info;
 
+// performance events of the vector core (each asserted for one cycle per
+// event or during each cycle of a condition, see vproc_perfmon)
+typedef struct packed {
+    logic dispatch_lsu;     // instruction dispatched to the LSU
+    logic dispatch_alu;     // instruction dispatched to the ALU
+    logic dispatch_mul;     // instruction dispatched to the MUL unit
+    logic dispatch_sld;     // instruction dispatched to the SLD unit
+    logic dispatch_elem;    // instruction dispatched to the ELEM unit
+    logic dispatch_aes;     // instruction dispatched to the AES unit
+    logic stall_hazard;     // next instruction waits for vector register hazards
+    logic stall_unit;       // next instruction waits for its unit to be ready
+    logic queue_empty;      // no instruction waiting for dispatch
+    logic complete_lsu;     // LSU completed a load or store
+    logic complete_alu;     // ALU wrote back the result of an instruction
+    logic complete_mul;     // MUL unit wrote back the result of an instruction
+    logic complete_sld;     // SLD unit wrote back the result of an instruction
+    logic complete_elem;    // ELEM unit wrote back the result of an instruction
+    logic complete_aes;     // AES unit wrote back the result of an instruction
+} core_events;
+
 endpackage
@@ -4,19 +4,28 @@
 
 
 module vproc_top #(
-        parameter int unsigned        MEM_W         = 32,  // memory bus width in bits
-        parameter                     MAIN_CORE     = "",
-        parameter int unsigned        VREG_W        = 128, // vector register width in bits
-        parameter int unsigned        VMEM_W        = 32,  // vector memory interface width in bits
-        parameter int unsigned        VMUL_W        = 64,  // MUL unit operand width in bits
-        parameter vproc_pkg::ram_type RAM_TYPE      = vproc_pkg::RAM_GENERIC,
-        parameter vproc_pkg::mul_type MUL_TYPE      = vproc_pkg::MUL_GENERIC,
-        parameter int unsigned        ICACHE_SZ     = 0,   // instruction cache size in bytes
-        parameter int unsigned        ICACHE_LINE_W = 128, // instruction cache line width in bits
-        parameter int unsigned        DCACHE_SZ     = 0,   // data cache size in bytes
-        parameter int unsigned        DCACHE_LINE_W = 512  // data cache line width in bits
+        parameter int unsigned        MEM_W           = 32,  // memory bus width in bits
+        parameter                     MAIN_CORE       = "",
+        parameter int unsigned        VREG_W          = 128, // vector register width in bits
+        parameter int unsigned        VMEM_W          = 32,  // vector memory interface width in bits
+        parameter int unsigned        VMUL_W          = 64,  // MUL unit operand width in bits
+        parameter vproc_pkg::ram_type RAM_TYPE        = vproc_pkg::RAM_GENERIC,
+        parameter vproc_pkg::mul_type MUL_TYPE        = vproc_pkg::MUL_GENERIC,
+        parameter int unsigned        ICACHE_SZ       = 0,   // instruction cache size in bytes
+        parameter int unsigned        ICACHE_LINE_W   = 128, // instruction cache line width in bits
+        parameter int unsigned        DCACHE_SZ       = 0,   // data cache size in bytes
+        parameter int unsigned        DCACHE_LINE_W   = 512, // data cache line width in bits
+        parameter int unsigned        DCACHE_SECTOR_W = DCACHE_LINE_W, // data cache sector width in bits
+        parameter                     MEM_ARB         = "FIXED", // memory arbitration policy (see below)
+        parameter int unsigned        MEM_ARB_IWEIGHT = 1,   // instruction weight or TDMA slot length
+        parameter int unsigned        MEM_ARB_DWEIGHT = 1,   // data weight or TDMA slot length
+        parameter bit                 AES_UNIT        = 1'b0, // vector AES unit (see below)
+        parameter int unsigned        PERF_CNT_NUM    = 4,   // number of performance counters
+        parameter int unsigned        TRACE_BUF_LEN   = 0,   // trace buffer size (entries, 0 disables it)
+        parameter bit                 VCLK_ASYNC      = 1'b0 // vector unit clocked by vclk_i (see below)
     )(
         input  logic               clk_i,
+        input  logic               vclk_i,         // vector unit clock (unused unless VCLK_ASYNC is set)
         input  logic               rst_ni,
 
         output logic               mem_req_o,
@@ -26,7 +35,16 @@ module vproc_top #(
         output logic [MEM_W  -1:0] mem_wdata_o,
         input  logic               mem_rvalid_i,
         input  logic               mem_err_i,
-        input  logic [MEM_W  -1:0] mem_rdata_i
+        input  logic [MEM_W  -1:0] mem_rdata_i,
+
+        input  logic [14:0]        irq_fast_i,     // fast local interrupts of the main core
+
+        // trace buffer interface (see vproc_tracebuf, unused if TRACE_BUF_LEN is 0)
+        input  logic               trace_ctl_we_i, // write trace control (same as CSR trace_ctl)
+        input  logic [1:0]         trace_ctl_i,
+        output logic [31:0]        trace_stat_o,   // trace status (same as CSR trace_stat)
+        input  logic               trace_rd_i,     // remove the oldest entry
+        output logic [31:0]        trace_rdata_o   // oldest entry
     );
 
     if ((MEM_W & (MEM_W - 1)) != 0 || MEM_W < 32) begin
@@ -34,10 +52,36 @@ module vproc_top #(
                   "The current value of %d is invalid.", MEM_W);
     end
 
+    if (MEM_ARB != "FIXED" && MEM_ARB != "RR" && MEM_ARB != "WEIGHTED" && MEM_ARB != "TDMA") begin
+        $fatal(1, "The memory arbitration policy MEM_ARB must be either \"FIXED\", \"RR\", ",
+                  "\"WEIGHTED\", or \"TDMA\".  The current value of \"%s\" is invalid.", MEM_ARB);
+    end
+    if (PERF_CNT_NUM > 29) begin
+        $fatal(1, "The number of performance counters PERF_CNT_NUM must be at most 29.  ",
+                  "The current value of %d is invalid.", PERF_CNT_NUM);
+    end
+    if (TRACE_BUF_LEN != 0 && (TRACE_BUF_LEN & (TRACE_BUF_LEN - 1)) != 0) begin
+        $fatal(1, "The trace buffer size TRACE_BUF_LEN must be either 0 or a power of two.  ",
+                  "The current value of %d is invalid.", TRACE_BUF_LEN);
+    end
+
+    if (MEM_ARB_IWEIGHT == 0 || MEM_ARB_DWEIGHT == 0) begin
+        $fatal(1, "The memory arbitration weights MEM_ARB_IWEIGHT and MEM_ARB_DWEIGHT must be at ",
+                  "least 1.  The current values are %d and %d.", MEM_ARB_IWEIGHT, MEM_ARB_DWEIGHT);
+    end
+
+    // Clock of the vector unit: if VCLK_ASYNC is set, vproc_core, the data
+    // arbiter, and the data cache are clocked by vclk_i, which is independent
+    // of clk_i, and the interfaces between the two clock domains cross through
+    // CDC FIFOs (see vproc_cdc_bridge); the main core, the instruction cache,
+    // the CSRs, and the memory interface remain clocked by clk_i
+    logic vclk;
+    assign vclk = VCLK_ASYNC ? vclk_i : clk_i;
+
     // Reset synchronizer (sync reset is used for Vicuna by default, async reset for the core)
     logic [3:0] rst_sync_qn;
     logic sync_rst_n;
-    always_ff @(posedge clk_i) begin
+    always_ff @(posedge vclk) begin
         rst_sync_qn[0] <= rst_ni;
         for (int i = 1; i < 4; i++) begin
             rst_sync_qn[i] <= rst_sync_qn[i-1];
@@ -75,32 +119,125 @@ module vproc_top #(
     logic        vect_xreg_wait;
     logic        vect_xreg_valid;
     logic [31:0] vect_xreg;
-    logic        vect_pending_load;
-    logic        vect_pending_store;
+    logic [31:0] vect_dirty_vregs;
+    logic        vect_dirty_cfg;
+    logic        vect_pending_disp;
+    logic        vect_mem_busy;     // vector memory request or pending vector load/store
+    logic        vcore_valid;       // instruction offloaded to vproc_core
+    logic        vcore_gnt;
+    logic        vcore_illegal;
+    vproc_pkg::core_events vect_perf_events;
+
+    // width of the counts of vector domain events (see clock domain crossing)
+    localparam int unsigned VEVT_CNT_W = 6;
+
+    // Extension interface between the main core and vproc_xif (see
+    // vproc_xif.sv), which passes the instructions on to vproc_core
+    localparam int unsigned XIF_ID_W = 4;
+    logic                xif_issue_valid;
+    logic                xif_issue_ready;
+    logic [31:0]         xif_issue_instr;
+    logic [XIF_ID_W-1:0] xif_issue_id;
+    logic [31:0]         xif_issue_rs1;
+    logic [31:0]         xif_issue_rs2;
+    logic [1:0]          xif_issue_rs_valid;
+    logic                xif_issue_accept;
+    logic                xif_issue_writeback;
+    logic                xif_commit_valid;
+    logic [XIF_ID_W-1:0] xif_commit_id;
+    logic                xif_commit_kill;
+    logic                xif_result_valid;
+    logic                xif_result_ready;
+    logic [XIF_ID_W-1:0] xif_result_id;
+    logic [31:0]         xif_result_data;
+    logic [4:0]          xif_result_rd;
+    logic                xif_result_we;
+    logic                xif_result_exc;
+    logic [5:0]          xif_result_exccode;
+    logic                xif_pending_load;     // committed vector load buffered by vproc_xif
+    logic                xif_pending_store;    // committed vector store buffered by vproc_xif
+
+    // Signals of the vector clock domain that cross to the main clock domain
+    // (the vc_ prefix denotes the vector domain side)
+    logic        vc_instr_valid;
+    logic [31:0] vc_instr;
+    logic [31:0] vc_x_rs1;
+    logic [31:0] vc_x_rs2;
+    logic        vc_instr_gnt;
+    logic        vc_instr_illegal;
+    logic        vc_xreg_wait;
+    logic        vc_xreg_valid;
+    logic [31:0] vc_xreg;
+    logic        vc_pending_load;
+    logic        vc_pending_store;
+    logic        vc_queued_load;
+    logic        vc_queued_store;
+    logic [31:0] vc_dirty_vregs;
+    logic        vc_dirty_cfg;
+    logic        vc_pending_disp;
+    vproc_pkg::core_events vc_perf_events;
 
-    // CSR register interface for Vector Unit
-    localparam int unsigned VECT_CSR_CNT = 7;
+    // CSR register interface for Vector Unit; the performance counters occupy
+    // three CSRs each (mhpmcounterN, mhpmcounterNh, and mhpmeventN, starting at
+    // N = 3), which replace the unimplemented hardware performance counters of
+    // Ibex (MHPMCounterNum is 0); the CSRs are either external CSRs of Ibex or
+    // accessed through the extension interface (xif_csr_*)
+    localparam int unsigned PERF_CSR_IDX = 18;
+    localparam int unsigned VECT_CSR_CNT = PERF_CSR_IDX + 3 * PERF_CNT_NUM;
     logic [11:0] vect_csr_addr [VECT_CSR_CNT];
     logic [31:0] vect_csr_rdata[VECT_CSR_CNT];
     logic        vect_csr_we   [VECT_CSR_CNT];
     logic [31:0] vect_csr_wdata[VECT_CSR_CNT];
-    assign vect_csr_addr = '{
-        12'h008, // vstart
-        12'h009, // vxsat
-        12'h00A, // vxrm
-        12'h00F, // vcsr
-        12'hC20, // vl
-        12'hC21, // vtype
-        12'hC22  // vlenb
-    };
+    logic        xif_csr_we    [VECT_CSR_CNT];
+    logic [31:0] xif_csr_wdata [VECT_CSR_CNT];
+    assign vect_csr_addr[0]  = 12'h008; // vstart
+    assign vect_csr_addr[1]  = 12'h009; // vxsat
+    assign vect_csr_addr[2]  = 12'h00A; // vxrm
+    assign vect_csr_addr[3]  = 12'h00F; // vcsr
+    assign vect_csr_addr[4]  = 12'hC20; // vl
+    assign vect_csr_addr[5]  = 12'hC21; // vtype
+    assign vect_csr_addr[6]  = 12'hC22; // vlenb
+    assign vect_csr_addr[7]  = 12'h7C0; // cache_start (custom)
+    assign vect_csr_addr[8]  = 12'h7C1; // cache_end   (custom)
+    assign vect_csr_addr[9]  = 12'h7C2; // cache_ctl   (custom)
+    assign vect_csr_addr[10] = 12'h7C3; // cache_lock  (custom)
+    assign vect_csr_addr[11] = 12'hFC0; // icache_miss (custom, read-only)
+    assign vect_csr_addr[12] = 12'hFC1; // dcache_miss (custom, read-only)
+    assign vect_csr_addr[13] = 12'h7C4; // trace_ctl   (custom)
+    assign vect_csr_addr[14] = 12'hFC2; // trace_stat  (custom, read-only)
+    assign vect_csr_addr[15] = 12'h7C5; // vsuspend    (custom)
+    assign vect_csr_addr[16] = 12'h7C6; // vctx        (custom)
+    assign vect_csr_addr[17] = 12'h7C7; // vdirty      (custom)
+    generate
+        for (genvar i = 0; i < PERF_CNT_NUM; i++) begin
+            assign vect_csr_addr[PERF_CSR_IDX + 3*i    ] = 12'hB03 + 12'(i); // mhpmcounter
+            assign vect_csr_addr[PERF_CSR_IDX + 3*i + 1] = 12'hB83 + 12'(i); // mhpmcounterh
+            assign vect_csr_addr[PERF_CSR_IDX + 3*i + 2] = 12'h323 + 12'(i); // mhpmevent
+        end
+    endgenerate
+
+    // Main core: Ibex by default, or CV32E40X (with its native extension
+    // interface) if VPROC_CV32E40X is defined
+`ifndef VPROC_CV32E40X
+    // Ibex offloads instructions through its coprocessor interface, which is
+    // converted to the extension interface; the vector CSRs are external CSRs
+    logic        cpi_req;
+    logic [31:0] cpi_instr;
+    logic [31:0] cpi_rs1;
+    logic [31:0] cpi_rs2;
+    logic        cpi_gnt;
+    logic        cpi_illegal;
+    logic        cpi_wait;
+    logic        cpi_res_valid;
+    logic [31:0] cpi_res;
 
     ibex_top #(
         .DmHaltAddr             ( 32'h00000000                       ),
         .DmExceptionAddr        ( 32'h00000000                       ),
         .RV32M                  ( ibex_pkg::RV32MNone                ),
         .ExternalCSRs           ( VECT_CSR_CNT                       ),
-        // LOAD-FP, STORE-FP and VECTOR opcodes
-        .CoprocOpcodes          ( 32'h00200202                       )
+        // LOAD-FP, STORE-FP, VECTOR and OP-VE opcodes
+        .CoprocOpcodes          ( 32'h20200202                       )
     ) u_core (
         .clk_i                  ( clk_i                              ),
         .rst_ni                 ( rst_ni                             ),
@@ -128,20 +265,20 @@ module vproc_top #(
         .data_rdata_i           ( sdata_rdata                        ),
         .data_err_i             ( sdata_err                          ),
 
-        .cpi_req_o              ( vect_instr_valid                   ),
-        .cpi_instr_o            ( vect_instr                         ),
-        .cpi_rs1_o              ( vect_x_rs1                         ),
-        .cpi_rs2_o              ( vect_x_rs2                         ),
-        .cpi_gnt_i              ( vect_instr_gnt                     ),
-        .cpi_instr_illegal_i    ( vect_instr_illegal                 ),
-        .cpi_wait_i             ( vect_xreg_wait                     ),
-        .cpi_res_valid_i        ( vect_xreg_valid                    ),
-        .cpi_res_i              ( vect_xreg                          ),
+        .cpi_req_o              ( cpi_req                            ),
+        .cpi_instr_o            ( cpi_instr                          ),
+        .cpi_rs1_o              ( cpi_rs1                            ),
+        .cpi_rs2_o              ( cpi_rs2                            ),
+        .cpi_gnt_i              ( cpi_gnt                            ),
+        .cpi_instr_illegal_i    ( cpi_illegal                        ),
+        .cpi_wait_i             ( cpi_wait                           ),
+        .cpi_res_valid_i        ( cpi_res_valid                      ),
+        .cpi_res_i              ( cpi_res                            ),
 
         .irq_software_i         ( 1'b0                               ),
         .irq_timer_i            ( 1'b0                               ),
         .irq_external_i         ( 1'b0                               ),
-        .irq_fast_i             ( 15'b0                              ),
+        .irq_fast_i             ( irq_fast_i                         ),
         .irq_nm_i               ( 1'b0                               ),
 
         .ecsr_addr_i            ( vect_csr_addr                      ),
@@ -160,10 +297,220 @@ module vproc_top #(
         .scan_rst_ni            ( 1'b1                               )
     );
 
+    vproc_xif_ibex #(
+        .X_ID_W                 ( XIF_ID_W                           )
+    ) u_xif_ibex (
+        .clk_i                  ( clk_i                              ),
+        .rst_ni                 ( rst_ni                             ),
+        .cpi_req_i              ( cpi_req                            ),
+        .cpi_instr_i            ( cpi_instr                          ),
+        .cpi_rs1_i              ( cpi_rs1                            ),
+        .cpi_rs2_i              ( cpi_rs2                            ),
+        .cpi_gnt_o              ( cpi_gnt                            ),
+        .cpi_instr_illegal_o    ( cpi_illegal                        ),
+        .cpi_wait_o             ( cpi_wait                           ),
+        .cpi_res_valid_o        ( cpi_res_valid                      ),
+        .cpi_res_o              ( cpi_res                            ),
+        .xif_issue_valid_o      ( xif_issue_valid                    ),
+        .xif_issue_ready_i      ( xif_issue_ready                    ),
+        .xif_issue_instr_o      ( xif_issue_instr                    ),
+        .xif_issue_id_o         ( xif_issue_id                       ),
+        .xif_issue_rs1_o        ( xif_issue_rs1                      ),
+        .xif_issue_rs2_o        ( xif_issue_rs2                      ),
+        .xif_issue_rs_valid_o   ( xif_issue_rs_valid                 ),
+        .xif_issue_accept_i     ( xif_issue_accept                   ),
+        .xif_issue_writeback_i  ( xif_issue_writeback                ),
+        .xif_commit_valid_o     ( xif_commit_valid                   ),
+        .xif_commit_id_o        ( xif_commit_id                      ),
+        .xif_commit_kill_o      ( xif_commit_kill                    ),
+        .xif_result_valid_i     ( xif_result_valid                   ),
+        .xif_result_ready_o     ( xif_result_ready                   ),
+        .xif_result_data_i      ( xif_result_data                    ),
+        .xif_result_we_i        ( xif_result_we                      )
+    );
+`else
+    // CV32E40X offers all instructions that it does not implement (including
+    // accesses to unknown CSRs) on its extension interface, which is an SV
+    // interface; the memory interface of the extension interface is unused
+    cv32e40x_if_xif #(
+        .X_NUM_RS               ( 2                                  ),
+        .X_ID_WIDTH             ( XIF_ID_W                           ),
+        .X_MEM_WIDTH            ( 32                                 ),
+        .X_RFR_WIDTH            ( 32                                 ),
+        .X_RFW_WIDTH            ( 32                                 ),
+        .X_MISA                 ( '0                                 ),
+        .X_ECS_XS               ( '0                                 )
+    ) core_xif ();
+
+    assign xif_issue_valid                 = core_xif.issue_valid;
+    assign core_xif.issue_ready            = xif_issue_ready;
+    assign xif_issue_instr                 = core_xif.issue_req.instr;
+    assign xif_issue_id                    = core_xif.issue_req.id;
+    assign xif_issue_rs1                   = core_xif.issue_req.rs[0];
+    assign xif_issue_rs2                   = core_xif.issue_req.rs[1];
+    assign xif_issue_rs_valid              = core_xif.issue_req.rs_valid;
+    assign core_xif.issue_resp.accept      = xif_issue_accept;
+    assign core_xif.issue_resp.writeback   = xif_issue_writeback;
+    assign core_xif.issue_resp.dualwrite   = 1'b0;
+    assign core_xif.issue_resp.dualread    = 1'b0;
+    assign core_xif.issue_resp.loadstore   = 1'b0;
+    assign core_xif.issue_resp.ecswrite    = 1'b0;
+    assign core_xif.issue_resp.exc         = 1'b0;
+    assign xif_commit_valid                = core_xif.commit_valid;
+    assign xif_commit_id                   = core_xif.commit.id;
+    assign xif_commit_kill                 = core_xif.commit.commit_kill;
+    assign core_xif.result_valid           = xif_result_valid;
+    assign xif_result_ready                = core_xif.result_ready;
+    assign core_xif.result.id              = xif_result_id;
+    assign core_xif.result.data            = xif_result_data;
+    assign core_xif.result.rd              = xif_result_rd;
+    assign core_xif.result.we              = xif_result_we;
+    assign core_xif.result.ecsdata         = '0;
+    assign core_xif.result.ecswe           = '0;
+    assign core_xif.result.exc             = xif_result_exc;
+    assign core_xif.result.exccode         = xif_result_exccode;
+    assign core_xif.result.err             = 1'b0;
+    assign core_xif.result.dbg             = 1'b0;
+    assign core_xif.compressed_ready       = 1'b1;
+    assign core_xif.compressed_resp        = '0;
+    assign core_xif.mem_valid              = 1'b0;
+    assign core_xif.mem_req                = '0;
+    assign core_xif.mem_result_valid       = 1'b0;
+    assign core_xif.mem_result             = '0;
+
+    for (genvar i = 0; i < VECT_CSR_CNT; i++) begin
+        assign vect_csr_we   [i] = xif_csr_we   [i];
+        assign vect_csr_wdata[i] = xif_csr_wdata[i];
+    end
+
+    cv32e40x_core #(
+        .M_EXT                  ( cv32e40x_pkg::M                    ),
+        .X_EXT                  ( 1'b1                               ),
+        .X_NUM_RS               ( 2                                  ),
+        .X_ID_WIDTH             ( XIF_ID_W                           ),
+        .X_MEM_WIDTH            ( 32                                 ),
+        .X_RFR_WIDTH            ( 32                                 ),
+        .X_RFW_WIDTH            ( 32                                 ),
+        .X_MISA                 ( '0                                 ),
+        .X_ECS_XS               ( '0                                 )
+    ) u_core (
+        .clk_i                  ( clk_i                              ),
+        .rst_ni                 ( rst_ni                             ),
+        .scan_cg_en_i           ( 1'b0                               ),
+
+        // same reset vector and trap vector base as Ibex
+        .boot_addr_i            ( 32'h00000080                       ),
+        .mtvec_addr_i           ( 32'h00000000                       ),
+        .dm_halt_addr_i         ( 32'h00000000                       ),
+        .dm_exception_addr_i    ( 32'h00000000                       ),
+        .mhartid_i              ( 32'h00000000                       ),
+        .mimpid_patch_i         ( 4'h0                               ),
+
+        .instr_req_o            ( instr_req                          ),
+        .instr_gnt_i            ( instr_gnt                          ),
+        .instr_rvalid_i         ( instr_rvalid                       ),
+        .instr_addr_o           ( instr_addr                         ),
+        .instr_memtype_o        (                                    ),
+        .instr_prot_o           (                                    ),
+        .instr_dbg_o            (                                    ),
+        .instr_rdata_i          ( instr_rdata                        ),
+        .instr_err_i            ( instr_err                          ),
+
+        .data_req_o             ( sdata_req                          ),
+        .data_gnt_i             ( sdata_gnt                          ),
+        .data_rvalid_i          ( sdata_rvalid                       ),
+        .data_addr_o            ( sdata_addr                         ),
+        .data_be_o              ( sdata_be                           ),
+        .data_we_o              ( sdata_we                           ),
+        .data_wdata_o           ( sdata_wdata                        ),
+        .data_memtype_o         (                                    ),
+        .data_prot_o            (                                    ),
+        .data_dbg_o             (                                    ),
+        .data_atop_o            (                                    ),
+        .data_rdata_i           ( sdata_rdata                        ),
+        .data_err_i             ( sdata_err                          ),
+        .data_exokay_i          ( 1'b1                               ),
+
+        .mcycle_o               (                                    ),
+        .time_i                 ( 64'b0                              ),
+
+        .xif_compressed_if      ( core_xif                           ),
+        .xif_issue_if           ( core_xif                           ),
+        .xif_commit_if          ( core_xif                           ),
+        .xif_mem_if             ( core_xif                           ),
+        .xif_mem_result_if      ( core_xif                           ),
+        .xif_result_if          ( core_xif                           ),
+
+        // the fast interrupts of Ibex are the platform interrupts 16 to 30
+        .irq_i                  ( {1'b0, irq_fast_i, 16'b0}          ),
+        .clic_irq_i             ( 1'b0                               ),
+        .clic_irq_id_i          ( '0                                 ),
+        .clic_irq_level_i       ( '0                                 ),
+        .clic_irq_priv_i        ( '0                                 ),
+        .clic_irq_shv_i         ( 1'b0                               ),
+
+        .fencei_flush_req_o     (                                    ),
+        .fencei_flush_ack_i     ( 1'b1                               ),
+
+        .debug_req_i            ( 1'b0                               ),
+        .debug_havereset_o      (                                    ),
+        .debug_running_o        (                                    ),
+        .debug_halted_o         (                                    ),
+        .debug_pc_valid_o       (                                    ),
+        .debug_pc_o             (                                    ),
+
+        .fetch_enable_i         ( 1'b1                               ),
+        .core_sleep_o           (                                    ),
+        .wu_wfe_i               ( 1'b0                               )
+    );
+`endif
+
+    vproc_xif #(
+        .X_ID_W                 ( XIF_ID_W                           ),
+        .CSR_CNT                ( VECT_CSR_CNT                       )
+    ) u_xif (
+        .clk_i                  ( clk_i                              ),
+        .rst_ni                 ( rst_ni                             ),
+        .xif_issue_valid_i      ( xif_issue_valid                    ),
+        .xif_issue_ready_o      ( xif_issue_ready                    ),
+        .xif_issue_instr_i      ( xif_issue_instr                    ),
+        .xif_issue_id_i         ( xif_issue_id                       ),
+        .xif_issue_rs1_i        ( xif_issue_rs1                      ),
+        .xif_issue_rs2_i        ( xif_issue_rs2                      ),
+        .xif_issue_rs_valid_i   ( xif_issue_rs_valid                 ),
+        .xif_issue_accept_o     ( xif_issue_accept                   ),
+        .xif_issue_writeback_o  ( xif_issue_writeback                ),
+        .xif_commit_valid_i     ( xif_commit_valid                   ),
+        .xif_commit_id_i        ( xif_commit_id                      ),
+        .xif_commit_kill_i      ( xif_commit_kill                    ),
+        .xif_result_valid_o     ( xif_result_valid                   ),
+        .xif_result_ready_i     ( xif_result_ready                   ),
+        .xif_result_id_o        ( xif_result_id                      ),
+        .xif_result_data_o      ( xif_result_data                    ),
+        .xif_result_rd_o        ( xif_result_rd                      ),
+        .xif_result_we_o        ( xif_result_we                      ),
+        .xif_result_exc_o       ( xif_result_exc                     ),
+        .xif_result_exccode_o   ( xif_result_exccode                 ),
+        .instr_valid_o          ( vect_instr_valid                   ),
+        .instr_o                ( vect_instr                         ),
+        .x_rs1_o                ( vect_x_rs1                         ),
+        .x_rs2_o                ( vect_x_rs2                         ),
+        .instr_gnt_i            ( vect_instr_gnt                     ),
+        .instr_illegal_i        ( vect_instr_illegal                 ),
+        .xreg_wait_i            ( vect_xreg_wait                     ),
+        .xreg_valid_i           ( vect_xreg_valid                    ),
+        .xreg_i                 ( vect_xreg                          ),
+        .pending_load_o         ( xif_pending_load                   ),
+        .pending_store_o        ( xif_pending_store                  ),
+        .csr_addr_i             ( vect_csr_addr                      ),
+        .csr_rdata_i            ( vect_csr_rdata                     ),
+        .csr_we_o               ( xif_csr_we                         ),
+        .csr_wdata_o            ( xif_csr_wdata                      )
+    );
+
     // Vector CSR read/write conversion
     logic [31:0] csr_vtype;
     logic [31:0] csr_vl;
-    logic [31:0] csr_vlenb;
     logic [31:0] csr_vstart_rd;
     logic [31:0] csr_vstart_wr;
     logic        csr_vstart_wren;
@@ -173,13 +520,24 @@ module vproc_top #(
     logic [1:0]  csr_vxrm_rd;
     logic [1:0]  csr_vxrm_wr;
     logic        csr_vxrm_wren;
-    assign vect_csr_rdata[0] = csr_vstart_rd;
     assign vect_csr_rdata[1] = {31'b0, csr_vxsat_rd};
     assign vect_csr_rdata[2] = {30'b0, csr_vxrm_rd};
     assign vect_csr_rdata[3] = {29'b0, csr_vxrm_rd, csr_vxsat_rd};
     assign vect_csr_rdata[4] = csr_vl;
     assign vect_csr_rdata[5] = csr_vtype;
     assign vect_csr_rdata[6] = VREG_W / 8;
+    logic [31:0] vc_csr_vtype;
+    logic [31:0] vc_csr_vl;
+    logic [31:0] vc_csr_vlenb;
+    logic [31:0] vc_csr_vstart_rd;
+    logic [31:0] vc_csr_vstart_wr;
+    logic        vc_csr_vstart_wren;
+    logic        vc_csr_vxsat_rd;
+    logic        vc_csr_vxsat_wr;
+    logic        vc_csr_vxsat_wren;
+    logic [1:0]  vc_csr_vxrm_rd;
+    logic [1:0]  vc_csr_vxrm_wr;
+    logic        vc_csr_vxrm_wren;
     assign csr_vstart_wr     = vect_csr_wdata[0];
     assign csr_vstart_wren   = vect_csr_we[0];
     assign csr_vxsat_wr      = vect_csr_we[1] ? vect_csr_wdata[1][0]   : vect_csr_wdata[3][0];
@@ -187,6 +545,41 @@ module vproc_top #(
     assign csr_vxrm_wr       = vect_csr_we[2] ? vect_csr_wdata[2][1:0] : vect_csr_wdata[3][2:1];
     assign csr_vxrm_wren     = vect_csr_we[2] | vect_csr_we[3];
 
+    // Vector context state for lazy context switching: the CSR vctx holds the
+    // vector state status VS (bits 1:0, with the encoding of mstatus.VS, i.e.,
+    // Off, Initial, Clean, and Dirty) and a flag indicating that offloaded
+    // instructions are still waiting for dispatch (bit 31, read-only).  Any
+    // modification of the vector registers or of the vector CSRs sets VS to
+    // Dirty unless it is Off, in which case vector instructions are illegal.
+    // The CSR vdirty holds a mask of the vector registers written since it
+    // was last cleared.  Both are only complete for the instructions that
+    // have been dispatched, i.e., once bit 31 of vctx reads as zero.
+    logic [1:0]  vctx_vs_q;
+    logic [31:0] vctx_dirty_q;
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (~rst_ni) begin
+            vctx_vs_q    <= 2'b01; // Initial
+            vctx_dirty_q <= '0;
+        end else begin
+            if (vect_csr_we[16]) begin
+                vctx_vs_q <= vect_csr_wdata[16][1:0];
+            end
+            else if ((vctx_vs_q != 2'b00) & ((vect_dirty_vregs != '0) | vect_dirty_cfg)) begin
+                vctx_vs_q <= 2'b11; // Dirty
+            end
+            vctx_dirty_q <= (vect_csr_we[17] ? vect_csr_wdata[17] : vctx_dirty_q) | vect_dirty_vregs;
+        end
+    end
+    assign vect_csr_rdata[16] = {vect_pending_disp, 29'b0, vctx_vs_q};
+    assign vect_csr_rdata[17] = vctx_dirty_q;
+
+    // while the vector state is Off, vector instructions are refused as illegal
+    logic vctx_off;
+    assign vctx_off           = vctx_vs_q == 2'b00;
+    assign vcore_valid        = vect_instr_valid & ~vctx_off;
+    assign vect_instr_gnt     = vctx_off ? vect_instr_valid : vcore_gnt;
+    assign vect_instr_illegal = vctx_off | vcore_illegal;
+
     // Data read/write for Vector Unit
     logic                vdata_gnt;
     logic                vdata_rvalid;
@@ -198,6 +591,9 @@ module vproc_top #(
     logic [VMEM_W/8-1:0] vdata_be;
     logic [VMEM_W-1:0]   vdata_wdata;
 
+    // Vector AES unit: if AES_UNIT is set, vproc_core contains the AES unit
+    // (which requires VREG_W to be at least 128) and its register file two
+    // additional read ports, hence it is disabled by default
     vproc_core #(
         .VREG_W           (  VREG_W                     ),
         .VMEM_W           (  VMEM_W                     ),
@@ -206,38 +602,47 @@ module vproc_top #(
         .SLD_OP_W         ( (VMUL_W > 64) ? VMUL_W : 64 ),
         .RAM_TYPE         ( RAM_TYPE                    ),
         .MUL_TYPE         ( MUL_TYPE                    ),
+        .AES_UNIT         ( AES_UNIT                    ),
         .DONT_CARE_ZERO   ( 1'b0                        ),
         .ASYNC_RESET      ( 1'b0                        )
     ) v_core (
-        .clk_i            ( clk_i              ),
+        .clk_i            ( vclk               ),
         .rst_ni           ( sync_rst_n         ),
 
-        .instr_valid_i    ( vect_instr_valid   ),
-        .instr_i          ( vect_instr         ),
-        .x_rs1_i          ( vect_x_rs1         ),
-        .x_rs2_i          ( vect_x_rs2         ),
-        .instr_gnt_o      ( vect_instr_gnt     ),
-        .instr_illegal_o  ( vect_instr_illegal ),
+        .instr_valid_i    ( vc_instr_valid     ),
+        .instr_i          ( vc_instr           ),
+        .x_rs1_i          ( vc_x_rs1           ),
+        .x_rs2_i          ( vc_x_rs2           ),
+        .instr_gnt_o      ( vc_instr_gnt       ),
+        .instr_illegal_o  ( vc_instr_illegal   ),
         .misaligned_ls_o  ( vect_misaligned_ls ),
-        .xreg_wait_o      ( vect_xreg_wait     ),
-        .xreg_valid_o     ( vect_xreg_valid    ),
-        .xreg_o           ( vect_xreg          ),
-
-        .pending_load_o   ( vect_pending_load  ),
-        .pending_store_o  ( vect_pending_store ),
-
-        .csr_vtype_o      ( csr_vtype          ),
-        .csr_vl_o         ( csr_vl             ),
-        .csr_vlenb_o      ( csr_vlenb          ),
-        .csr_vstart_o     ( csr_vstart_rd      ),
-        .csr_vstart_i     ( csr_vstart_wr      ),
-        .csr_vstart_set_i ( csr_vstart_wren    ),
-        .csr_vxrm_o       ( csr_vxrm_rd        ),
-        .csr_vxrm_i       ( csr_vxrm_wr        ),
-        .csr_vxrm_set_i   ( csr_vxrm_wren      ),
-        .csr_vxsat_o      ( csr_vxsat_rd       ),
-        .csr_vxsat_i      ( csr_vxsat_wr       ),
-        .csr_vxsat_set_i  ( csr_vxsat_wren     ),
+        .xreg_wait_o      ( vc_xreg_wait       ),
+        .xreg_valid_o     ( vc_xreg_valid      ),
+        .xreg_o           ( vc_xreg            ),
+
+        .pending_load_o   ( vc_pending_load    ),
+        .pending_store_o  ( vc_pending_store   ),
+        .queued_load_o    ( vc_queued_load     ),
+        .queued_store_o   ( vc_queued_store    ),
+
+        .perf_events_o    ( vc_perf_events     ),
+
+        .dirty_vregs_o    ( vc_dirty_vregs     ),
+        .dirty_cfg_o      ( vc_dirty_cfg       ),
+        .pending_disp_o   ( vc_pending_disp    ),
+
+        .csr_vtype_o      ( vc_csr_vtype       ),
+        .csr_vl_o         ( vc_csr_vl          ),
+        .csr_vlenb_o      ( vc_csr_vlenb       ),
+        .csr_vstart_o     ( vc_csr_vstart_rd   ),
+        .csr_vstart_i     ( vc_csr_vstart_wr   ),
+        .csr_vstart_set_i ( vc_csr_vstart_wren ),
+        .csr_vxrm_o       ( vc_csr_vxrm_rd     ),
+        .csr_vxrm_i       ( vc_csr_vxrm_wr     ),
+        .csr_vxrm_set_i   ( vc_csr_vxrm_wren   ),
+        .csr_vxsat_o      ( vc_csr_vxsat_rd    ),
+        .csr_vxsat_i      ( vc_csr_vxsat_wr    ),
+        .csr_vxsat_set_i  ( vc_csr_vxsat_wren  ),
 
         .data_req_o       ( vdata_req          ),
         .data_gnt_i       ( vdata_gnt          ),
@@ -250,7 +655,350 @@ module vproc_top #(
         .data_wdata_o     ( vdata_wdata        )
     );
 
-    // Data arbiter for main core and vector unit
+    // Cache maintenance CSRs: writing cache_ctl starts an operation on the
+    // address range [cache_start, cache_end) or on the whole cache; reading
+    // cache_ctl returns the last operation and a busy flag in bit 31:
+    // - bit 0: clean (write back dirty lines)
+    // - bit 1: invalidate lines
+    // - bit 2: whole cache (ignore the address range)
+    // - bit 3: instruction cache (instead of the data cache)
+    logic [31:0] cache_start_q, cache_end_q;
+    logic [3:0]  cache_ctl_q;
+    logic        cache_op_pending_q;    // operation waiting to be accepted
+    logic        cache_ctrl_req, icache_ctrl_req, dcache_ctrl_req;
+    logic        icache_ctrl_gnt, icache_ctrl_busy;
+    logic        dcache_ctrl_gnt, dcache_ctrl_busy;
+    logic        cache_ctrl_gnt,  cache_ctrl_busy;
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (~rst_ni) begin
+            cache_start_q      <= '0;
+            cache_end_q        <= '0;
+            cache_ctl_q        <= '0;
+            cache_op_pending_q <= 1'b0;
+        end else begin
+            if (vect_csr_we[7]) begin
+                cache_start_q <= vect_csr_wdata[7];
+            end
+            if (vect_csr_we[8]) begin
+                cache_end_q <= vect_csr_wdata[8];
+            end
+            if (vect_csr_we[9]) begin
+                cache_ctl_q        <= vect_csr_wdata[9][3:0];
+                cache_op_pending_q <= 1'b1;
+            end
+            else if (cache_ctrl_req & cache_ctrl_gnt) begin
+                cache_op_pending_q <= 1'b0;
+            end
+        end
+    end
+    // operations wait for pending vector loads and stores to complete
+    assign cache_ctrl_req    = cache_op_pending_q & ~vect_mem_busy;
+    assign icache_ctrl_req   = cache_ctrl_req &  cache_ctl_q[3];
+    assign dcache_ctrl_req   = cache_ctrl_req & ~cache_ctl_q[3];
+    assign cache_ctrl_gnt    = cache_ctl_q[3] ? icache_ctrl_gnt : dcache_ctrl_gnt;
+    assign cache_ctrl_busy   = icache_ctrl_busy | dcache_ctrl_busy;
+    assign vect_csr_rdata[7] = cache_start_q;
+    assign vect_csr_rdata[8] = cache_end_q;
+    assign vect_csr_rdata[9] = {cache_op_pending_q | cache_ctrl_busy, 27'b0, cache_ctl_q};
+
+    // Cache way locking CSR (bits 1:0 lock ways 0 and 1 of the instruction
+    // cache, bits 3:2 those of the data cache) and cache miss counters
+    logic [3:0]  cache_lock_q;
+    logic [31:0] icache_miss_cnt_q, dcache_miss_cnt_q;
+    logic        icache_miss;
+    logic [VEVT_CNT_W-1:0] dcache_miss_cnt;
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (~rst_ni) begin
+            cache_lock_q      <= '0;
+            icache_miss_cnt_q <= '0;
+            dcache_miss_cnt_q <= '0;
+        end else begin
+            if (vect_csr_we[10]) begin
+                cache_lock_q <= vect_csr_wdata[10][3:0];
+            end
+            if (icache_miss) begin
+                icache_miss_cnt_q <= icache_miss_cnt_q + 1;
+            end
+            dcache_miss_cnt_q <= dcache_miss_cnt_q + 32'(dcache_miss_cnt);
+        end
+    end
+    assign vect_csr_rdata[10] = {28'b0, cache_lock_q};
+    assign vect_csr_rdata[11] = icache_miss_cnt_q;
+    assign vect_csr_rdata[12] = dcache_miss_cnt_q;
+
+    // Vector memory suspension: while suspended, the vector unit receives no
+    // grants for its memory requests, hence the load or store in progress
+    // stops at an element boundary and its progress is reported by vstart.
+    // The main core then accesses memory without waiting for the suspended
+    // load or store, so that the latency of interrupt handlers does not
+    // depend on the vector workload (the handler must neither access the
+    // memory operated on by the suspended instruction nor issue vector
+    // instructions).  Writing the CSR vsuspend (bit 1) suspends and resumes
+    // the vector memory accesses; if auto-suspension (bit 0) is enabled, the
+    // vector memory accesses are suspended whenever a fast interrupt is
+    // raised, and the interrupt handler resumes them before returning.
+    //
+    // The suspension is lifted while the main core waits for the vector unit
+    // (for the grant of an offloaded instruction or for an x register
+    // result), since the instructions ahead of it might depend on the
+    // suspended load or store, as well as for scalar accesses that wait for
+    // vector loads or stores queued behind the suspended one (see below).
+    logic        vsusp_auto_q, vsusp_q;
+    logic [14:0] vsusp_irq_q;
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (~rst_ni) begin
+            vsusp_auto_q <= 1'b0;
+            vsusp_q      <= 1'b0;
+            vsusp_irq_q  <= '0;
+        end else begin
+            vsusp_irq_q <= irq_fast_i;
+            if (vect_csr_we[15]) begin
+                vsusp_auto_q <= vect_csr_wdata[15][0];
+                vsusp_q      <= vect_csr_wdata[15][1];
+            end
+            else if (vsusp_auto_q & ((irq_fast_i & ~vsusp_irq_q) != '0)) begin
+                vsusp_q      <= 1'b1;
+            end
+        end
+    end
+    assign vect_csr_rdata[15] = {30'b0, vsusp_q, vsusp_auto_q};
+
+    // the main core waits for the vector unit (one cycle delayed, since the
+    // grant of vproc_core depends on the suspension)
+    logic vwait_xreg_q, vwait_q;
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (~rst_ni) begin
+            vwait_xreg_q <= 1'b0;
+            vwait_q      <= 1'b0;
+        end else begin
+            if (vect_xreg_valid) begin
+                vwait_xreg_q <= 1'b0;
+            end
+            if (vcore_valid & vcore_gnt & ~vcore_illegal & vect_xreg_wait) begin
+                vwait_xreg_q <= 1'b1;
+            end
+            vwait_q <= (vcore_valid & ~vcore_gnt) | vwait_xreg_q;
+        end
+    end
+    logic vsusp_act;
+    assign vsusp_act = vsusp_q & ~vwait_q;
+    // vstart is zero unless the vector memory accesses are suspended
+    assign vect_csr_rdata[0]  = vsusp_q ? csr_vstart_rd : '0;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Clock domain crossing between the main core and the vector unit
+
+    // events of the vector clock domain (for the performance counters and the
+    // trace buffer); the clock domain bridge delivers the number of
+    // occurrences of each event (more than one if the vector clock is faster),
+    // which is split into the bits of the counts (vect_evt_bits[b] holds bit
+    // b of the count of every event, in the order of vc_events)
+    localparam int unsigned VEVT_W = $bits(vproc_pkg::core_events) + 6;
+    logic [VEVT_W-1:0]                 vc_events;
+    logic [VEVT_W-1:0][VEVT_CNT_W-1:0] vect_events;
+    logic [VEVT_CNT_W-1:0][VEVT_W-1:0] vect_evt_bits;
+    vproc_pkg::core_events             vect_perf_bits[VEVT_CNT_W];
+    logic [VEVT_CNT_W-1:0]             vmem_req_cnt, vmem_gnt_cnt, vmem_rvalid_cnt, vmem_stall_cnt;
+    logic [VEVT_CNT_W-1:0]             dcache_acc_cnt;
+    logic [VEVT_CNT_W-1:0]             disp_lsu_cnt, disp_alu_cnt, disp_mul_cnt, disp_sld_cnt, disp_elem_cnt;
+    logic [VEVT_CNT_W-1:0]             disp_aes_cnt, stall_hazard_cnt, stall_unit_cnt, queue_empty_cnt;
+    always_comb begin
+        vect_perf_events = '0;
+        for (int b = 0; b < VEVT_CNT_W; b++) begin
+            for (int i = 0; i < VEVT_W; i++) begin
+                vect_evt_bits[b][i] = vect_events[i][b];
+            end
+            {vect_perf_bits[b], vmem_req_cnt[b], vmem_gnt_cnt[b], vmem_rvalid_cnt[b], vmem_stall_cnt[b],
+             dcache_acc_cnt[b], dcache_miss_cnt[b]} = vect_evt_bits[b];
+            disp_lsu_cnt    [b] = vect_perf_bits[b].dispatch_lsu;
+            disp_alu_cnt    [b] = vect_perf_bits[b].dispatch_alu;
+            disp_mul_cnt    [b] = vect_perf_bits[b].dispatch_mul;
+            disp_sld_cnt    [b] = vect_perf_bits[b].dispatch_sld;
+            disp_elem_cnt   [b] = vect_perf_bits[b].dispatch_elem;
+            disp_aes_cnt    [b] = vect_perf_bits[b].dispatch_aes;
+            stall_hazard_cnt[b] = vect_perf_bits[b].stall_hazard;
+            stall_unit_cnt  [b] = vect_perf_bits[b].stall_unit;
+            queue_empty_cnt [b] = vect_perf_bits[b].queue_empty;
+            vect_perf_events    = vect_perf_events | vect_perf_bits[b];
+        end
+    end
+    logic vmem_stall_evt;
+    assign vmem_stall_evt = vmem_stall_cnt != '0;
+
+    // vector domain side of the scalar data, data cache, and memory interfaces
+    logic               vc_sdata_req;
+    logic [31:0]        vc_sdata_addr;
+    logic               vc_sdata_we;
+    logic  [3:0]        vc_sdata_be;
+    logic [31:0]        vc_sdata_wdata;
+    logic               vc_sdata_gnt;
+    logic               vc_sdata_rvalid;
+    logic               vc_sdata_err;
+    logic [31:0]        vc_sdata_rdata;
+    logic               vc_dcache_ctrl_req;
+    logic [2:0]         vc_dcache_ctrl_op;
+    logic [31:0]        vc_dcache_ctrl_start, vc_dcache_ctrl_end;
+    logic               vc_dcache_ctrl_gnt, vc_dcache_ctrl_busy;
+    logic [1:0]         vc_dcache_lock;
+    logic               vc_dcache_miss;
+    logic               vc_cache_hold;
+    logic               vc_vsusp;
+    logic               vc_dmem_req;
+    logic               vc_dmem_gnt;
+    logic [31:0]        vc_dmem_addr;
+    logic               vc_dmem_we;
+    logic [MEM_W/8-1:0] vc_dmem_be;
+    logic [MEM_W  -1:0] vc_dmem_wdata;
+    logic               vc_dmem_rvalid;
+    logic [MEM_W  -1:0] vc_dmem_rdata;
+    logic               vc_dmem_err;
+
+    // data memory interface in the main clock domain (see memory arbiter)
+    logic               dmem_req;
+    logic               dmem_gnt;
+    logic [31:0]        dmem_addr;
+    logic               dmem_we;
+    logic [MEM_W/8-1:0] dmem_be;
+    logic [MEM_W  -1:0] dmem_wdata;
+    logic               dmem_rvalid;
+    logic [MEM_W  -1:0] dmem_rdata;
+    logic               dmem_err;
+
+    // scalar data requests wait for cache maintenance operations as well as
+    // for committed vector loads and stores that are still buffered by
+    // vproc_xif (scalar loads only wait for stores), since these are not yet
+    // pending in vproc_core
+    logic sdata_hold_main;
+    assign sdata_hold_main = cache_op_pending_q | cache_ctrl_busy | xif_pending_store |
+                             (xif_pending_load & sdata_we);
+
+    vproc_cdc_bridge #(
+        .ASYNC                ( VCLK_ASYNC                                      ),
+        .MEM_W                ( MEM_W                                           ),
+        .EVT_W                ( VEVT_W                                          ),
+        .EVT_CNT_W            ( VEVT_CNT_W                                      )
+    ) cdc_bridge (
+        .clk_i                ( clk_i                                           ),
+        .vclk_i               ( vclk                                            ),
+        .rst_ni               ( rst_ni                                          ),
+        .instr_valid_i        ( vcore_valid                                     ),
+        .instr_i              ( vect_instr                                      ),
+        .x_rs1_i              ( vect_x_rs1                                      ),
+        .x_rs2_i              ( vect_x_rs2                                      ),
+        .instr_gnt_o          ( vcore_gnt                                       ),
+        .instr_illegal_o      ( vcore_illegal                                   ),
+        .xreg_wait_o          ( vect_xreg_wait                                  ),
+        .xreg_valid_o         ( vect_xreg_valid                                 ),
+        .xreg_o               ( vect_xreg                                       ),
+        .csr_vtype_o          ( csr_vtype                                       ),
+        .csr_vl_o             ( csr_vl                                          ),
+        .csr_vstart_o         ( csr_vstart_rd                                   ),
+        .csr_vstart_i         ( csr_vstart_wr                                   ),
+        .csr_vstart_set_i     ( csr_vstart_wren                                 ),
+        .csr_vxrm_o           ( csr_vxrm_rd                                     ),
+        .csr_vxrm_i           ( csr_vxrm_wr                                     ),
+        .csr_vxrm_set_i       ( csr_vxrm_wren                                   ),
+        .csr_vxsat_o          ( csr_vxsat_rd                                    ),
+        .csr_vxsat_i          ( csr_vxsat_wr                                    ),
+        .csr_vxsat_set_i      ( csr_vxsat_wren                                  ),
+        .pending_disp_o       ( vect_pending_disp                               ),
+        .mem_busy_o           ( vect_mem_busy                                   ),
+        .dirty_vregs_o        ( vect_dirty_vregs                                ),
+        .dirty_cfg_o          ( vect_dirty_cfg                                  ),
+        .events_o             ( vect_events                                     ),
+        .sdata_req_i          ( sdata_req                                       ),
+        .sdata_addr_i         ( sdata_addr                                      ),
+        .sdata_we_i           ( sdata_we                                        ),
+        .sdata_be_i           ( sdata_be                                        ),
+        .sdata_wdata_i        ( sdata_wdata                                     ),
+        .sdata_gnt_o          ( sdata_gnt                                       ),
+        .sdata_rvalid_o       ( sdata_rvalid                                    ),
+        .sdata_err_o          ( sdata_err                                       ),
+        .sdata_rdata_o        ( sdata_rdata                                     ),
+        .dcache_ctrl_req_i    ( dcache_ctrl_req                                 ),
+        .dcache_ctrl_op_i     ( cache_ctl_q[2:0]                                ),
+        .dcache_ctrl_start_i  ( cache_start_q                                   ),
+        .dcache_ctrl_end_i    ( cache_end_q                                     ),
+        .dcache_ctrl_gnt_o    ( dcache_ctrl_gnt                                 ),
+        .dcache_ctrl_busy_o   ( dcache_ctrl_busy                                ),
+        .dcache_lock_i        ( cache_lock_q[3:2]                               ),
+        .cache_hold_i         ( sdata_hold_main                                 ),
+        .vsusp_i              ( vsusp_act                                       ),
+        .dmem_req_o           ( dmem_req                                        ),
+        .dmem_addr_o          ( dmem_addr                                       ),
+        .dmem_we_o            ( dmem_we                                         ),
+        .dmem_be_o            ( dmem_be                                         ),
+        .dmem_wdata_o         ( dmem_wdata                                      ),
+        .dmem_gnt_i           ( dmem_gnt                                        ),
+        .dmem_rvalid_i        ( dmem_rvalid                                     ),
+        .dmem_err_i           ( dmem_err                                        ),
+        .dmem_rdata_i         ( dmem_rdata                                      ),
+        .vinstr_valid_o       ( vc_instr_valid                                  ),
+        .vinstr_o             ( vc_instr                                        ),
+        .vx_rs1_o             ( vc_x_rs1                                        ),
+        .vx_rs2_o             ( vc_x_rs2                                        ),
+        .vinstr_gnt_i         ( vc_instr_gnt                                    ),
+        .vinstr_illegal_i     ( vc_instr_illegal                                ),
+        .vxreg_wait_i         ( vc_xreg_wait                                    ),
+        .vxreg_valid_i        ( vc_xreg_valid                                   ),
+        .vxreg_i              ( vc_xreg                                         ),
+        .vcsr_vtype_i         ( vc_csr_vtype                                    ),
+        .vcsr_vl_i            ( vc_csr_vl                                       ),
+        .vcsr_vstart_i        ( vc_csr_vstart_rd                                ),
+        .vcsr_vstart_o        ( vc_csr_vstart_wr                                ),
+        .vcsr_vstart_set_o    ( vc_csr_vstart_wren                              ),
+        .vcsr_vxrm_i          ( vc_csr_vxrm_rd                                  ),
+        .vcsr_vxrm_o          ( vc_csr_vxrm_wr                                  ),
+        .vcsr_vxrm_set_o      ( vc_csr_vxrm_wren                                ),
+        .vcsr_vxsat_i         ( vc_csr_vxsat_rd                                 ),
+        .vcsr_vxsat_o         ( vc_csr_vxsat_wr                                 ),
+        .vcsr_vxsat_set_o     ( vc_csr_vxsat_wren                               ),
+        .vpending_disp_i      ( vc_pending_disp                                 ),
+        .vmem_busy_i          ( vdata_req | vc_pending_load | vc_pending_store  ),
+        .vdirty_vregs_i       ( vc_dirty_vregs                                  ),
+        .vdirty_cfg_i         ( vc_dirty_cfg                                    ),
+        .vevents_i            ( vc_events                                       ),
+        .vsdata_req_o         ( vc_sdata_req                                    ),
+        .vsdata_addr_o        ( vc_sdata_addr                                   ),
+        .vsdata_we_o          ( vc_sdata_we                                     ),
+        .vsdata_be_o          ( vc_sdata_be                                     ),
+        .vsdata_wdata_o       ( vc_sdata_wdata                                  ),
+        .vsdata_gnt_i         ( vc_sdata_gnt                                    ),
+        .vsdata_rvalid_i      ( vc_sdata_rvalid                                 ),
+        .vsdata_err_i         ( vc_sdata_err                                    ),
+        .vsdata_rdata_i       ( vc_sdata_rdata                                  ),
+        .vdcache_ctrl_req_o   ( vc_dcache_ctrl_req                              ),
+        .vdcache_ctrl_op_o    ( vc_dcache_ctrl_op                               ),
+        .vdcache_ctrl_start_o ( vc_dcache_ctrl_start                            ),
+        .vdcache_ctrl_end_o   ( vc_dcache_ctrl_end                              ),
+        .vdcache_ctrl_gnt_i   ( vc_dcache_ctrl_gnt                              ),
+        .vdcache_ctrl_busy_i  ( vc_dcache_ctrl_busy                             ),
+        .vdcache_lock_o       ( vc_dcache_lock                                  ),
+        .vcache_hold_o        ( vc_cache_hold                                   ),
+        .vsusp_o              ( vc_vsusp                                        ),
+        .vdmem_req_i          ( vc_dmem_req                                     ),
+        .vdmem_addr_i         ( vc_dmem_addr                                    ),
+        .vdmem_we_i           ( vc_dmem_we                                      ),
+        .vdmem_be_i           ( vc_dmem_be                                      ),
+        .vdmem_wdata_i        ( vc_dmem_wdata                                   ),
+        .vdmem_gnt_o          ( vc_dmem_gnt                                     ),
+        .vdmem_rvalid_o       ( vc_dmem_rvalid                                  ),
+        .vdmem_err_o          ( vc_dmem_err                                     ),
+        .vdmem_rdata_o        ( vc_dmem_rdata                                   )
+    );
+
+    // Scalar accesses always wait for the vector loads and stores queued
+    // behind the suspended instruction (which have not reached the LSU yet);
+    // since these cannot proceed before the suspended instruction, the
+    // suspension is lifted until the waiting scalar access is granted, while
+    // the scalar access waits for all pending vector loads and stores.
+    logic vsusp_lift_q, vc_vsusp_act;
+    assign vc_vsusp_act = vc_vsusp & ~vsusp_lift_q;
+
+    logic vdata_req_act;    // vector memory request that is not suspended
+    assign vdata_req_act = vdata_req & ~vc_vsusp_act;
+
+    // Data arbiter for main core and vector unit (vector clock domain)
     logic              sdata_hold;
     logic              data_req;
     logic [31:0]       data_addr;
@@ -263,36 +1011,48 @@ module vproc_top #(
     logic [VMEM_W  :0] data_rdata;
     logic              sdata_waiting, vdata_waiting;
     logic [31:0]       sdata_wait_addr;
-    assign sdata_hold = vdata_req | vect_pending_store | (vect_pending_load & sdata_we);
+    assign sdata_hold = ((vdata_req | vc_pending_store | (vc_pending_load & vc_sdata_we)) & ~vc_vsusp_act) |
+                        vc_queued_store | (vc_queued_load & vc_sdata_we) | vc_cache_hold;
     always_comb begin
-        data_req   = vdata_req | (sdata_req & ~sdata_hold);
-        data_addr  = sdata_addr;
-        data_we    = sdata_we;
-        data_be    = {{(VMEM_W-32){1'b0}}, sdata_be} << (sdata_addr[$clog2(VMEM_W/8)-1:0] & {{$clog2(VMEM_W/32){1'b1}}, 2'b00});
+        data_req   = vdata_req_act | (vc_sdata_req & ~sdata_hold);
+        data_addr  = vc_sdata_addr;
+        data_we    = vc_sdata_we;
+        data_be    = {{(VMEM_W-32){1'b0}}, vc_sdata_be} << (vc_sdata_addr[$clog2(VMEM_W/8)-1:0] & {{$clog2(VMEM_W/32){1'b1}}, 2'b00});
         data_wdata = '0;
         for (int i = 0; i < VMEM_W / 32; i++) begin
-            data_wdata[32*i +: 32] = sdata_wdata;
+            data_wdata[32*i +: 32] = vc_sdata_wdata;
         end
-        if (vdata_req) begin
+        if (vdata_req_act) begin
             data_addr  = vdata_addr;
             data_we    = vdata_we;
             data_be    = vdata_be;
             data_wdata = vdata_wdata;
         end
     end
-    assign sdata_gnt = data_gnt & sdata_req & ~sdata_hold;
-    assign vdata_gnt = data_gnt & vdata_req;
-    always_ff @(posedge clk_i or negedge rst_ni) begin
+    assign vc_sdata_gnt = data_gnt & vc_sdata_req & ~sdata_hold;
+    assign vdata_gnt    = data_gnt & vdata_req_act;
+    always_ff @(posedge vclk or negedge rst_ni) begin
+        if (~rst_ni) begin
+            vsusp_lift_q <= 1'b0;
+        end
+        else if (vc_sdata_gnt) begin
+            vsusp_lift_q <= 1'b0;
+        end
+        else if (vc_vsusp & vc_sdata_req & (vc_queued_store | (vc_queued_load & vc_sdata_we))) begin
+            vsusp_lift_q <= 1'b1;
+        end
+    end
+    always_ff @(posedge vclk or negedge rst_ni) begin
         if (~rst_ni) begin
             sdata_waiting   <= 1'b0;
             vdata_waiting   <= 1'b0;
             sdata_wait_addr <= '0;
         end else begin
-            if (sdata_gnt) begin
+            if (vc_sdata_gnt) begin
                 sdata_waiting   <= 1'b1;
-                sdata_wait_addr <= sdata_addr;
+                sdata_wait_addr <= vc_sdata_addr;
             end
-            else if (sdata_rvalid) begin
+            else if (vc_sdata_rvalid) begin
                 sdata_waiting <= 1'b0;
             end
             if (vdata_gnt) begin
@@ -303,12 +1063,146 @@ module vproc_top #(
             end
         end
     end
-    assign sdata_rvalid = sdata_waiting & data_rvalid;
-    assign vdata_rvalid = vdata_waiting & data_rvalid;
-    assign sdata_err    = data_err;
-    assign vdata_err    = data_err;
-    assign sdata_rdata  = data_rdata[(sdata_wait_addr[$clog2(VMEM_W/8)-1:0] & {{$clog2(VMEM_W/32){1'b1}}, 2'b00})*8 +: 32];
-    assign vdata_rdata  = data_rdata;
+    assign vc_sdata_rvalid = sdata_waiting & data_rvalid;
+    assign vdata_rvalid    = vdata_waiting & data_rvalid;
+    assign vc_sdata_err    = data_err;
+    assign vdata_err       = data_err;
+    assign vc_sdata_rdata  = data_rdata[(sdata_wait_addr[$clog2(VMEM_W/8)-1:0] & {{$clog2(VMEM_W/32){1'b1}}, 2'b00})*8 +: 32];
+    assign vdata_rdata     = data_rdata;
+
+    assign vc_events = {vc_perf_events, vdata_req, vdata_req & vdata_gnt, vdata_rvalid, vdata_req & ~vdata_gnt,
+                        data_req & data_gnt, vc_dcache_miss};
+
+    // Performance counters; the events are selected by setting the
+    // corresponding bits of mhpmeventN:
+    // - bit 0:       cycles
+    // - bits 5 to 1: instructions dispatched to the LSU, ALU, MUL, SLD, and
+    //                ELEM unit, respectively
+    // - bit 6:       dispatcher stall cycles due to vector register hazards
+    // - bit 7:       dispatcher stall cycles due to a busy unit
+    // - bit 8:       cycles without instruction waiting for dispatch
+    // - bit 9:       cycles with a pending vector memory request
+    // - bit 10:      vector memory requests (granted)
+    // - bit 11:      vector memory responses
+    // - bit 12:      instruction cache accesses (instruction memory requests
+    //                without instruction cache)
+    // - bit 13:      instruction cache misses
+    // - bit 14:      data cache accesses (data memory requests without data
+    //                cache)
+    // - bit 15:      data cache misses
+    // - bit 16:      cycles in which a vector instruction offloaded by the
+    //                main core is not accepted
+    // - bit 17:      instructions dispatched to the AES unit
+    // The events of the vector domain are counted in cycles of the vector
+    // clock, those of the main domain in cycles of the main clock.
+    localparam int unsigned PERF_EVT_NUM = 18;
+    logic [PERF_EVT_NUM-1:0][VEVT_CNT_W-1:0] perf_events;
+    assign perf_events = {
+        disp_aes_cnt,
+        VEVT_CNT_W'(vect_instr_valid & ~vect_instr_gnt),
+        dcache_miss_cnt,
+        dcache_acc_cnt,
+        VEVT_CNT_W'(icache_miss),
+        VEVT_CNT_W'(instr_req & instr_gnt),
+        vmem_rvalid_cnt,
+        vmem_gnt_cnt,
+        vmem_req_cnt,
+        queue_empty_cnt,
+        stall_unit_cnt,
+        stall_hazard_cnt,
+        disp_elem_cnt,
+        disp_sld_cnt,
+        disp_mul_cnt,
+        disp_alu_cnt,
+        disp_lsu_cnt,
+        VEVT_CNT_W'(1)
+    };
+    generate
+        if (PERF_CNT_NUM > 0) begin
+            logic                    perf_cnt_we  [PERF_CNT_NUM];
+            logic                    perf_cnth_we [PERF_CNT_NUM];
+            logic                    perf_sel_we  [PERF_CNT_NUM];
+            logic [31:0]             perf_wdata   [PERF_CNT_NUM];
+            logic [63:0]             perf_cnt     [PERF_CNT_NUM];
+            logic [PERF_EVT_NUM-1:0] perf_sel     [PERF_CNT_NUM];
+            for (genvar i = 0; i < PERF_CNT_NUM; i++) begin
+                assign perf_cnt_we [i] = vect_csr_we[PERF_CSR_IDX + 3*i    ];
+                assign perf_cnth_we[i] = vect_csr_we[PERF_CSR_IDX + 3*i + 1];
+                assign perf_sel_we [i] = vect_csr_we[PERF_CSR_IDX + 3*i + 2];
+                assign perf_wdata  [i] = perf_cnt_we [i] ? vect_csr_wdata[PERF_CSR_IDX + 3*i    ] : (
+                                         perf_cnth_we[i] ? vect_csr_wdata[PERF_CSR_IDX + 3*i + 1] :
+                                                           vect_csr_wdata[PERF_CSR_IDX + 3*i + 2]);
+                assign vect_csr_rdata[PERF_CSR_IDX + 3*i    ] = perf_cnt[i][31:0];
+                assign vect_csr_rdata[PERF_CSR_IDX + 3*i + 1] = perf_cnt[i][63:32];
+                assign vect_csr_rdata[PERF_CSR_IDX + 3*i + 2] = {{(32-PERF_EVT_NUM){1'b0}}, perf_sel[i]};
+            end
+            vproc_perfmon #(
+                .CNT_NUM      ( PERF_CNT_NUM ),
+                .EVT_NUM      ( PERF_EVT_NUM ),
+                .EVT_CNT_W    ( VEVT_CNT_W   )
+            ) perfmon (
+                .clk_i        ( clk_i        ),
+                .rst_ni       ( rst_ni       ),
+                .events_i     ( perf_events  ),
+                .cnt_we_i     ( perf_cnt_we  ),
+                .cnth_we_i    ( perf_cnth_we ),
+                .sel_we_i     ( perf_sel_we  ),
+                .wdata_i      ( perf_wdata   ),
+                .cnt_o        ( perf_cnt     ),
+                .sel_o        ( perf_sel     )
+            );
+        end
+    endgenerate
+
+    // Trace buffer; recording is controlled via the custom CSR trace_ctl or
+    // the trace control port (bit 0 enables recording, writing a 1 to bit 1
+    // clears the buffer) and the entries are read via the trace read port.
+    // The custom CSR trace_stat and the trace status port hold the number of
+    // entries in bits 29 to 0, the enable flag in bit 30, and the overflow flag
+    // in bit 31.  With a separate vector clock, the events that the clock
+    // domain bridge delivers in one cycle are recorded in a single entry.
+    logic       trace_ctl_we;
+    logic [1:0] trace_ctl;
+    assign trace_ctl_we = vect_csr_we[13] | trace_ctl_we_i;
+    assign trace_ctl    = vect_csr_we[13] ? vect_csr_wdata[13][1:0] : trace_ctl_i;
+    generate
+        if (TRACE_BUF_LEN != 0) begin
+            logic                           trace_enable, trace_overflow;
+            logic [$clog2(TRACE_BUF_LEN):0] trace_count;
+            vproc_tracebuf #(
+                .LEN          ( TRACE_BUF_LEN                   )
+            ) tracebuf (
+                .clk_i        ( clk_i                           ),
+                .rst_ni       ( rst_ni                          ),
+                .dispatch_i   ( {vect_perf_events.dispatch_aes,
+                                 vect_perf_events.dispatch_elem,
+                                 vect_perf_events.dispatch_sld,
+                                 vect_perf_events.dispatch_mul,
+                                 vect_perf_events.dispatch_alu,
+                                 vect_perf_events.dispatch_lsu} ),
+                .complete_i   ( {vect_perf_events.complete_aes,
+                                 vect_perf_events.complete_elem,
+                                 vect_perf_events.complete_sld,
+                                 vect_perf_events.complete_mul,
+                                 vect_perf_events.complete_alu,
+                                 vect_perf_events.complete_lsu} ),
+                .mem_stall_i  ( vmem_stall_evt                  ),
+                .ctl_we_i     ( trace_ctl_we                    ),
+                .ctl_i        ( trace_ctl                       ),
+                .enable_o     ( trace_enable                    ),
+                .overflow_o   ( trace_overflow                  ),
+                .count_o      ( trace_count                     ),
+                .rd_i         ( trace_rd_i                      ),
+                .rdata_o      ( trace_rdata_o                   )
+            );
+            assign trace_stat_o = {trace_overflow, trace_enable, 30'(trace_count)};
+        end else begin
+            assign trace_stat_o  = '0;
+            assign trace_rdata_o = '0;
+        end
+    endgenerate
+    assign vect_csr_rdata[13] = {31'b0, trace_stat_o[30]};
+    assign vect_csr_rdata[14] = trace_stat_o;
 
 
     ///////////////////////////////////////////////////////////////////////////
@@ -350,9 +1244,22 @@ module vproc_top #(
                 .mem_gnt_i    ( imem_gnt          ),
                 .mem_rvalid_i ( imem_rvalid       ),
                 .mem_rdata_i  ( imem_rdata        ),
-                .mem_err_i    ( imem_err          )
+                .mem_err_i    ( imem_err          ),
+                .ctrl_req_i   ( icache_ctrl_req   ),
+                .ctrl_clean_i ( cache_ctl_q[0]    ),
+                .ctrl_inval_i ( cache_ctl_q[1]    ),
+                .ctrl_all_i   ( cache_ctl_q[2]    ),
+                .ctrl_start_i ( cache_start_q     ),
+                .ctrl_end_i   ( cache_end_q       ),
+                .ctrl_gnt_o   ( icache_ctrl_gnt   ),
+                .ctrl_busy_o  ( icache_ctrl_busy  ),
+                .lock_i       ( cache_lock_q[1:0] ),
+                .miss_o       ( icache_miss       )
             );
         end else begin
+            assign icache_ctrl_gnt  = 1'b1;
+            assign icache_ctrl_busy = 1'b0;
+            assign icache_miss      = 1'b0;
             assign imem_req     = instr_req;
             assign imem_addr    = instr_addr;
             assign instr_gnt    = imem_gnt;
@@ -362,70 +1269,75 @@ module vproc_top #(
         end
     endgenerate
 
-    // data cache
-    logic               dmem_req;
-    logic               dmem_gnt;
-    logic [31:0]        dmem_addr;
-    logic               dmem_we;
-    logic [MEM_W/8-1:0] dmem_be;
-    logic [MEM_W  -1:0] dmem_wdata;
-    logic               dmem_rvalid;
-    logic [MEM_W  -1:0] dmem_rdata;
-    logic               dmem_err;
+    // data cache (vector clock domain)
     generate
         if (DCACHE_SZ != 0) begin
             localparam int unsigned DCACHE_WAY_LEN = DCACHE_SZ / (DCACHE_LINE_W / 8) / 2;
             // hold memory access (allows lookup only) for main core requests
             // in case of pending vector loads / stores
             logic hold_mem;
-            always_ff @(posedge clk_i) begin
-                hold_mem <= ~vdata_req & vect_pending_store & vect_pending_load;
+            always_ff @(posedge vclk) begin
+                hold_mem <= ~vdata_req & vc_pending_store & vc_pending_load;
             end
             vproc_cache #(
-                .ADDR_BIT_W   ( 32                ),
-                .CPU_BYTE_W   ( VMEM_W / 8        ),
-                .MEM_BYTE_W   ( MEM_W / 8         ),
-                .LINE_BYTE_W  ( DCACHE_LINE_W / 8 ),
-                .WAY_LEN      ( DCACHE_WAY_LEN    )
+                .ADDR_BIT_W    ( 32                  ),
+                .CPU_BYTE_W    ( VMEM_W / 8          ),
+                .MEM_BYTE_W    ( MEM_W / 8           ),
+                .LINE_BYTE_W   ( DCACHE_LINE_W / 8   ),
+                .WAY_LEN       ( DCACHE_WAY_LEN      ),
+                .SECTOR_BYTE_W ( DCACHE_SECTOR_W / 8 )
             ) vcache (
-                .clk_i        ( clk_i             ),
-                .rst_ni       ( rst_ni            ),
-                .hold_mem_i   ( hold_mem          ),
-                .cpu_req_i    ( data_req          ),
-                .cpu_addr_i   ( data_addr         ),
-                .cpu_we_i     ( data_we           ),
-                .cpu_be_i     ( data_be           ),
-                .cpu_wdata_i  ( data_wdata        ),
-                .cpu_gnt_o    ( data_gnt          ),
-                .cpu_rvalid_o ( data_rvalid       ),
-                .cpu_rdata_o  ( data_rdata        ),
-                .cpu_err_o    ( data_err          ),
-                .mem_req_o    ( dmem_req          ),
-                .mem_we_o     ( dmem_we           ),
-                .mem_addr_o   ( dmem_addr         ),
-                .mem_wdata_o  ( dmem_wdata        ),
-                .mem_gnt_i    ( dmem_gnt          ),
-                .mem_rvalid_i ( dmem_rvalid       ),
-                .mem_rdata_i  ( dmem_rdata        ),
-                .mem_err_i    ( dmem_err          )
+                .clk_i        ( vclk                 ),
+                .rst_ni       ( rst_ni               ),
+                .hold_mem_i   ( hold_mem             ),
+                .cpu_req_i    ( data_req             ),
+                .cpu_addr_i   ( data_addr            ),
+                .cpu_we_i     ( data_we              ),
+                .cpu_be_i     ( data_be              ),
+                .cpu_wdata_i  ( data_wdata           ),
+                .cpu_gnt_o    ( data_gnt             ),
+                .cpu_rvalid_o ( data_rvalid          ),
+                .cpu_rdata_o  ( data_rdata           ),
+                .cpu_err_o    ( data_err             ),
+                .mem_req_o    ( vc_dmem_req          ),
+                .mem_we_o     ( vc_dmem_we           ),
+                .mem_addr_o   ( vc_dmem_addr         ),
+                .mem_wdata_o  ( vc_dmem_wdata        ),
+                .mem_gnt_i    ( vc_dmem_gnt          ),
+                .mem_rvalid_i ( vc_dmem_rvalid       ),
+                .mem_rdata_i  ( vc_dmem_rdata        ),
+                .mem_err_i    ( vc_dmem_err          ),
+                .ctrl_req_i   ( vc_dcache_ctrl_req   ),
+                .ctrl_clean_i ( vc_dcache_ctrl_op[0] ),
+                .ctrl_inval_i ( vc_dcache_ctrl_op[1] ),
+                .ctrl_all_i   ( vc_dcache_ctrl_op[2] ),
+                .ctrl_start_i ( vc_dcache_ctrl_start ),
+                .ctrl_end_i   ( vc_dcache_ctrl_end   ),
+                .ctrl_gnt_o   ( vc_dcache_ctrl_gnt   ),
+                .ctrl_busy_o  ( vc_dcache_ctrl_busy  ),
+                .lock_i       ( vc_dcache_lock       ),
+                .miss_o       ( vc_dcache_miss       )
             );
-            assign dmem_be = '1;
+            assign vc_dmem_be = '1;
         end else begin
+            assign vc_dcache_ctrl_gnt  = 1'b1;
+            assign vc_dcache_ctrl_busy = 1'b0;
+            assign vc_dcache_miss      = 1'b0;
             if (MEM_W != VMEM_W) begin
                 $fatal(1, "If no data cache is used, the memory bus width MEM_W and the vector ",
                           "memory interface width VMEM_W must be equal.  ",
                           "Currently, MEM_W == %d and VMEM_W == %d.", MEM_W, VMEM_W);
             end
 
-            assign dmem_req    = data_req;
-            assign dmem_addr   = data_addr;
-            assign dmem_we     = data_we;
-            assign dmem_be     = data_be;
-            assign dmem_wdata  = data_wdata;
-            assign data_gnt    = dmem_gnt;
-            assign data_rvalid = dmem_rvalid;
-            assign data_rdata  = dmem_rdata;
-            assign data_err    = dmem_err;
+            assign vc_dmem_req   = data_req;
+            assign vc_dmem_addr  = data_addr;
+            assign vc_dmem_we    = data_we;
+            assign vc_dmem_be    = data_be;
+            assign vc_dmem_wdata = data_wdata;
+            assign data_gnt      = vc_dmem_gnt;
+            assign data_rvalid   = vc_dmem_rvalid;
+            assign data_rdata    = vc_dmem_rdata;
+            assign data_err      = vc_dmem_err;
         end
     endgenerate
 
@@ -434,19 +1346,69 @@ module vproc_top #(
     ///////////////////////////////////////////////////////////////////////////
     // Memory arbiter
 
+    // The memory accepts one request per cycle.  If both the instruction and
+    // the data interface request access, the arbitration policy MEM_ARB
+    // determines which one is granted:
+    // - "FIXED":    data requests always take precedence (instruction fetches
+    //               may starve during long streams of data requests)
+    // - "RR":       the interface that was not granted last takes precedence
+    // - "WEIGHTED": an interface keeps precedence for up to MEM_ARB_IWEIGHT
+    //               (instruction) or MEM_ARB_DWEIGHT (data) consecutive grants
+    // - "TDMA":     periods of MEM_ARB_IWEIGHT cycles reserved for instruction
+    //               requests alternate with MEM_ARB_DWEIGHT cycles reserved for
+    //               data requests; requests are only granted in their own
+    //               slots, hence the waiting time of either interface is
+    //               bounded independently of the traffic of the other one
+    localparam int unsigned ARB_IWEIGHT = (MEM_ARB == "RR") ? 1 : MEM_ARB_IWEIGHT;
+    localparam int unsigned ARB_DWEIGHT = (MEM_ARB == "RR") ? 1 : MEM_ARB_DWEIGHT;
+    localparam int unsigned ARB_CNT_W   = $clog2(ARB_IWEIGHT + ARB_DWEIGHT + 1);
+
+    logic                 arb_dmem_q; // last granted interface (RR and WEIGHTED)
+    logic [ARB_CNT_W-1:0] arb_cnt_q;  // consecutive grants of that interface or current TDMA slot
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (~rst_ni) begin
+            arb_dmem_q <= 1'b0;
+            arb_cnt_q  <= '0;
+        end else begin
+            if (MEM_ARB == "TDMA") begin
+                arb_cnt_q <= (arb_cnt_q == ARB_CNT_W'(ARB_IWEIGHT + ARB_DWEIGHT - 1)) ? '0 : arb_cnt_q + 1;
+            end
+            else if (imem_gnt | dmem_gnt) begin
+                arb_dmem_q <= dmem_gnt;
+                arb_cnt_q  <= 1;
+                if (dmem_gnt == arb_dmem_q) begin
+                    // saturate once the weight of the interface is exhausted
+                    arb_cnt_q <= (arb_cnt_q == ARB_CNT_W'(dmem_gnt ? ARB_DWEIGHT : ARB_IWEIGHT)) ? arb_cnt_q : arb_cnt_q + 1;
+                end
+            end
+        end
+    end
+
+    logic arb_prio_dmem; // data interface takes precedence
     always_comb begin
-        mem_req_o   = imem_req | dmem_req;
+        arb_prio_dmem = 1'b1;
+        if (MEM_ARB == "RR" || MEM_ARB == "WEIGHTED") begin
+            arb_prio_dmem = arb_dmem_q ? (arb_cnt_q < ARB_CNT_W'(ARB_DWEIGHT)) : (arb_cnt_q >= ARB_CNT_W'(ARB_IWEIGHT));
+        end
+        imem_gnt = imem_req & (~dmem_req | ~arb_prio_dmem);
+        dmem_gnt = dmem_req & (~imem_req |  arb_prio_dmem);
+        if (MEM_ARB == "TDMA") begin
+            imem_gnt = imem_req & (arb_cnt_q <  ARB_CNT_W'(ARB_IWEIGHT));
+            dmem_gnt = dmem_req & (arb_cnt_q >= ARB_CNT_W'(ARB_IWEIGHT));
+        end
+    end
+
+    always_comb begin
+        mem_req_o   = imem_gnt | dmem_gnt;
         mem_addr_o  = imem_addr;
         mem_we_o    = 1'b0;
         mem_be_o    = dmem_be;
         mem_wdata_o = dmem_wdata;
-        if (dmem_req) begin
+        if (dmem_gnt) begin
             mem_we_o   = dmem_we;
             mem_addr_o = dmem_addr;
         end
     end
-    assign imem_gnt = imem_req & ~dmem_req;
-    assign dmem_gnt =             dmem_req;
 
     // shift register keeping track of the source of mem requests for up to 32 cycles
     logic        req_sources  [32];
@@ -483,4 +1445,56 @@ module vproc_top #(
         (imem_req_addr[0][$clog2(MEM_W/8)-1:0] & {{$clog2(MEM_W/32){1'b1}}, 2'b00})*8 +: 32];
     assign dmem_rdata  = mem_rdata_i;
 
+
+`ifdef VPROC_PROFILE
+    ///////////////////////////////////////////////////////////////////////////
+    // ARBITRATION COUNTERS (simulation only, read by the Verilator harness)
+
+    // For each interface: the number of cycles with a pending request, the
+    // number of these cycles in which the request was not granted, and the
+    // longest run of consecutive such cycles
+    logic [31:0] prof_imem_req      /*verilator public*/;
+    logic [31:0] prof_imem_wait     /*verilator public*/;
+    logic [31:0] prof_imem_wait_max /*verilator public*/;
+    logic [31:0] prof_dmem_req      /*verilator public*/;
+    logic [31:0] prof_dmem_wait     /*verilator public*/;
+    logic [31:0] prof_dmem_wait_max /*verilator public*/;
+    logic [31:0] prof_imem_wait_cur, prof_dmem_wait_cur;
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (~rst_ni) begin
+            prof_imem_req      <= '0;
+            prof_imem_wait     <= '0;
+            prof_imem_wait_max <= '0;
+            prof_imem_wait_cur <= '0;
+            prof_dmem_req      <= '0;
+            prof_dmem_wait     <= '0;
+            prof_dmem_wait_max <= '0;
+            prof_dmem_wait_cur <= '0;
+        end else begin
+            prof_imem_wait_cur <= '0;
+            if (imem_req) begin
+                prof_imem_req <= prof_imem_req + 1;
+                if (~imem_gnt) begin
+                    prof_imem_wait     <= prof_imem_wait + 1;
+                    prof_imem_wait_cur <= prof_imem_wait_cur + 1;
+                    if (prof_imem_wait_cur == prof_imem_wait_max) begin
+                        prof_imem_wait_max <= prof_imem_wait_max + 1;
+                    end
+                end
+            end
+            prof_dmem_wait_cur <= '0;
+            if (dmem_req) begin
+                prof_dmem_req <= prof_dmem_req + 1;
+                if (~dmem_gnt) begin
+                    prof_dmem_wait     <= prof_dmem_wait + 1;
+                    prof_dmem_wait_cur <= prof_dmem_wait_cur + 1;
+                    if (prof_dmem_wait_cur == prof_dmem_wait_max) begin
+                        prof_dmem_wait_max <= prof_dmem_wait_max + 1;
+                    end
+                end
+            end
+        end
+    end
+`endif
+
 endmodule
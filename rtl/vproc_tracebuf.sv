@@ -0,0 +1,110 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// Trace buffer: records compact 32-bit entries of the following format while
+// recording is enabled:
+// - bits 31 to 26: instruction dispatched to the AES, ELEM, SLD, MUL, ALU, and
+//                  LSU, respectively
+// - bits 25 to 20: instruction completed by the AES, ELEM, SLD, MUL, ALU, and
+//                  LSU, respectively
+// - bit 19:        memory stall (vector memory request waiting for a grant)
+// - bits 18 to 0:  cycle stamp (lower 19 bits of the number of cycles since
+//                  recording was enabled)
+// An entry is written in every cycle in which an instruction is dispatched or
+// completed, the memory stall signal changes, or the cycle stamp wraps around
+// to zero (such that the full cycle count can be reconstructed).  Recording
+// stops when the buffer is full, in which case the overflow flag is set.
+// Entries are read in the order in which they were recorded.
+module vproc_tracebuf #(
+        parameter int unsigned       LEN     = 1024  // number of entries (power of two)
+    )(
+        input  logic                 clk_i,
+        input  logic                 rst_ni,
+
+        input  logic [5:0]           dispatch_i,    // {AES, ELEM, SLD, MUL, ALU, LSU}
+        input  logic [5:0]           complete_i,    // {AES, ELEM, SLD, MUL, ALU, LSU}
+        input  logic                 mem_stall_i,
+
+        input  logic                 ctl_we_i,      // write control register
+        input  logic [1:0]           ctl_i,         // {clear, enable}
+        output logic                 enable_o,
+        output logic                 overflow_o,
+        output logic [$clog2(LEN):0] count_o,       // number of entries
+
+        input  logic                 rd_i,          // remove the oldest entry
+        output logic [31:0]          rdata_o        // oldest entry
+    );
+
+    if (LEN < 2 || (LEN & (LEN - 1)) != 0) begin
+        $fatal(1, "The trace buffer length LEN must be a power of two.  ",
+                  "The current value of %d is invalid.", LEN);
+    end
+
+    localparam int unsigned STAMP_W = 19;
+
+    logic [31:0]              buf_q[LEN];
+    logic [$clog2(LEN)-1:0]   wr_ptr_q, rd_ptr_q;
+    logic [$clog2(LEN)  :0]   count_q;
+    logic                     enable_q, overflow_q, mem_stall_q;
+    logic [STAMP_W-1:0]       stamp_q;
+
+    logic rec, rd;
+    assign rec = enable_q & ((dispatch_i != '0) | (complete_i != '0) | (mem_stall_i != mem_stall_q) |
+                             (stamp_q == '0));
+    assign rd  = rd_i & (count_q != '0);
+
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (~rst_ni) begin
+            wr_ptr_q    <= '0;
+            rd_ptr_q    <= '0;
+            count_q     <= '0;
+            enable_q    <= 1'b0;
+            overflow_q  <= 1'b0;
+            mem_stall_q <= 1'b0;
+            stamp_q     <= '0;
+        end else begin
+            if (enable_q) begin
+                stamp_q     <= stamp_q + 1;
+                mem_stall_q <= mem_stall_i;
+            end
+            if (rec) begin
+                if (count_q == LEN) begin
+                    enable_q   <= 1'b0;
+                    overflow_q <= 1'b1;
+                end else begin
+                    wr_ptr_q <= wr_ptr_q + 1;
+                end
+            end
+            count_q  <= count_q + {{$clog2(LEN){1'b0}}, rec & (count_q != LEN)} - {{$clog2(LEN){1'b0}}, rd};
+            rd_ptr_q <= rd_ptr_q + {{($clog2(LEN)-1){1'b0}}, rd};
+            if (ctl_we_i) begin
+                // the cycle stamp restarts whenever recording is (re-)enabled
+                if (ctl_i[0] & ~enable_q) begin
+                    stamp_q     <= '0;
+                    mem_stall_q <= 1'b0;
+                end
+                enable_q <= ctl_i[0];
+                if (ctl_i[1]) begin
+                    wr_ptr_q   <= '0;
+                    rd_ptr_q   <= '0;
+                    count_q    <= '0;
+                    overflow_q <= 1'b0;
+                end
+            end
+        end
+    end
+
+    always_ff @(posedge clk_i) begin
+        if (rec & (count_q != LEN)) begin
+            buf_q[wr_ptr_q] <= {dispatch_i, complete_i, mem_stall_i, stamp_q};
+        end
+    end
+
+    assign enable_o   = enable_q;
+    assign overflow_o = overflow_q;
+    assign count_o    = count_q;
+    assign rdata_o    = buf_q[rd_ptr_q];
+
+endmodule
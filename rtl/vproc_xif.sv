@@ -0,0 +1,428 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// Extension interface of the vector unit: connects a main core with an
+// interface modelled after the CORE-V eXtension interface (CORE-V-XIF;
+// issue, commit, and result transactions) to the offload interface of
+// vproc_core.  The memory interface of CORE-V-XIF is not used, since
+// vproc_core accesses memory directly.
+//
+// Instructions are offered on the issue interface along with their scalar
+// operands and may be speculative, i.e., the main core signals later on the
+// commit interface whether an instruction is committed or killed.  An
+// instruction that has already been committed when it is offered (and that
+// is not preceded by buffered instructions) is passed directly to vproc_core,
+// hence it is accepted if vproc_core grants it as a legal instruction, as
+// with the native offload interface.  Speculative instructions are accepted
+// based on their opcode and buffered until they are committed (or dropped
+// when killed); if vproc_core refuses a committed instruction as illegal,
+// its result transaction signals an illegal instruction exception (exc set,
+// exccode 2).  A result is returned on the result interface for every
+// accepted instruction that is not killed; only instructions that write an x
+// register set the write enable of their result.
+//
+// Committed vector loads and stores that are still buffered have not reached
+// vproc_core yet and are hence not covered by its pending load and store
+// signals; they are reported separately, such that scalar memory accesses do
+// not overtake them.
+//
+// CSR instructions that access one of the CSRs listed in csr_addr_i are
+// executed by this module, with the same semantics as the external CSRs of
+// Ibex: csr_we_o is set for one cycle with the new value of the CSR in
+// csr_wdata_o.  Writing a read-only CSR (addresses 0xC00 to 0xFFF) is an
+// illegal instruction.
+module vproc_xif #(
+        parameter int unsigned    X_ID_W  = 4, // width of the instruction IDs
+        parameter int unsigned    BUF_SZ  = 2, // number of buffered speculative instructions
+        parameter int unsigned    CSR_CNT = 1  // number of CSRs
+    )(
+        input  logic              clk_i,
+        input  logic              rst_ni,
+
+        // issue interface
+        input  logic              xif_issue_valid_i,
+        output logic              xif_issue_ready_o,
+        input  logic [31:0]       xif_issue_instr_i,
+        input  logic [X_ID_W-1:0] xif_issue_id_i,
+        input  logic [31:0]       xif_issue_rs1_i,
+        input  logic [31:0]       xif_issue_rs2_i,
+        input  logic [1:0]        xif_issue_rs_valid_i,
+        output logic              xif_issue_accept_o,
+        output logic              xif_issue_writeback_o,
+
+        // commit interface
+        input  logic              xif_commit_valid_i,
+        input  logic [X_ID_W-1:0] xif_commit_id_i,
+        input  logic              xif_commit_kill_i,
+
+        // result interface
+        output logic              xif_result_valid_o,
+        input  logic              xif_result_ready_i,
+        output logic [X_ID_W-1:0] xif_result_id_o,
+        output logic [31:0]       xif_result_data_o,
+        output logic [4:0]        xif_result_rd_o,
+        output logic              xif_result_we_o,
+        output logic              xif_result_exc_o,
+        output logic [5:0]        xif_result_exccode_o,
+
+        // offload interface of vproc_core
+        output logic              instr_valid_o,
+        output logic [31:0]       instr_o,
+        output logic [31:0]       x_rs1_o,
+        output logic [31:0]       x_rs2_o,
+        input  logic              instr_gnt_i,
+        input  logic              instr_illegal_i,
+        input  logic              xreg_wait_i,
+        input  logic              xreg_valid_i,
+        input  logic [31:0]       xreg_i,
+
+        // committed vector loads and stores in the buffer
+        output logic              pending_load_o,
+        output logic              pending_store_o,
+
+        // CSRs
+        input  logic [11:0]       csr_addr_i [CSR_CNT],
+        input  logic [31:0]       csr_rdata_i[CSR_CNT],
+        output logic              csr_we_o   [CSR_CNT],
+        output logic [31:0]       csr_wdata_o[CSR_CNT]
+    );
+
+    if (BUF_SZ < 2) begin
+        $fatal(1, "The size BUF_SZ of the speculative instruction buffer must be at least 2.  ",
+                  "The current value of %d is invalid.", BUF_SZ);
+    end
+
+    localparam bit [6:0] OPC_LOAD_FP  = 7'h07;
+    localparam bit [6:0] OPC_STORE_FP = 7'h27;
+    localparam bit [6:0] OPC_VECTOR   = 7'h57;
+    localparam bit [6:0] OPC_VECTOR_E = 7'h77;
+    localparam bit [6:0] OPC_SYSTEM   = 7'h73;
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    // PRE-DECODING
+
+    // Vector instructions (OP-V, OP-VE, as well as LOAD-FP and STORE-FP with
+    // one of the vector widths) and CSR instructions accessing one of the CSRs are
+    // accepted, except for writes to read-only CSRs.  vsetvl[i] and the
+    // VWXUNARY0 instructions (vmv.x.s, vpopc, and vfirst) write an x register.
+    logic pd_vec, pd_csr, pd_wb;
+    always_comb begin
+        logic csr_hit;
+        csr_hit = 1'b0;
+        for (int i = 0; i < CSR_CNT; i++) begin
+            if (csr_addr_i[i] == xif_issue_instr_i[31:20]) begin
+                csr_hit = 1'b1;
+            end
+        end
+        pd_vec = (xif_issue_instr_i[6:0] == OPC_VECTOR) | (xif_issue_instr_i[6:0] == OPC_VECTOR_E) |
+                 (((xif_issue_instr_i[6:0] == OPC_LOAD_FP) | (xif_issue_instr_i[6:0] == OPC_STORE_FP)) &
+                  ((xif_issue_instr_i[14:12] == 3'b000) | (xif_issue_instr_i[14:12] >= 3'b101)));
+        pd_csr = (xif_issue_instr_i[6:0] == OPC_SYSTEM) & (xif_issue_instr_i[13:12] != 2'b00) & csr_hit &
+                 ~((xif_issue_instr_i[31:30] == 2'b11) &
+                   ((xif_issue_instr_i[13:12] == 2'b01) | (xif_issue_instr_i[19:15] != '0)));
+        pd_wb  = pd_csr ? (xif_issue_instr_i[11:7] != '0) :
+                 (xif_issue_instr_i[6:0] == OPC_VECTOR) & ((xif_issue_instr_i[14:12] == 3'b111) |
+                  ((xif_issue_instr_i[14:12] == 3'b010) & (xif_issue_instr_i[31:26] == 6'b010000)));
+    end
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    // SPECULATIVE INSTRUCTION BUFFER
+
+    typedef struct packed {
+        logic [X_ID_W-1:0] id;
+        logic [31:0]       instr;
+        logic [31:0]       rs1;
+        logic [31:0]       rs2;
+        logic              csr;        // CSR instruction
+        logic              wb;         // writes an x register
+    } buf_entry_t;
+
+    localparam int unsigned BUF_IDX_W = $clog2(BUF_SZ);
+
+    buf_entry_t           buf_q     [BUF_SZ];
+    logic                 buf_vld_q [BUF_SZ];
+    logic                 buf_cmt_q [BUF_SZ]; // commit transaction has occurred
+    logic                 buf_kill_q[BUF_SZ]; // killed by the commit transaction
+    logic [BUF_IDX_W-1:0] buf_rd_q, buf_wr_q;
+    logic [BUF_IDX_W  :0] buf_cnt_q;
+    logic                 buf_push, buf_pop;
+    buf_entry_t           buf_head;
+    assign buf_head = buf_q[buf_rd_q];
+
+    // A commit transaction may occur while the instruction is still offered
+    // on the issue interface, in which case it is retained until the issue
+    // transaction completes.
+    logic              ecommit_q, ecommit_kill_q;
+    logic [X_ID_W-1:0] ecommit_id_q;
+    logic              commit_now, issue_committed, issue_killed;
+    assign commit_now      = xif_commit_valid_i & (xif_commit_id_i == xif_issue_id_i);
+    assign issue_committed = commit_now | (ecommit_q & (ecommit_id_q == xif_issue_id_i));
+    assign issue_killed    = commit_now ? xif_commit_kill_i : ecommit_kill_q;
+
+    // pending result: either waiting for the x register result of vproc_core
+    // or held until the result transaction completes
+    logic              res_wait_q, res_valid_q;
+    logic              res_we_q, res_exc_q;
+    logic [X_ID_W-1:0] res_id_q;
+    logic [4:0]        res_rd_q;
+    logic [31:0]       res_data_q;
+    logic              res_busy;
+    assign res_busy = res_wait_q | (res_valid_q & ~xif_result_ready_i);
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    // ISSUE AND DISPATCH
+
+    // An offered instruction that is committed and not preceded by buffered
+    // instructions takes the direct path to vproc_core; committed buffered
+    // instructions are dispatched in order.
+    logic direct;
+    assign direct = xif_issue_valid_i & issue_committed & (buf_cnt_q == '0);
+
+    logic rs_ok;
+    assign rs_ok = &xif_issue_rs_valid_i;
+
+    logic disp_vec, disp_csr;   // dispatch a vector instruction or execute a CSR instruction
+    logic disp_skip;            // drop a killed instruction
+    logic disp_buf;             // dispatch from the buffer (otherwise the direct path is used)
+    assign disp_buf = buf_cnt_q != '0;
+    always_comb begin
+        xif_issue_ready_o     = 1'b0;
+        xif_issue_accept_o    = 1'b0;
+        xif_issue_writeback_o = 1'b0;
+        buf_push              = 1'b0;
+        disp_vec              = 1'b0;
+        disp_csr              = 1'b0;
+        disp_skip             = 1'b0;
+        if (~pd_vec & ~pd_csr) begin
+            // refused right away
+            xif_issue_ready_o = 1'b1;
+        end
+        else if (direct) begin
+            if (issue_killed) begin
+                xif_issue_ready_o = 1'b1;
+            end
+            else if (rs_ok & ~res_busy) begin
+                if (pd_csr) begin
+                    disp_csr              = 1'b1;
+                    xif_issue_ready_o     = 1'b1;
+                    xif_issue_accept_o    = 1'b1;
+                    xif_issue_writeback_o = pd_wb;
+                end else begin
+                    disp_vec              = 1'b1;
+                    xif_issue_ready_o     = instr_gnt_i;
+                    xif_issue_accept_o    = ~instr_illegal_i;
+                    xif_issue_writeback_o = xreg_wait_i & ~instr_illegal_i;
+                end
+            end
+        end
+        else if (rs_ok & (buf_cnt_q != (BUF_IDX_W+1)'(BUF_SZ))) begin
+            buf_push              = xif_issue_valid_i;
+            xif_issue_ready_o     = 1'b1;
+            xif_issue_accept_o    = 1'b1;
+            xif_issue_writeback_o = pd_wb;
+        end
+
+        // dispatch from the buffer
+        if (disp_buf & buf_cmt_q[buf_rd_q]) begin
+            if (buf_kill_q[buf_rd_q]) begin
+                disp_skip = 1'b1;
+            end
+            else if (~res_busy) begin
+                disp_csr = buf_head.csr;
+                disp_vec = ~buf_head.csr;
+            end
+        end
+    end
+
+    logic [X_ID_W-1:0] disp_id;
+    logic [31:0]       disp_instr;
+    logic              disp_wb;
+    always_comb begin
+        disp_id    = buf_head.id;
+        disp_instr = buf_head.instr;
+        x_rs1_o    = buf_head.rs1;
+        x_rs2_o    = buf_head.rs2;
+        disp_wb    = buf_head.wb;
+        if (~disp_buf) begin
+            disp_id    = xif_issue_id_i;
+            disp_instr = xif_issue_instr_i;
+            x_rs1_o    = xif_issue_rs1_i;
+            x_rs2_o    = xif_issue_rs2_i;
+            disp_wb    = pd_wb;
+        end
+    end
+    assign instr_valid_o = disp_vec;
+    assign instr_o       = disp_instr;
+
+    assign buf_pop = disp_buf & (disp_skip | disp_csr | (disp_vec & instr_gnt_i));
+
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (~rst_ni) begin
+            buf_rd_q       <= '0;
+            buf_wr_q       <= '0;
+            buf_cnt_q      <= '0;
+            ecommit_q      <= 1'b0;
+            ecommit_kill_q <= 1'b0;
+            ecommit_id_q   <= '0;
+            for (int i = 0; i < BUF_SZ; i++) begin
+                buf_vld_q [i] <= 1'b0;
+                buf_cmt_q [i] <= 1'b0;
+                buf_kill_q[i] <= 1'b0;
+            end
+        end else begin
+            // commit transactions of buffered instructions
+            for (int i = 0; i < BUF_SZ; i++) begin
+                if (xif_commit_valid_i & buf_vld_q[i] & ~buf_cmt_q[i] & (buf_q[i].id == xif_commit_id_i)) begin
+                    buf_cmt_q [i] <= 1'b1;
+                    buf_kill_q[i] <= xif_commit_kill_i;
+                end
+            end
+            if (buf_pop) begin
+                buf_vld_q[buf_rd_q] <= 1'b0;
+                buf_rd_q            <= (buf_rd_q == BUF_IDX_W'(BUF_SZ - 1)) ? '0 : buf_rd_q + 1;
+            end
+            if (buf_push) begin
+                buf_vld_q [buf_wr_q] <= 1'b1;
+                buf_cmt_q [buf_wr_q] <= issue_committed;
+                buf_kill_q[buf_wr_q] <= issue_killed;
+                buf_wr_q             <= (buf_wr_q == BUF_IDX_W'(BUF_SZ - 1)) ? '0 : buf_wr_q + 1;
+            end
+            buf_cnt_q <= buf_cnt_q + {{BUF_IDX_W{1'b0}}, buf_push} - {{BUF_IDX_W{1'b0}}, buf_pop};
+
+            // retain a commit transaction for the offered instruction until
+            // its issue transaction completes
+            if (~xif_issue_valid_i | xif_issue_ready_o) begin
+                ecommit_q <= 1'b0;
+            end
+            else if (commit_now) begin
+                ecommit_q      <= 1'b1;
+                ecommit_kill_q <= xif_commit_kill_i;
+                ecommit_id_q   <= xif_commit_id_i;
+            end
+        end
+    end
+    always_comb begin
+        pending_load_o  = 1'b0;
+        pending_store_o = 1'b0;
+        for (int i = 0; i < BUF_SZ; i++) begin
+            if (buf_vld_q[i] & buf_cmt_q[i] & ~buf_kill_q[i]) begin
+                if (buf_q[i].instr[6:0] == OPC_LOAD_FP) begin
+                    pending_load_o = 1'b1;
+                end
+                if (buf_q[i].instr[6:0] == OPC_STORE_FP) begin
+                    pending_store_o = 1'b1;
+                end
+            end
+        end
+    end
+    always_ff @(posedge clk_i) begin
+        if (buf_push) begin
+            buf_q[buf_wr_q].id    <= xif_issue_id_i;
+            buf_q[buf_wr_q].instr <= xif_issue_instr_i;
+            buf_q[buf_wr_q].rs1   <= xif_issue_rs1_i;
+            buf_q[buf_wr_q].rs2   <= xif_issue_rs2_i;
+            buf_q[buf_wr_q].csr   <= pd_csr;
+            buf_q[buf_wr_q].wb    <= pd_wb;
+        end
+    end
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    // CSR INSTRUCTIONS
+
+    logic [31:0] csr_old, csr_src, csr_new;
+    logic        csr_wr;
+    always_comb begin
+        csr_old = '0;
+        for (int i = 0; i < CSR_CNT; i++) begin
+            if (csr_addr_i[i] == disp_instr[31:20]) begin
+                csr_old = csr_rdata_i[i];
+            end
+        end
+        csr_src = disp_instr[14] ? {27'b0, disp_instr[19:15]} : x_rs1_o;
+        unique case (disp_instr[13:12])
+            2'b01:   csr_new = csr_src;
+            2'b10:   csr_new = csr_old |  csr_src;
+            default: csr_new = csr_old & ~csr_src;
+        endcase
+        // csrrs[i] and csrrc[i] do not write if the source is x0 or zero
+        csr_wr = (disp_instr[13:12] == 2'b01) | (disp_instr[19:15] != '0);
+        for (int i = 0; i < CSR_CNT; i++) begin
+            csr_we_o   [i] = disp_csr & csr_wr & (csr_addr_i[i] == disp_instr[31:20]);
+            csr_wdata_o[i] = csr_new;
+        end
+    end
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    // RESULTS
+
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (~rst_ni) begin
+            res_wait_q  <= 1'b0;
+            res_valid_q <= 1'b0;
+            res_we_q    <= 1'b0;
+            res_exc_q   <= 1'b0;
+            res_id_q    <= '0;
+            res_rd_q    <= '0;
+            res_data_q  <= '0;
+        end else begin
+            if (res_valid_q & xif_result_ready_i) begin
+                res_valid_q <= 1'b0;
+            end
+            if (res_wait_q & xreg_valid_i) begin
+                res_wait_q <= 1'b0;
+                if (~xif_result_ready_i) begin
+                    res_valid_q <= 1'b1;
+                    res_we_q    <= 1'b1;
+                    res_exc_q   <= 1'b0;
+                    res_data_q  <= xreg_i;
+                end
+            end
+            if ((disp_vec & instr_gnt_i) | disp_csr) begin
+                res_id_q <= disp_id;
+                res_rd_q <= disp_instr[11:7];
+            end
+            if (disp_vec & instr_gnt_i) begin
+                if (instr_illegal_i) begin
+                    // an instruction that has been accepted speculatively
+                    // raises an illegal instruction exception (instructions
+                    // on the direct path are simply not accepted)
+                    res_valid_q <= disp_buf;
+                    res_we_q    <= 1'b0;
+                    res_exc_q   <= 1'b1;
+                end
+                else if (xreg_wait_i) begin
+                    res_wait_q  <= 1'b1;
+                end else begin
+                    // instructions without x register result complete with
+                    // an empty result
+                    res_valid_q <= 1'b1;
+                    res_we_q    <= 1'b0;
+                    res_exc_q   <= 1'b0;
+                    res_data_q  <= '0;
+                end
+            end
+            if (disp_csr) begin
+                res_valid_q <= 1'b1;
+                res_we_q    <= disp_wb;
+                res_exc_q   <= 1'b0;
+                res_data_q  <= csr_old;
+            end
+        end
+    end
+
+    assign xif_result_valid_o   = res_valid_q | (res_wait_q & xreg_valid_i);
+    assign xif_result_id_o      = res_id_q;
+    assign xif_result_data_o    = res_valid_q ? res_data_q : xreg_i;
+    assign xif_result_rd_o      = res_rd_q;
+    assign xif_result_we_o      = res_valid_q ? res_we_q : 1'b1;
+    assign xif_result_exc_o     = res_valid_q & res_exc_q;
+    assign xif_result_exccode_o = xif_result_exc_o ? 6'd2 : 6'd0;
+
+endmodule
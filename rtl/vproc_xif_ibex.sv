@@ -0,0 +1,87 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// Adapter from the coprocessor interface of the Ibex fork (cpi_*) to the
+// extension interface of vproc_xif.  Ibex only offloads instructions that are
+// no longer speculative, hence each instruction is committed as soon as it is
+// offered.  vproc_xif thus passes it directly to vproc_core and whether the
+// instruction is legal is known when it is granted, as Ibex requires.  Ibex
+// waits for the result of instructions that write an x register before it
+// offloads further instructions, hence results are always accepted.  Results
+// without x register write (which vproc_xif returns for every instruction) are
+// not passed on to Ibex.
+module vproc_xif_ibex #(
+        parameter int unsigned    X_ID_W = 4   // width of the instruction IDs
+    )(
+        input  logic              clk_i,
+        input  logic              rst_ni,
+
+        // coprocessor interface of Ibex
+        input  logic              cpi_req_i,
+        input  logic [31:0]       cpi_instr_i,
+        input  logic [31:0]       cpi_rs1_i,
+        input  logic [31:0]       cpi_rs2_i,
+        output logic              cpi_gnt_o,
+        output logic              cpi_instr_illegal_o,
+        output logic              cpi_wait_o,
+        output logic              cpi_res_valid_o,
+        output logic [31:0]       cpi_res_o,
+
+        // extension interface
+        output logic              xif_issue_valid_o,
+        input  logic              xif_issue_ready_i,
+        output logic [31:0]       xif_issue_instr_o,
+        output logic [X_ID_W-1:0] xif_issue_id_o,
+        output logic [31:0]       xif_issue_rs1_o,
+        output logic [31:0]       xif_issue_rs2_o,
+        output logic [1:0]        xif_issue_rs_valid_o,
+        input  logic              xif_issue_accept_i,
+        input  logic              xif_issue_writeback_i,
+
+        output logic              xif_commit_valid_o,
+        output logic [X_ID_W-1:0] xif_commit_id_o,
+        output logic              xif_commit_kill_o,
+
+        input  logic              xif_result_valid_i,
+        output logic              xif_result_ready_o,
+        input  logic [31:0]       xif_result_data_i,
+        input  logic              xif_result_we_i
+    );
+
+    // ID of the offered instruction and whether it has been committed already
+    logic [X_ID_W-1:0] id_q;
+    logic              commit_sent_q;
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (~rst_ni) begin
+            id_q          <= '0;
+            commit_sent_q <= 1'b0;
+        end else begin
+            if (cpi_req_i & xif_issue_ready_i) begin
+                id_q <= id_q + 1;
+            end
+            commit_sent_q <= cpi_req_i & ~xif_issue_ready_i;
+        end
+    end
+
+    assign xif_issue_valid_o    = cpi_req_i;
+    assign xif_issue_instr_o    = cpi_instr_i;
+    assign xif_issue_id_o       = id_q;
+    assign xif_issue_rs1_o      = cpi_rs1_i;
+    assign xif_issue_rs2_o      = cpi_rs2_i;
+    assign xif_issue_rs_valid_o = 2'b11;
+
+    assign xif_commit_valid_o   = cpi_req_i & ~commit_sent_q;
+    assign xif_commit_id_o      = id_q;
+    assign xif_commit_kill_o    = 1'b0;
+
+    assign xif_result_ready_o   = 1'b1;
+
+    assign cpi_gnt_o            = cpi_req_i & xif_issue_ready_i;
+    assign cpi_instr_illegal_o  = ~xif_issue_accept_i;
+    assign cpi_wait_o           = xif_issue_writeback_i;
+    assign cpi_res_valid_o      = xif_result_valid_i & xif_result_we_i;
+    assign cpi_res_o            = xif_result_data_i;
+
+endmodule
@@ -57,7 +57,9 @@ lappend src_list "$vproc_dir/sim/vproc_tb.sv"
 foreach file {
     vproc_top.sv vproc_pkg.sv vproc_core.sv vproc_decoder.sv vproc_lsu.sv vproc_alu.sv
     vproc_mul.sv vproc_mul_block.sv vproc_sld.sv vproc_elem.sv vproc_hazards.sv vproc_vregfile.sv
-    vproc_vregpack.sv vproc_vregunpack.sv vproc_queue.sv vproc_cache.sv
+    vproc_vregpack.sv vproc_vregunpack.sv vproc_queue.sv vproc_cache.sv vproc_perfmon.sv
+    vproc_tracebuf.sv vproc_cdc_fifo.sv vproc_cdc_bridge.sv vproc_xif.sv vproc_xif_ibex.sv
+    vproc_aes.sv
 } {
     lappend src_list "$vproc_dir/rtl/$file"
 }
@@ -77,8 +79,18 @@ if {[string first "ibex" $core_dir] != -1} {
     lappend src_list "$core_dir/syn/rtl/prim_clock_gating.v"
     lappend src_list "$core_dir/vendor/lowrisc_ip/dv/sv/dv_utils/"
     lappend src_list "$core_dir/vendor/lowrisc_ip/ip/prim/rtl/"
+} elseif {[string first "cv32e40x" $core_dir] != -1} {
+    set main_core "cv32e40x"
+    foreach file [glob -directory "$core_dir/rtl" *.sv] {
+        lappend src_list $file
+    }
+    lappend src_list "$core_dir/bhv/cv32e40x_sim_clock_gate.sv"
+    lappend src_list "$core_dir/rtl/include/"
 }
 add_files -fileset $obj -norecurse -scan_for_includes $src_list
+if {$main_core == "cv32e40x"} {
+    set_property verilog_define VPROC_CV32E40X [get_filesets sim_1]
+}
 
 # configure simulation
 set_property top vproc_tb [get_filesets sim_1]
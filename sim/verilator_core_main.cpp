@@ -0,0 +1,376 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// Trace-driven harness for the vector core alone (without the main core)
+//
+// Vector instructions and their scalar operands are read from a trace file and
+// offloaded to vproc_core as fast as it accepts them, i.e., with ideal issue.
+// The only stalls besides those of the vector core itself are due to vector
+// instructions that return a result to the main core (vset[i]vl[i], vmv.x.s,
+// vpopc.m, vfirst.m), for which issuing waits until the result is available,
+// as the main core would.  The data memory interface of the vector core is
+// connected directly to the memory model of the harness.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <vector>
+#include "Vvproc_core.h"
+#include "verilated.h"
+#include "verilated_vcd_c.h"
+
+struct trace_instr {
+    uint32_t instr, x_rs1, x_rs2;
+    uint32_t xres;      // expected result (if has_xres is set)
+    bool     has_xres;
+};
+
+static bool read_trace(const char *path, std::vector<trace_instr> *trace);
+static bool read_vmem(const char *path, unsigned char *mem, int mem_sz);
+static bool core_busy(Vvproc_core *top);
+static void log_cycle(Vvproc_core *top, VerilatedVcdC* tfp);
+
+int main(int argc, char **argv) {
+    if (argc != 7 && argc != 8) {
+        fprintf(stderr, "Usage: %s TRACE_PATHS_LIST VMEM_W MEM_SZ MEM_LATENCY EXTRA_CYCLES STATS_FILE [WAVEFORM_FILE]\n", argv[0]);
+        return 1;
+    }
+
+    int vmem_w, mem_sz, mem_latency, extra_cycles;
+    {
+        char *endptr;
+        vmem_w = strtol(argv[2], &endptr, 10);
+        if (vmem_w < 32 || (vmem_w & (vmem_w - 1)) != 0 || *endptr != 0) {
+            fprintf(stderr, "ERROR: invalid VMEM_W argument\n");
+            return 1;
+        }
+        mem_sz = strtol(argv[3], &endptr, 10);
+        if (mem_sz == 0 || (mem_sz & (vmem_w/8 - 1)) != 0 || *endptr != 0) {
+            fprintf(stderr, "ERROR: invalid MEM_SZ argument\n");
+            return 1;
+        }
+        mem_latency = strtol(argv[4], &endptr, 10);
+        if (mem_latency < 1 || *endptr != 0) {
+            fprintf(stderr, "ERROR: invalid MEM_LATENCY argument\n");
+            return 1;
+        }
+        extra_cycles = strtol(argv[5], &endptr, 10);
+        if (*endptr != 0) {
+            fprintf(stderr, "ERROR: invalid EXTRA_CYCLES argument\n");
+            return 1;
+        }
+    }
+    int mem_bytes = vmem_w / 8;
+
+    Verilated::traceEverOn(true);
+
+    FILE *ftraces = fopen(argv[1], "r");
+    if (ftraces == NULL) {
+        fprintf(stderr, "ERROR: opening `%s': %s\n", argv[1], strerror(errno));
+        return 2;
+    }
+
+    // the statistics are appended, such that runs with different
+    // configurations can be collected in the same file
+    FILE *fstats = fopen(argv[6], "a");
+    if (fstats == NULL) {
+        fprintf(stderr, "ERROR: opening `%s': %s\n", argv[6], strerror(errno));
+        return 2;
+    }
+
+    unsigned char *mem = (unsigned char *)malloc(mem_sz);
+    if (mem == NULL) {
+        fprintf(stderr, "ERROR: allocating %d bytes of memory: %s\n", mem_sz, strerror(errno));
+        return 3;
+    }
+    // memory responses in flight (the data of each response is mem_bytes wide)
+    int           *mem_rvalid_queue = (int *)malloc(sizeof(int) * mem_latency);
+    int           *mem_err_queue    = (int *)malloc(sizeof(int) * mem_latency);
+    unsigned char *mem_rdata_queue  = (unsigned char *)malloc(mem_bytes * mem_latency);
+
+    // Verilator stores signals of any width in little-endian order (wide
+    // signals as arrays of 32-bit words), hence the data and byte enable
+    // signals of the memory interface are accessed as byte arrays
+    Vvproc_core *top = new Vvproc_core;
+    unsigned char *data_rdata = (unsigned char *)&top->data_rdata_i;
+    unsigned char *data_wdata = (unsigned char *)&top->data_wdata_o;
+    unsigned char *data_be    = (unsigned char *)&top->data_be_o;
+
+    VerilatedVcdC* tfp = NULL;
+#ifdef TRACE_VCD
+    if (argc == 8) {
+        tfp = new VerilatedVcdC;
+        top->trace(tfp, 99);  // Trace 99 levels of hierarchy
+        tfp->open(argv[7]);
+    }
+#endif
+
+    char *line = NULL, *trace_path = NULL, *mem_path = NULL, *dump_path = NULL;
+    size_t line_sz = 0;
+    while (getline(&line, &line_sz, ftraces) > 0) {
+        trace_path = (char *)realloc(trace_path, line_sz);
+        mem_path   = (char *)realloc(mem_path,   line_sz);
+        dump_path  = (char *)realloc(dump_path,  line_sz);
+
+        int dump_start = 0, dump_end = 0, items;
+        items = sscanf(line, "%s %s %s %x %x", trace_path, mem_path, dump_path, &dump_start, &dump_end);
+        if (items != 2 && items != 5)
+            continue;
+
+        std::vector<trace_instr> trace;
+        if (!read_trace(trace_path, &trace))
+            continue;
+        memset(mem, 0, mem_sz);
+        if (!read_vmem(mem_path, mem, mem_sz))
+            continue;
+
+        // simulate trace execution
+        int64_t cycles = 0, last_busy = 0;
+        int     illegal_cnt = 0, misaligned_cnt = 0, err_cnt = 0, xres_mismatch = 0;
+        {
+            int i;
+            for (i = 0; i < mem_latency; i++)
+                mem_rvalid_queue[i] = 0;
+            top->instr_valid_i    = 0;
+            top->csr_vstart_set_i = 0;
+            top->csr_vxrm_set_i   = 0;
+            top->csr_vxsat_set_i  = 0;
+            top->data_gnt_i       = 1;
+            top->data_rvalid_i    = 0;
+            top->data_err_i       = 0;
+            top->clk_i            = 0;
+            top->rst_ni           = 0;
+            for (i = 0; i < 10; i++) {
+                top->clk_i = 1;
+                top->eval();
+                top->clk_i = 0;
+                top->eval();
+                log_cycle(top, tfp);
+            }
+            top->rst_ni = 1;
+            top->eval();
+
+            size_t next      = 0;       // index of the next instruction to offload
+            bool   xreg_wait = false;   // waiting for a result of instruction next-1
+            int    idle_cnt  = 0;
+            while (next < trace.size() || xreg_wait || idle_cnt < extra_cycles) {
+                // offload the next instruction unless waiting for a result
+                bool issue = !xreg_wait && next < trace.size();
+                top->instr_valid_i = issue;
+                if (issue) {
+                    top->instr_i  = trace[next].instr;
+                    top->x_rs1_i  = trace[next].x_rs1;
+                    top->x_rs2_i  = trace[next].x_rs2;
+                }
+                top->eval();
+                bool gnt      = issue && top->instr_gnt_o;
+                bool gnt_wait = gnt && !top->instr_illegal_o && top->xreg_wait_o;
+                if (gnt && top->instr_illegal_o) {
+                    fprintf(stderr, "WARNING: illegal instruction %08x (trace `%s', instruction %d)\n",
+                            trace[next].instr, trace_path, (int)next + 1);
+                    illegal_cnt++;
+                }
+                if (xreg_wait && top->xreg_valid_o) {
+                    const trace_instr &prev = trace[next-1];
+                    if (prev.has_xres && prev.xres != top->xreg_o) {
+                        fprintf(stderr, "WARNING: result %08x of instruction %08x differs from expected %08x "
+                                        "(trace `%s', instruction %d)\n", top->xreg_o, prev.instr, prev.xres, trace_path,
+                                (int)next);
+                        xres_mismatch++;
+                    }
+                    xreg_wait = false;
+                }
+                if (top->misaligned_ls_o)
+                    misaligned_cnt++;
+
+                // read memory request
+                int addr = top->data_addr_o & ~(mem_bytes - 1);
+                int err  = (unsigned)top->data_addr_o >= (unsigned)mem_sz;
+                if (top->data_req_o && top->data_we_o && !err) {
+                    for (i = 0; i < mem_bytes; i++)
+                        if ((data_be[i/8] >> (i%8)) & 1)
+                            mem[addr+i] = data_wdata[i];
+                }
+                // the vector core expects a response only for reads
+                mem_rvalid_queue[0] = top->data_req_o && !top->data_we_o;
+                mem_err_queue   [0] = err;
+                for (i = 0; i < mem_bytes; i++)
+                    mem_rdata_queue[i] = err ? 0 : mem[addr+i];
+                if (top->data_req_o && err)
+                    err_cnt++;
+
+                // the core is busy while instructions remain to be offloaded
+                // or executed and while memory requests are in flight
+                bool busy = issue || xreg_wait || core_busy(top);
+                for (i = 0; i < mem_latency; i++)
+                    busy = busy || mem_rvalid_queue[i];
+
+                // rising clock edge
+                top->clk_i = 1;
+                top->eval();
+
+                // fulfill memory request
+                top->data_rvalid_i = mem_rvalid_queue[mem_latency-1];
+                top->data_err_i    = mem_err_queue   [mem_latency-1];
+                memcpy(data_rdata, mem_rdata_queue + mem_bytes * (mem_latency-1), mem_bytes);
+                top->eval();
+                for (i = mem_latency-1; i > 0; i--) {
+                    mem_rvalid_queue[i] = mem_rvalid_queue[i-1];
+                    mem_err_queue   [i] = mem_err_queue   [i-1];
+                    memcpy(mem_rdata_queue + mem_bytes * i, mem_rdata_queue + mem_bytes * (i-1), mem_bytes);
+                }
+
+                // falling clock edge
+                top->clk_i = 0;
+                top->eval();
+                log_cycle(top, tfp);
+
+                if (gnt) {
+                    next++;
+                    xreg_wait = gnt_wait;
+                }
+                cycles++;
+                if (busy) {
+                    last_busy = cycles;
+                    idle_cnt  = 0;
+                } else {
+                    idle_cnt++;
+                }
+            }
+        }
+
+        // one line TRACE;INSTRS;CYCLES;VREG_W;VMEM_W;MEM_LATENCY per trace,
+        // where TRACE is the name of the trace file without directory and
+        // extension and CYCLES counts the cycles until the vector core is idle
+        char *trace_name = strrchr(trace_path, '/');
+        trace_name = (trace_name == NULL) ? trace_path : trace_name + 1;
+        int trace_name_len = strcspn(trace_name, ".");
+        fprintf(fstats, "%.*s;%d;%lld;%d;%d;%d\n", trace_name_len, trace_name, (int)trace.size(),
+                (long long)last_busy, (int)top->csr_vlenb_o * 8, vmem_w, mem_latency);
+        printf("%.*s: %d instructions in %lld cycles (%.3f instructions per cycle)\n", trace_name_len, trace_name,
+               (int)trace.size(), (long long)last_busy, (last_busy > 0) ? (double)trace.size() / last_busy : 0.0);
+        if (illegal_cnt > 0 || misaligned_cnt > 0 || err_cnt > 0 || xres_mismatch > 0)
+            fprintf(stderr, "WARNING: %d illegal instructions, %d misaligned accesses, %d memory errors, "
+                            "%d result mismatches\n", illegal_cnt, misaligned_cnt, err_cnt, xres_mismatch);
+
+        // write dump file
+        if (items == 5) {
+            FILE *ftmp = fopen(dump_path, "w");
+            if (ftmp == NULL) {
+                fprintf(stderr, "ERROR: opening `%s': %s\n", dump_path, strerror(errno));
+                continue;
+            }
+            int addr;
+            for (addr = dump_start; addr < dump_end && addr + 4 <= mem_sz; addr += 4) {
+                int data = mem[addr] | (mem[addr+1] << 8) | (mem[addr+2] << 16) | (mem[addr+3] << 24);
+                fprintf(ftmp, "%08x\n", data);
+            }
+            fclose(ftmp);
+        }
+    }
+
+#ifdef TRACE_VCD
+    if (tfp != NULL)
+        tfp->close();
+#endif
+    top->final();
+    free(trace_path);
+    free(mem_path);
+    free(dump_path);
+    free(line);
+    free(mem);
+    free(mem_rvalid_queue);
+    free(mem_err_queue);
+    free(mem_rdata_queue);
+    fclose(fstats);
+    fclose(ftraces);
+    return 0;
+}
+
+vluint64_t main_time = 0;
+double sc_time_stamp() {
+    return main_time;
+}
+
+// read a trace file, which contains one line INSTR X_RS1 X_RS2 [XRES] of
+// hexadecimal values per vector instruction, where X_RS1 and X_RS2 are the
+// values of the scalar operands and XRES is the optional expected result of
+// instructions writing an x register; empty lines and lines starting with '#'
+// are ignored
+static bool read_trace(const char *path, std::vector<trace_instr> *trace) {
+    FILE *ftmp = fopen(path, "r");
+    if (ftmp == NULL) {
+        fprintf(stderr, "ERROR: opening `%s': %s\n", path, strerror(errno));
+        return false;
+    }
+    char buf[256];
+    int  line_no = 0;
+    while (fgets(buf, sizeof(buf), ftmp) != NULL) {
+        line_no++;
+        if (buf[0] == '#' || buf[0] == '\n' || buf[0] == 0)
+            continue;
+        trace_instr ti;
+        int items = sscanf(buf, "%x %x %x %x", &ti.instr, &ti.x_rs1, &ti.x_rs2, &ti.xres);
+        if (items < 3) {
+            fprintf(stderr, "ERROR: invalid line %d in trace `%s'\n", line_no, path);
+            fclose(ftmp);
+            return false;
+        }
+        ti.has_xres = items == 4;
+        trace->push_back(ti);
+    }
+    fclose(ftmp);
+    return true;
+}
+
+// read a memory initialization file (same format as for the main harness)
+static bool read_vmem(const char *path, unsigned char *mem, int mem_sz) {
+    FILE *ftmp = fopen(path, "r");
+    if (ftmp == NULL) {
+        fprintf(stderr, "ERROR: opening `%s': %s\n", path, strerror(errno));
+        return false;
+    }
+    char buf[256];
+    int addr = 0;
+    while (fgets(buf, sizeof(buf), ftmp) != NULL) {
+        if (buf[0] == '#' || buf[0] == '/')
+            continue;
+        char *ptr = buf;
+        if (buf[0] == '@') {
+            addr = strtol(ptr + 1, &ptr, 16) * 4;
+            while (*ptr == ' ')
+                ptr++;
+        }
+        while (*ptr != '\n' && *ptr != 0) {
+            int data = strtol(ptr, &ptr, 16);
+            int i;
+            for (i = 0; i < 4 && addr + i < mem_sz; i++)
+                mem[addr+i] = data >> (8*i);
+            addr += 4;
+            while (*ptr == ' ')
+                ptr++;
+        }
+    }
+    fclose(ftmp);
+    return true;
+}
+
+// the vector core is busy while a decoded instruction is buffered, while any
+// vector register is being read or written by an execution unit, and while
+// loads or stores are pending (instructions waiting in the queue are covered
+// by the hazards of the instructions ahead of them)
+static bool core_busy(Vvproc_core *top) {
+    return top->pending_load_o || top->pending_store_o || top->data_req_o || top->vproc_core__DOT__dec_buf_valid_q ||
+           top->vproc_core__DOT__vreg_rd_hazard_map_q != 0 || top->vproc_core__DOT__vreg_wr_hazard_map_q != 0;
+}
+
+static void log_cycle(Vvproc_core *top, VerilatedVcdC* tfp) {
+    main_time++;
+#ifdef TRACE_VCD
+    if (tfp != NULL)
+        tfp->dump(main_time);
+#endif
+}
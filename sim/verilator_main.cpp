@@ -11,9 +11,41 @@
 
 static void log_cycle(Vvproc_top *top, VerilatedVcdC* tfp, FILE *fcsv);
 
+// periods of the main clock clk_i and of the vector unit clock vclk_i (which
+// only drives the vector unit if vproc_top is built with VCLK_ASYNC set)
+#ifndef CLK_PERIOD
+#define CLK_PERIOD 10
+#endif
+#ifndef VCLK_PERIOD
+#define VCLK_PERIOD CLK_PERIOD
+#endif
+static vluint64_t clk_time, vclk_time; // time of the next edge of each clock
+static void clk_edge(Vvproc_top *top);
+
+#ifdef PROFILE
+// mask statistics of a program (accumulated over all masked instructions)
+struct prof_stats {
+    int64_t masked;     // number of masked instructions
+    int64_t elems;      // number of body elements (vl) of masked instructions
+    int64_t active;     // number of active body elements of masked instructions
+};
+static void prof_cycle(Vvproc_top *top, prof_stats *prof);
+#define PROF_ARGS 1
+#else
+#define PROF_ARGS 0
+#endif
+
+#ifdef TRACEBUF
+static void tracebuf_dump(Vvproc_top *top, FILE *ftrbuf);
+#define TRACEBUF_ARGS 1
+#else
+#define TRACEBUF_ARGS 0
+#endif
+
 int main(int argc, char **argv) {
-    if (argc != 7 && argc != 8) {
-        fprintf(stderr, "Usage: %s PROG_PATHS_LIST MEM_W MEM_SZ MEM_LATENCY EXTRA_CYCLES TRACE_FILE [WAVEFORM_FILE]\n", argv[0]);
+    if (argc != 7 + PROF_ARGS + TRACEBUF_ARGS && argc != 8 + PROF_ARGS + TRACEBUF_ARGS) {
+        fprintf(stderr, "Usage: %s PROG_PATHS_LIST MEM_W MEM_SZ MEM_LATENCY EXTRA_CYCLES TRACE_FILE%s%s [WAVEFORM_FILE]\n",
+                argv[0], PROF_ARGS ? " PROF_FILE" : "", TRACEBUF_ARGS ? " TRACEBUF_FILE" : "");
         return 1;
     }
 
@@ -58,6 +90,24 @@ int main(int argc, char **argv) {
     }
     fprintf(fcsv, "rst_ni;mem_req;mem_addr;vreg_rd_hazard_map_q;vreg_wr_hazard_map_q;state_init_q;\n");
 
+#ifdef PROFILE
+    // the profile is appended, such that runs with different configurations
+    // can be collected in the same file
+    FILE *fprof = fopen(argv[7], "a");
+    if (fprof == NULL) {
+        fprintf(stderr, "ERROR: opening `%s': %s\n", argv[7], strerror(errno));
+        return 2;
+    }
+#endif
+
+#ifdef TRACEBUF
+    FILE *ftrbuf = fopen(argv[7 + PROF_ARGS], "w");
+    if (ftrbuf == NULL) {
+        fprintf(stderr, "ERROR: opening `%s': %s\n", argv[7 + PROF_ARGS], strerror(errno));
+        return 2;
+    }
+#endif
+
     unsigned char *mem = (unsigned char *)malloc(mem_sz);
     if (mem == NULL) {
         fprintf(stderr, "ERROR: allocating %d bytes of memory: %s\n", mem_sz, strerror(errno));
@@ -70,10 +120,10 @@ int main(int argc, char **argv) {
     Vvproc_top *top = new Vvproc_top;
     VerilatedVcdC* tfp = NULL;
 #ifdef TRACE_VCD
-    if (argc == 8) {
+    if (argc == 8 + PROF_ARGS + TRACEBUF_ARGS) {
         tfp = new VerilatedVcdC;
         top->trace(tfp, 99);  // Trace 99 levels of hierarchy
-        tfp->open(argv[7]);
+        tfp->open(argv[7 + PROF_ARGS + TRACEBUF_ARGS]);
     }
 #endif
 
@@ -142,17 +192,23 @@ int main(int argc, char **argv) {
                 mem_rvalid_queue[i] = 0;
             top->mem_rvalid_i = 0;
             top->clk_i        = 0;
+            top->vclk_i       = 0;
             top->rst_ni       = 0;
-            for (i = 0; i < 10; i++) {
-                top->clk_i = 1;
-                top->eval();
-                top->clk_i = 0;
-                top->eval();
+            clk_time          = 0;
+            vclk_time         = 0;
+            // reset for at least 10 cycles of either clock
+            int rst_cycles = 10 * (VCLK_PERIOD > CLK_PERIOD ? (VCLK_PERIOD + CLK_PERIOD - 1) / CLK_PERIOD : 1);
+            for (i = 0; i < rst_cycles; i++) {
+                clk_edge(top);
+                clk_edge(top);
                 log_cycle(top, tfp, fcsv);
             }
             top->rst_ni = 1;
             top->eval();
 
+#ifdef PROFILE
+            prof_stats prof = {0, 0, 0};
+#endif
             int end_cnt = 0;
             while (end_cnt < extra_cycles) {
                 // read memory request
@@ -169,8 +225,7 @@ int main(int argc, char **argv) {
                     mem_rdata_queue[0] |= ((int64_t)mem[addr+i]) << (i*8);
 
                 // rising clock edge
-                top->clk_i = 1;
-                top->eval();
+                clk_edge(top);
 
                 // fulfill memory request
                 top->mem_rvalid_i = mem_rvalid_queue[mem_latency-1];
@@ -184,16 +239,36 @@ int main(int argc, char **argv) {
                 }
 
                 // falling clock edge
-                top->clk_i = 0;
-                top->eval();
+                clk_edge(top);
 
                 // log data
                 log_cycle(top, tfp, fcsv);
+#ifdef PROFILE
+                prof_cycle(top, &prof);
+#endif
 
                 if (end_cnt > 0 || (top->mem_req_o == 1 && top->mem_addr_o == 0)) {
                     end_cnt++;
                 }
             }
+
+#ifdef PROFILE
+            // one line PROG;MASKED;ELEMS;ACTIVE;IREQ;IWAIT;IWAIT_MAX;DREQ;DWAIT;DWAIT_MAX
+            // per program, where PROG is the name of the memory file without
+            // directory and extension, followed by the mask statistics and the
+            // arbitration counters of the instruction and data memory interface
+            char *prog_name = strrchr(prog_path, '/');
+            prog_name = (prog_name == NULL) ? prog_path : prog_name + 1;
+            int prog_name_len = strcspn(prog_name, ".");
+            fprintf(fprof, "%.*s;%lld;%lld;%lld;%u;%u;%u;%u;%u;%u\n", prog_name_len, prog_name,
+                    (long long)prof.masked, (long long)prof.elems, (long long)prof.active,
+                    top->vproc_top__DOT__prof_imem_req, top->vproc_top__DOT__prof_imem_wait,
+                    top->vproc_top__DOT__prof_imem_wait_max, top->vproc_top__DOT__prof_dmem_req,
+                    top->vproc_top__DOT__prof_dmem_wait, top->vproc_top__DOT__prof_dmem_wait_max);
+#endif
+#ifdef TRACEBUF
+            tracebuf_dump(top, ftrbuf);
+#endif
         }
 
         // write dump file
@@ -225,6 +300,12 @@ int main(int argc, char **argv) {
     free(mem_rdata_queue);
     free(mem_err_queue);
     fclose(fcsv);
+#ifdef PROFILE
+    fclose(fprof);
+#endif
+#ifdef TRACEBUF
+    fclose(ftrbuf);
+#endif
     fclose(fprogs);
     return 0;
 }
@@ -234,6 +315,24 @@ double sc_time_stamp() {
     return main_time;
 }
 
+// advance to the next edge of clk_i, toggling vclk_i on the way whenever its
+// next edge comes first; times count half time units, hence each clock toggles
+// once per period
+static void clk_edge(Vvproc_top *top) {
+    while (vclk_time < clk_time) {
+        top->vclk_i = !top->vclk_i;
+        top->eval();
+        vclk_time += VCLK_PERIOD;
+    }
+    top->clk_i = !top->clk_i;
+    if (vclk_time == clk_time) {
+        top->vclk_i = !top->vclk_i;
+        vclk_time  += VCLK_PERIOD;
+    }
+    top->eval();
+    clk_time += CLK_PERIOD;
+}
+
 static void log_cycle(Vvproc_top *top, VerilatedVcdC* tfp, FILE *fcsv) {
     fprintf(fcsv, "%d;%d;%08X;%08X;%08X;'{XX,'{X,X,X}},%d,X,'{X,X,X,X,X},X,XX,X,XXXXXXXX,'{X,'{XX,XXXXXXXX}},XX;\n",
             top->rst_ni, top->mem_req_o, top->mem_addr_o, top->vproc_top__DOT__v_core__DOT__vreg_rd_hazard_map_q, top->vproc_top__DOT__v_core__DOT__vreg_wr_hazard_map_q, 0);
@@ -243,3 +342,40 @@ static void log_cycle(Vvproc_top *top, VerilatedVcdC* tfp, FILE *fcsv) {
         tfp->dump(main_time);
 #endif
 }
+
+#ifdef PROFILE
+static void prof_cycle(Vvproc_top *top, prof_stats *prof) {
+    if (top->vproc_top__DOT__v_core__DOT__prof_masked) {
+        prof->masked++;
+        prof->elems  += top->vproc_top__DOT__v_core__DOT__prof_elems;
+        prof->active += top->vproc_top__DOT__v_core__DOT__prof_active;
+    }
+}
+#endif
+
+#ifdef TRACEBUF
+// read out the trace buffer and write its content in the same format in which
+// the demo system sends it over the UART (see demo/rtl/demo_top.sv), i.e., the
+// magic bytes "VTRC", the trace status word, and the entries (each 32-bit word
+// in little-endian byte order), with one byte per line in hexadecimal
+static void tracebuf_dump(Vvproc_top *top, FILE *ftrbuf) {
+    uint32_t stat = top->trace_stat_o;
+    uint32_t cnt  = stat & 0x3FFFFFFF;
+    if (cnt == 0)
+        return;
+    fprintf(ftrbuf, "%02x\n%02x\n%02x\n%02x\n", 'V', 'T', 'R', 'C');
+    for (int i = 0; i < 4; i++)
+        fprintf(ftrbuf, "%02x\n", (stat >> (8*i)) & 0xFF);
+    for (uint32_t j = 0; j < cnt; j++) {
+        uint32_t entry = top->trace_rdata_o;
+        for (int i = 0; i < 4; i++)
+            fprintf(ftrbuf, "%02x\n", (entry >> (8*i)) & 0xFF);
+        top->trace_rd_i = 1;
+        top->clk_i      = 1;
+        top->eval();
+        top->trace_rd_i = 0;
+        top->clk_i      = 0;
+        top->eval();
+    }
+}
+#endif
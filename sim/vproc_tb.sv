@@ -15,16 +15,30 @@ module vproc_tb #(
         parameter int unsigned ICACHE_SZ       = 0,   // instruction cache size in bytes
         parameter int unsigned ICACHE_LINE_W   = 128, // instruction cache line width in bits
         parameter int unsigned DCACHE_SZ       = 0,   // data cache size in bytes
-        parameter int unsigned DCACHE_LINE_W   = 512  // data cache line width in bits
+        parameter int unsigned DCACHE_LINE_W   = 512, // data cache line width in bits
+        parameter int unsigned DCACHE_SECTOR_W = DCACHE_LINE_W, // data cache sector width in bits
+        parameter              MEM_ARB         = "FIXED", // memory arbitration policy
+        parameter int unsigned MEM_ARB_IWEIGHT = 1,   // instruction weight or TDMA slot length
+        parameter int unsigned MEM_ARB_DWEIGHT = 1,   // data weight or TDMA slot length
+        parameter bit          AES_UNIT        = 1'b0, // vector AES unit
+        parameter int unsigned TRACE_BUF_LEN   = 0,   // trace buffer size (entries)
+        parameter bit          VCLK_ASYNC      = 1'b0,
+        parameter int unsigned VCLK_PERIOD     = 10   // vector unit clock period (if VCLK_ASYNC is set)
     );
 
-    logic clk, rst;
+    logic clk, vclk, rst;
     always begin
         clk = 1'b0;
         #5;
         clk = 1'b1;
         #5;
     end
+    always begin
+        vclk = 1'b0;
+        #(VCLK_PERIOD / 2.0);
+        vclk = 1'b1;
+        #(VCLK_PERIOD / 2.0);
+    end
 
     logic        mem_req;
     logic [31:0] mem_addr;
@@ -36,28 +50,42 @@ module vproc_tb #(
     logic [31:0] mem_rdata;
 
     vproc_top #(
-        .MEM_W         ( MEM_W                       ),
-        .MAIN_CORE     ( MAIN_CORE                   ),
-        .VREG_W        ( VREG_W                      ),
-        .VMEM_W        ( VMEM_W                      ),
-        .VMUL_W        ( VMUL_W                      ),
-        .RAM_TYPE      ( vproc_pkg::RAM_XLNX_RAM32M  ),
-        .MUL_TYPE      ( vproc_pkg::MUL_XLNX_DSP48E1 ),
-        .ICACHE_SZ     ( ICACHE_SZ                   ),
-        .ICACHE_LINE_W ( ICACHE_LINE_W               ),
-        .DCACHE_SZ     ( DCACHE_SZ                   ),
-        .DCACHE_LINE_W ( DCACHE_LINE_W               )
+        .MEM_W           ( MEM_W                       ),
+        .MAIN_CORE       ( MAIN_CORE                   ),
+        .VREG_W          ( VREG_W                      ),
+        .VMEM_W          ( VMEM_W                      ),
+        .VMUL_W          ( VMUL_W                      ),
+        .RAM_TYPE        ( vproc_pkg::RAM_XLNX_RAM32M  ),
+        .MUL_TYPE        ( vproc_pkg::MUL_XLNX_DSP48E1 ),
+        .ICACHE_SZ       ( ICACHE_SZ                   ),
+        .ICACHE_LINE_W   ( ICACHE_LINE_W               ),
+        .DCACHE_SZ       ( DCACHE_SZ                   ),
+        .DCACHE_LINE_W   ( DCACHE_LINE_W               ),
+        .DCACHE_SECTOR_W ( DCACHE_SECTOR_W             ),
+        .MEM_ARB         ( MEM_ARB                     ),
+        .MEM_ARB_IWEIGHT ( MEM_ARB_IWEIGHT             ),
+        .MEM_ARB_DWEIGHT ( MEM_ARB_DWEIGHT             ),
+        .AES_UNIT        ( AES_UNIT                    ),
+        .TRACE_BUF_LEN   ( TRACE_BUF_LEN               ),
+        .VCLK_ASYNC      ( VCLK_ASYNC                  )
     ) top (
-        .clk_i         ( clk                         ),
-        .rst_ni        ( ~rst                        ),
-        .mem_req_o     ( mem_req                     ),
-        .mem_addr_o    ( mem_addr                    ),
-        .mem_we_o      ( mem_we                      ),
-        .mem_be_o      ( mem_be                      ),
-        .mem_wdata_o   ( mem_wdata                   ),
-        .mem_rvalid_i  ( mem_rvalid                  ),
-        .mem_err_i     ( mem_err                     ),
-        .mem_rdata_i   ( mem_rdata                   )
+        .clk_i           ( clk                         ),
+        .vclk_i          ( vclk                        ),
+        .rst_ni          ( ~rst                        ),
+        .mem_req_o       ( mem_req                     ),
+        .mem_addr_o      ( mem_addr                    ),
+        .mem_we_o        ( mem_we                      ),
+        .mem_be_o        ( mem_be                      ),
+        .mem_wdata_o     ( mem_wdata                   ),
+        .mem_rvalid_i    ( mem_rvalid                  ),
+        .mem_err_i       ( mem_err                     ),
+        .mem_rdata_i     ( mem_rdata                   ),
+        .irq_fast_i      ( 15'b0                       ),
+        .trace_ctl_we_i  ( 1'b0                        ),
+        .trace_ctl_i     ( 2'b0                        ),
+        .trace_stat_o    (                             ),
+        .trace_rd_i      ( 1'b0                        ),
+        .trace_rdata_o   (                             )
     );
 
     // memory
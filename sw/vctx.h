@@ -0,0 +1,45 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+#ifndef VCTX_H
+#define VCTX_H
+
+#include <stdint.h>
+
+// Vector context switching support (see vctx.S and the custom CSRs vctx and
+// vdirty of vproc_top).  A context buffer holds vl, vtype, and vcsr followed
+// by the content of the 32 vector registers; VCTX_SIZE(vlenb) gives its size
+// in bytes for a vector register width of vlenb bytes.
+#define VCTX_HDR_SIZE       16
+#define VCTX_SIZE(vlenb)    (VCTX_HDR_SIZE + 32 * (vlenb))
+
+// vector context status (field VS of the CSR vctx, same encoding as the VS
+// field of mstatus)
+#define VCTX_VS_OFF         0
+#define VCTX_VS_INITIAL     1
+#define VCTX_VS_CLEAN       2
+#define VCTX_VS_DIRTY       3
+
+static inline uint32_t vctx_status(void) {
+    uint32_t vctx;
+    __asm__ volatile ("csrr %0, 0x7C6" : "=r"(vctx));
+    return vctx & 3;
+}
+
+static inline void vctx_set_status(uint32_t vs) {
+    __asm__ volatile ("csrw 0x7C6, %0" : : "r"(vs));
+}
+
+// save the complete vector state
+void vctx_save_all(void *ctx);
+
+// save the vector state if it is Dirty, but only the registers that have been
+// written since the buffer was last saved or restored; the state becomes Clean
+void vctx_save(void *ctx);
+
+// restore the complete vector state; the state becomes Clean
+void vctx_restore(const void *ctx);
+
+#endif // VCTX_H
@@ -0,0 +1,86 @@
+#!/bin/bash
+
+# Copyright TU Wien
+# Licensed under the ISC license, see LICENSE.txt for details
+# SPDX-License-Identifier: ISC
+
+
+# Cycle count regression check
+#
+# Usage: check_cycles.sh RESULTS BASELINE TOLERANCE [update]
+#
+# RESULTS is the results file written by the tests Makefile, which contains
+# one line per test and configuration with the fields CONFIG;TEST;CYCLES;STATUS
+# and BASELINE is the corresponding baseline file with the fields
+# CONFIG;TEST;CYCLES.  TOLERANCE is the permitted deviation in percent.
+#
+# The cycle count of each successful test is compared against the baseline.
+# Deviations beyond the tolerance are reported: an increase is reported as an
+# error (and the script exits with a non-zero status), while a decrease is
+# reported as a warning, since the baseline needs to be updated in that case.
+#
+# A baseline entry that is not a positive cycle count is an error as well,
+# whereas a missing baseline file and tests without a baseline entry are only
+# reported as a warning (the baseline is created by the update below).
+#
+# If the optional fourth argument is `update', then the baseline is updated
+# with the cycle counts of all successful tests in the results file instead.
+
+if [ "$#" != "3" ] && [ "$#" != "4" ]; then
+    echo "Usage: $0 RESULTS BASELINE TOLERANCE [update]" >&2
+    exit 2
+fi
+
+results="$1"
+baseline="$2"
+tolerance="$3"
+
+if [ ! -f "$results" ]; then
+    echo "[ ERROR ] results file \`$results' not found" >&2
+    exit 2
+fi
+
+if [ "$4" == "update" ]; then
+    tmp=`mktemp`
+    awk -F ';' '
+        FILENAME == ARGV[1] && NF >= 3 { cycles[$1 ";" $2] = $3 }
+        FILENAME == ARGV[2] && $4 == "SUCCESS" { cycles[$1 ";" $2] = $3 }
+        END { for (key in cycles) print key ";" cycles[key] }
+    ' <([ -f "$baseline" ] && cat "$baseline") "$results" | sort > "$tmp"
+    mv "$tmp" "$baseline"
+    echo "[ INFO  ] updated cycle baseline \`$baseline'"
+    exit 0
+fi
+
+if [ ! -f "$baseline" ]; then
+    echo "[WARNING] no cycle baseline \`$baseline'; create it by running with" \
+         "UPDATE_BASELINE set"
+    exit 0
+fi
+
+awk -F ';' -v tol="$tolerance" '
+    FILENAME == ARGV[1] && NF >= 3 { base[$1 ";" $2] = $3; next }
+    FILENAME == ARGV[2] && $4 == "SUCCESS" {
+        key = $1 ";" $2;
+        if (!(key in base)) {
+            printf "[WARNING] %-30s no baseline for config %s\n", $2, $1;
+            next;
+        }
+        if (base[key] <= 0) {
+            printf "[ ERROR ] %-30s invalid baseline %s for config %s\n", \
+                   $2, base[key], $1;
+            retval = 1;
+            next;
+        }
+        diff = ($3 - base[key]) * 100.0 / base[key];
+        if (diff > tol) {
+            printf "[ ERROR ] %-30s %9d cycles, baseline %9d (%+.1f%%); config %s\n", \
+                   $2, $3, base[key], diff, $1;
+            retval = 1;
+        } else if (diff < -tol) {
+            printf "[WARNING] %-30s %9d cycles, baseline %9d (%+.1f%%); update baseline\n", \
+                   $2, $3, base[key], diff;
+        }
+    }
+    END { exit retval }
+' "$baseline" "$results"
@@ -0,0 +1,96 @@
+#!/bin/bash
+
+# Copyright TU Wien
+# Licensed under the ISC license, see LICENSE.txt for details
+# SPDX-License-Identifier: ISC
+
+
+# Simulation of a set of programs (shared by the tests and the benchmarks)
+#
+# Usage: run_progs.sh NAME CYCLES CONFIG SIM_ARGS PROG...
+#
+# PROG... are the paths (without extension) of programs built with the
+# Makefile in sw/, i.e., PROG.elf and PROG.vmem exist.  All programs are
+# simulated in a single run of the simulation Makefile in sim/ with the
+# configuration CONFIG (a list of KEY=VAL pairs) and the additional arguments
+# SIM_ARGS (the simulator target and, e.g., CORE_DIR).  The memory between the
+# symbols vref_start and vref_end is written to PROG.ref.vmem and the memory
+# between vdata_start and vdata_end after execution to PROG.dump.vmem.
+#
+# For each program, one line `PROG CYCLES START END` is written to the file
+# CYCLES, where START and END delimit the execution of the program in the
+# trace (the main core is reset between programs).  Uncleared register
+# hazards at the end of the trace are reported as warnings, prefixed by NAME.
+# If the simulation fails, its log is printed and the script exits with a
+# non-zero status.
+
+if [ "$#" -lt "5" ]; then
+    echo "Usage: $0 NAME CYCLES CONFIG SIM_ARGS PROG..." >&2
+    exit 2
+fi
+
+script_dir="$(dirname "$(readlink -f "$0")")"
+name="$1"
+cycles_file="$2"
+config="$3"
+sim_args="$4"
+shift 4
+progs=("$@")
+
+symbol_addr() {
+    readelf -s "$1" | grep "$2" | sed 's/^.*\([A-Fa-f0-9]\{8\}\).*$/\1/'
+}
+
+rm -f progs.txt "$cycles_file"
+for prog in "${progs[@]}"; do
+    elf="$prog.elf"
+    memref="$prog.ref.vmem `symbol_addr $elf vref_start` `symbol_addr $elf vref_end`"
+    memo="$prog.dump.vmem `symbol_addr $elf vdata_start` `symbol_addr $elf vdata_end`"
+    echo "$prog.vmem $memref $memo " >> progs.txt
+done
+
+make -f "$script_dir/../sim/Makefile" $sim_args $config PROG_PATHS_LIST=progs.txt \
+    TRACE_SIGS="`cat "$script_dir/trace-sigs.conf"`" >sim.log 2>&1
+if [ "$?" != "0" ]; then
+    echo "[ ERROR ] $name simulation failed; content of sim.log:"
+    cat sim.log
+    exit 1
+fi
+
+for sig in rd wr; do
+    col=`head -n 1 sim_trace.csv | sed 's/;/\n/g' | grep -n vreg_${sig}_hazard_map_q |
+         awk -F ':' '{print $1}'`
+    desc=`[ "$sig" == "rd" ] && echo read || echo write`
+    if [[ "$col" =~ ^[0-9]+$ ]]; then
+        hazards=`tail -n 1 sim_trace.csv | awk -F ';' -v idx="$col" '{print $idx}'`
+        if [ "$hazards" != "00000000" ]; then
+            echo "[WARNING] $name uncleared $desc hazard(s) (0x${hazards})"
+        fi
+    else
+        echo "[WARNING] $name $desc hazards are not among traced signals"
+    fi
+done
+
+# the main core is held in reset between programs; each program starts in the
+# first cycle after a reset phase and ends with the next reset phase
+rst_col=`head -n 1 sim_trace.csv | sed 's/;/\n/g' | grep -n rst_ni |
+         awk -F ':' '{print $1}' | head -n 1`
+t_start=()
+t_end=()
+expected=0
+while IFS= read -r t_reset; do
+    if [[ $expected != 0 ]] && [[ $expected != $t_reset ]]; then
+        t_start+=($expected)
+        t_end+=($t_reset)
+    fi
+    expected=$(($t_reset + 1))
+done < <(awk -F ';' -v idx="$rst_col" '{print $idx}' sim_trace.csv | grep -n 0 |
+         awk -F ':' '{print $1}')
+t_start+=($expected)
+t_end+=(`wc -l sim_trace.csv | awk '{print $1}'`)
+
+for idx in "${!progs[@]}"; do
+    echo "${progs[$idx]} $((${t_end[$idx]} - ${t_start[$idx]})) ${t_start[$idx]} ${t_end[$idx]}" \
+        >> "$cycles_file"
+done
+exit 0
@@ -0,0 +1,138 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include "elf32.h"
+
+static uint32_t get32(const std::vector<uint8_t> &buf, uint32_t off) {
+    if (off + 4 > buf.size())
+        return 0;
+    return buf[off] | (buf[off+1] << 8) | (buf[off+2] << 16) | ((uint32_t)buf[off+3] << 24);
+}
+
+static uint16_t get16(const std::vector<uint8_t> &buf, uint32_t off) {
+    if (off + 2 > buf.size())
+        return 0;
+    return buf[off] | (buf[off+1] << 8);
+}
+
+bool elf_file::load(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        fprintf(stderr, "ERROR: opening `%s': %s\n", path, strerror(errno));
+        return false;
+    }
+    std::vector<uint8_t> buf;
+    {
+        uint8_t tmp[4096];
+        size_t  cnt;
+        while ((cnt = fread(tmp, 1, sizeof(tmp), f)) > 0)
+            buf.insert(buf.end(), tmp, tmp + cnt);
+    }
+    fclose(f);
+
+    // check ELF identification: magic, 32-bit class, little endian, RISC-V
+    if (buf.size() < 52 || memcmp(buf.data(), "\x7f" "ELF", 4) != 0 || buf[4] != 1 || buf[5] != 1 ||
+        get16(buf, 18) != 243) {
+        fprintf(stderr, "ERROR: `%s' is not a 32-bit little-endian RISC-V ELF file\n", path);
+        return false;
+    }
+    entry = get32(buf, 24);
+
+    // program headers (loadable segments)
+    uint32_t phoff = get32(buf, 28), phentsize = get16(buf, 42), phnum = get16(buf, 44);
+    for (uint32_t i = 0; i < phnum; i++) {
+        uint32_t ph = phoff + i * phentsize;
+        if (get32(buf, ph) != 1) // PT_LOAD
+            continue;
+        segment seg;
+        uint32_t offset = get32(buf, ph + 4), filesz = get32(buf, ph + 16);
+        seg.addr  = get32(buf, ph + 8);
+        seg.memsz = get32(buf, ph + 20);
+        seg.exec  = (get32(buf, ph + 24) & 1) != 0;
+        if (offset + filesz > buf.size()) {
+            fprintf(stderr, "ERROR: `%s': segment exceeds file size\n", path);
+            return false;
+        }
+        seg.data.assign(buf.begin() + offset, buf.begin() + offset + filesz);
+        seg.data.resize(seg.memsz, 0);
+        segs.push_back(seg);
+    }
+
+    // section headers (symbol table and associated string table)
+    uint32_t shoff = get32(buf, 32), shentsize = get16(buf, 46), shnum = get16(buf, 48);
+    for (uint32_t i = 0; i < shnum; i++) {
+        uint32_t sh = shoff + i * shentsize;
+        if (get32(buf, sh + 4) != 2) // SHT_SYMTAB
+            continue;
+        uint32_t symoff = get32(buf, sh + 16), symsz = get32(buf, sh + 20);
+        uint32_t strsh  = shoff + get32(buf, sh + 24) * shentsize;
+        uint32_t stroff = get32(buf, strsh + 16), strsz = get32(buf, strsh + 20);
+        for (uint32_t off = symoff; off + 16 <= symoff + symsz; off += 16) {
+            uint32_t name = get32(buf, off);
+            if (name == 0 || name >= strsz || stroff + name >= buf.size())
+                continue;
+            elf_symbol sym;
+            sym.name = std::string((const char *)buf.data() + stroff + name);
+            sym.addr = get32(buf, off + 4);
+            sym.size = get32(buf, off + 8);
+            sym.func = (buf[off + 12] & 0xF) == 2; // STT_FUNC
+            syms.push_back(sym);
+            if (sym.func || (is_text(sym.addr) && (buf[off + 12] & 0xF) == 0 && sym.name[0] != '.'))
+                funcs[sym.addr] = sym;
+        }
+    }
+    return true;
+}
+
+uint32_t elf_file::read32(uint32_t addr) const {
+    return read16(addr) | ((uint32_t)read16(addr + 2) << 16);
+}
+
+uint16_t elf_file::read16(uint32_t addr) const {
+    for (size_t i = 0; i < segs.size(); i++) {
+        if (addr >= segs[i].addr && addr + 2 <= segs[i].addr + segs[i].memsz)
+            return get16(segs[i].data, addr - segs[i].addr);
+    }
+    return 0;
+}
+
+bool elf_file::is_text(uint32_t addr) const {
+    for (size_t i = 0; i < segs.size(); i++) {
+        if (segs[i].exec && addr >= segs[i].addr && addr < segs[i].addr + segs[i].memsz)
+            return true;
+    }
+    return false;
+}
+
+bool elf_file::symbol(const char *name, uint32_t *addr) const {
+    for (size_t i = 0; i < syms.size(); i++) {
+        if (syms[i].name == name) {
+            *addr = syms[i].addr;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string elf_file::symbol_at(uint32_t addr) const {
+    std::map<uint32_t, elf_symbol>::const_iterator it = funcs.upper_bound(addr);
+    if (it == funcs.begin())
+        return "";
+    --it;
+    return it->second.name;
+}
+
+void elf_file::load_image(std::vector<uint8_t> &mem) const {
+    for (size_t i = 0; i < segs.size(); i++) {
+        for (uint32_t j = 0; j < segs[i].memsz; j++) {
+            uint32_t addr = segs[i].addr + j;
+            if (addr < mem.size())
+                mem[addr] = segs[i].data[j];
+        }
+    }
+}
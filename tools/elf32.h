@@ -0,0 +1,62 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// Minimal reader for statically linked 32-bit little-endian RISC-V ELF files
+
+#ifndef ELF32_H
+#define ELF32_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+
+struct elf_symbol {
+    std::string name;
+    uint32_t    addr;
+    uint32_t    size;
+    bool        func;   // symbol is a function
+};
+
+class elf_file {
+public:
+    // load an ELF file; returns false and prints an error message on failure
+    bool load(const char *path);
+
+    // read a 32-bit word or a 16-bit halfword from the loaded segments; bytes
+    // outside of any segment read as 0
+    uint32_t read32(uint32_t addr) const;
+    uint16_t read16(uint32_t addr) const;
+
+    // check whether an address lies within an executable segment
+    bool is_text(uint32_t addr) const;
+
+    // look up a symbol by name; returns false if the symbol does not exist
+    bool symbol(const char *name, uint32_t *addr) const;
+
+    // name of the symbol containing an address (empty string if none)
+    std::string symbol_at(uint32_t addr) const;
+
+    // function symbols sorted by address
+    const std::map<uint32_t, elf_symbol> &functions() const { return funcs; }
+
+    // copy the content of all loadable segments into a memory image
+    void load_image(std::vector<uint8_t> &mem) const;
+
+    uint32_t entry;
+
+private:
+    struct segment {
+        uint32_t             addr;
+        uint32_t             memsz;
+        bool                 exec;
+        std::vector<uint8_t> data;
+    };
+    std::vector<segment>           segs;
+    std::vector<elf_symbol>        syms;
+    std::map<uint32_t, elf_symbol> funcs;
+};
+
+#endif // ELF32_H
@@ -0,0 +1,535 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+#include <stdio.h>
+#include <string.h>
+#include "rv_instr.h"
+
+// flags of vector arithmetic instructions
+#define VF_WIDEN  1     // widening instruction
+#define VF_NARROW 2     // narrowing instruction
+#define VF_REDUCE 4     // reduction (or compress)
+#define VF_GATHER 8     // register gather
+#define VF_MASK   16    // mask register operation
+
+struct vop_info {
+    const char  *name;
+    instr_class  cls;
+    int          flags;
+};
+
+// OPIVV, OPIVX and OPIVI instructions indexed by funct6
+static const vop_info opi_table[64] = {
+    /* 000000 */ {"vadd",       INSTR_VALU,  0        },
+    /* 000001 */ {"vandn",      INSTR_VALU,  0        },
+    /* 000010 */ {"vsub",       INSTR_VALU,  0        },
+    /* 000011 */ {"vrsub",      INSTR_VALU,  0        },
+    /* 000100 */ {"vminu",      INSTR_VALU,  0        },
+    /* 000101 */ {"vmin",       INSTR_VALU,  0        },
+    /* 000110 */ {"vmaxu",      INSTR_VALU,  0        },
+    /* 000111 */ {"vmax",       INSTR_VALU,  0        },
+    /* 001000 */ {NULL,         INSTR_ILLEGAL, 0      },
+    /* 001001 */ {"vand",       INSTR_VALU,  0        },
+    /* 001010 */ {"vor",        INSTR_VALU,  0        },
+    /* 001011 */ {"vxor",       INSTR_VALU,  0        },
+    /* 001100 */ {"vrgather",   INSTR_VELEM, VF_GATHER},
+    /* 001101 */ {NULL,         INSTR_ILLEGAL, 0      },
+    /* 001110 */ {"vslideup",   INSTR_VSLD,  0        },
+    /* 001111 */ {"vslidedown", INSTR_VSLD,  0        },
+    /* 010000 */ {"vadc",       INSTR_VALU,  0        },
+    /* 010001 */ {"vmadc",      INSTR_VALU,  0        },
+    /* 010010 */ {"vsbc",       INSTR_VALU,  0        },
+    /* 010011 */ {"vmsbc",      INSTR_VALU,  0        },
+    /* 010100 */ {"vror",       INSTR_VALU,  0        },
+    /* 010101 */ {"vrol",       INSTR_VALU,  0        },
+    /* 010110 */ {NULL,         INSTR_ILLEGAL, 0      },
+    /* 010111 */ {"vmerge",     INSTR_VALU,  0        },
+    /* 011000 */ {"vmseq",      INSTR_VALU,  0        },
+    /* 011001 */ {"vmsne",      INSTR_VALU,  0        },
+    /* 011010 */ {"vmsltu",     INSTR_VALU,  0        },
+    /* 011011 */ {"vmslt",      INSTR_VALU,  0        },
+    /* 011100 */ {"vmsleu",     INSTR_VALU,  0        },
+    /* 011101 */ {"vmsle",      INSTR_VALU,  0        },
+    /* 011110 */ {"vmsgtu",     INSTR_VALU,  0        },
+    /* 011111 */ {"vmsgt",      INSTR_VALU,  0        },
+    /* 100000 */ {"vsaddu",     INSTR_VALU,  0        },
+    /* 100001 */ {"vsadd",      INSTR_VALU,  0        },
+    /* 100010 */ {"vssubu",     INSTR_VALU,  0        },
+    /* 100011 */ {"vssub",      INSTR_VALU,  0        },
+    /* 100100 */ {NULL,         INSTR_ILLEGAL, 0      },
+    /* 100101 */ {"vsll",       INSTR_VALU,  0        },
+    /* 100110 */ {NULL,         INSTR_ILLEGAL, 0      },
+    /* 100111 */ {"vsmul",      INSTR_VMUL,  0        },
+    /* 101000 */ {"vsrl",       INSTR_VALU,  0        },
+    /* 101001 */ {"vsra",       INSTR_VALU,  0        },
+    /* 101010 */ {"vssrl",      INSTR_VALU,  0        },
+    /* 101011 */ {"vssra",      INSTR_VALU,  0        },
+    /* 101100 */ {"vnsrl",      INSTR_VALU,  VF_NARROW},
+    /* 101101 */ {"vnsra",      INSTR_VALU,  VF_NARROW},
+    /* 101110 */ {"vnclipu",    INSTR_VALU,  VF_NARROW},
+    /* 101111 */ {"vnclip",     INSTR_VALU,  VF_NARROW},
+};
+
+// OPMVV and OPMVX instructions indexed by funct6
+static const vop_info opm_table[64] = {
+    /* 000000 */ {"vredsum",    INSTR_VELEM, VF_REDUCE},
+    /* 000001 */ {"vredand",    INSTR_VELEM, VF_REDUCE},
+    /* 000010 */ {"vredor",     INSTR_VELEM, VF_REDUCE},
+    /* 000011 */ {"vredxor",    INSTR_VELEM, VF_REDUCE},
+    /* 000100 */ {"vredminu",   INSTR_VELEM, VF_REDUCE},
+    /* 000101 */ {"vredmin",    INSTR_VELEM, VF_REDUCE},
+    /* 000110 */ {"vredmaxu",   INSTR_VELEM, VF_REDUCE},
+    /* 000111 */ {"vredmax",    INSTR_VELEM, VF_REDUCE},
+    /* 001000 */ {"vaaddu",     INSTR_VALU,  0        },
+    /* 001001 */ {"vaadd",      INSTR_VALU,  0        },
+    /* 001010 */ {"vasubu",     INSTR_VALU,  0        },
+    /* 001011 */ {"vasub",      INSTR_VALU,  0        },
+    /* 001100 */ {"vclmul",     INSTR_VMUL,  0        },
+    /* 001101 */ {"vclmulh",    INSTR_VMUL,  0        },
+    /* 001110 */ {"vslide1up",  INSTR_VSLD,  0        },
+    /* 001111 */ {"vslide1down",INSTR_VSLD,  0        },
+    /* 010000 */ {NULL,         INSTR_ILLEGAL, 0      }, // VWXUNARY0, VRXUNARY0
+    /* 010001 */ {NULL,         INSTR_ILLEGAL, 0      },
+    /* 010010 */ {NULL,         INSTR_ILLEGAL, 0      }, // VXUNARY0
+    /* 010011 */ {NULL,         INSTR_ILLEGAL, 0      },
+    /* 010100 */ {NULL,         INSTR_ILLEGAL, 0      }, // VMUNARY0
+    /* 010101 */ {NULL,         INSTR_ILLEGAL, 0      },
+    /* 010110 */ {NULL,         INSTR_ILLEGAL, 0      },
+    /* 010111 */ {"vcompress",  INSTR_VELEM, VF_REDUCE},
+    /* 011000 */ {"vmandnot",   INSTR_VALU,  VF_MASK  },
+    /* 011001 */ {"vmand",      INSTR_VALU,  VF_MASK  },
+    /* 011010 */ {"vmor",       INSTR_VALU,  VF_MASK  },
+    /* 011011 */ {"vmxor",      INSTR_VALU,  VF_MASK  },
+    /* 011100 */ {"vmornot",    INSTR_VALU,  VF_MASK  },
+    /* 011101 */ {"vmnand",     INSTR_VALU,  VF_MASK  },
+    /* 011110 */ {"vmnor",      INSTR_VALU,  VF_MASK  },
+    /* 011111 */ {"vmxnor",     INSTR_VALU,  VF_MASK  },
+    /* 100000 */ {NULL,         INSTR_ILLEGAL, 0      },
+    /* 100001 */ {NULL,         INSTR_ILLEGAL, 0      },
+    /* 100010 */ {NULL,         INSTR_ILLEGAL, 0      },
+    /* 100011 */ {NULL,         INSTR_ILLEGAL, 0      },
+    /* 100100 */ {"vmulhu",     INSTR_VMUL,  0        },
+    /* 100101 */ {"vmul",       INSTR_VMUL,  0        },
+    /* 100110 */ {"vmulhsu",    INSTR_VMUL,  0        },
+    /* 100111 */ {"vmulh",      INSTR_VMUL,  0        },
+    /* 101000 */ {NULL,         INSTR_ILLEGAL, 0      },
+    /* 101001 */ {"vmadd",      INSTR_VMUL,  0        },
+    /* 101010 */ {NULL,         INSTR_ILLEGAL, 0      },
+    /* 101011 */ {"vnmsub",     INSTR_VMUL,  0        },
+    /* 101100 */ {NULL,         INSTR_ILLEGAL, 0      },
+    /* 101101 */ {"vmacc",      INSTR_VMUL,  0        },
+    /* 101110 */ {NULL,         INSTR_ILLEGAL, 0      },
+    /* 101111 */ {"vnmsac",     INSTR_VMUL,  0        },
+    /* 110000 */ {"vwaddu",     INSTR_VALU,  VF_WIDEN },
+    /* 110001 */ {"vwadd",      INSTR_VALU,  VF_WIDEN },
+    /* 110010 */ {"vwsubu",     INSTR_VALU,  VF_WIDEN },
+    /* 110011 */ {"vwsub",      INSTR_VALU,  VF_WIDEN },
+    /* 110100 */ {"vwaddu.w",   INSTR_VALU,  VF_WIDEN },
+    /* 110101 */ {"vwadd.w",    INSTR_VALU,  VF_WIDEN },
+    /* 110110 */ {"vwsubu.w",   INSTR_VALU,  VF_WIDEN },
+    /* 110111 */ {"vwsub.w",    INSTR_VALU,  VF_WIDEN },
+    /* 111000 */ {"vwmulu",     INSTR_VMUL,  VF_WIDEN },
+    /* 111001 */ {NULL,         INSTR_ILLEGAL, 0      },
+    /* 111010 */ {"vwmulsu",    INSTR_VMUL,  VF_WIDEN },
+    /* 111011 */ {"vwmul",      INSTR_VMUL,  VF_WIDEN },
+    /* 111100 */ {"vwmaccu",    INSTR_VMUL,  VF_WIDEN },
+    /* 111101 */ {"vwmacc",     INSTR_VMUL,  VF_WIDEN },
+    /* 111110 */ {"vwmaccus",   INSTR_VMUL,  VF_WIDEN },
+    /* 111111 */ {"vwmaccsu",   INSTR_VMUL,  VF_WIDEN },
+};
+
+// expand a compressed instruction to the equivalent 32-bit instruction;
+// returns 0 for illegal or unsupported instructions
+static uint32_t expand_compressed(uint32_t c) {
+    uint32_t rd  = (c >> 7) & 0x1F, rs2 = (c >> 2) & 0x1F;
+    uint32_t rdp = 8 + ((c >> 2) & 7), rs1p = 8 + ((c >> 7) & 7);
+    int32_t  imm6 = (int32_t)((((c >> 12) & 1) << 5) | ((c >> 2) & 0x1F)) << 26 >> 26;
+    switch (((c & 3) << 3) | ((c >> 13) & 7)) {
+        case 0x00: { // c.addi4spn -> addi rd', x2, nzuimm
+            uint32_t imm = (((c >> 11) & 3) << 4) | (((c >> 7) & 0xF) << 6) | (((c >> 6) & 1) << 2) | (((c >> 5) & 1) << 3);
+            if (imm == 0)
+                return 0;
+            return (imm << 20) | (2 << 15) | (rdp << 7) | 0x13;
+        }
+        case 0x02: { // c.lw -> lw rd', uimm(rs1')
+            uint32_t imm = (((c >> 10) & 7) << 3) | (((c >> 6) & 1) << 2) | (((c >> 5) & 1) << 6);
+            return (imm << 20) | (rs1p << 15) | (2 << 12) | (rdp << 7) | 0x03;
+        }
+        case 0x06: { // c.sw -> sw rs2', uimm(rs1')
+            uint32_t imm = (((c >> 10) & 7) << 3) | (((c >> 6) & 1) << 2) | (((c >> 5) & 1) << 6);
+            return ((imm >> 5) << 25) | (rdp << 20) | (rs1p << 15) | (2 << 12) | ((imm & 0x1F) << 7) | 0x23;
+        }
+        case 0x08: // c.addi -> addi rd, rd, imm
+            return ((uint32_t)imm6 << 20) | (rd << 15) | (rd << 7) | 0x13;
+        case 0x09: // c.jal -> jal x1, offset
+        case 0x0D: { // c.j -> jal x0, offset
+            uint32_t off = (((c >> 12) & 1) << 11) | (((c >> 11) & 1) << 4) | (((c >> 9) & 3) << 8) |
+                           (((c >> 8) & 1) << 10) | (((c >> 7) & 1) << 6) | (((c >> 6) & 1) << 7) |
+                           (((c >> 3) & 7) << 1) | (((c >> 2) & 1) << 5);
+            int32_t  imm = (int32_t)(off << 20) >> 20;
+            uint32_t enc = (((uint32_t)imm >> 20) & 1) << 31 | ((imm >> 1) & 0x3FF) << 21 |
+                           ((imm >> 11) & 1) << 20 | ((imm >> 12) & 0xFF) << 12;
+            return enc | ((((c >> 13) & 7) == 1 ? 1u : 0u) << 7) | 0x6F;
+        }
+        case 0x0A: // c.li -> addi rd, x0, imm
+            return ((uint32_t)imm6 << 20) | (rd << 7) | 0x13;
+        case 0x0B: // c.addi16sp or c.lui
+            if (rd == 2) {
+                uint32_t off = (((c >> 12) & 1) << 9) | (((c >> 6) & 1) << 4) | (((c >> 5) & 1) << 6) |
+                               (((c >> 3) & 3) << 7) | (((c >> 2) & 1) << 5);
+                int32_t  imm = (int32_t)(off << 22) >> 22;
+                if (imm == 0)
+                    return 0;
+                return ((uint32_t)imm << 20) | (2 << 15) | (2 << 7) | 0x13;
+            }
+            if (imm6 == 0)
+                return 0;
+            return (((uint32_t)imm6 << 12) & 0xFFFFF000) | (rd << 7) | 0x37;
+        case 0x0C: { // arithmetic on rd'
+            uint32_t funct2 = (c >> 10) & 3;
+            if (funct2 == 0) // c.srli
+                return (((c >> 2) & 0x1F) << 20) | (rs1p << 15) | (5 << 12) | (rs1p << 7) | 0x13;
+            if (funct2 == 1) // c.srai
+                return (0x20 << 25) | (((c >> 2) & 0x1F) << 20) | (rs1p << 15) | (5 << 12) | (rs1p << 7) | 0x13;
+            if (funct2 == 2) // c.andi
+                return ((uint32_t)imm6 << 20) | (rs1p << 15) | (7 << 12) | (rs1p << 7) | 0x13;
+            if ((c >> 12) & 1)
+                return 0;
+            switch ((c >> 5) & 3) {
+                case 0: return (0x20 << 25) | (rdp << 20) | (rs1p << 15) | (0 << 12) | (rs1p << 7) | 0x33; // c.sub
+                case 1: return                (rdp << 20) | (rs1p << 15) | (4 << 12) | (rs1p << 7) | 0x33; // c.xor
+                case 2: return                (rdp << 20) | (rs1p << 15) | (6 << 12) | (rs1p << 7) | 0x33; // c.or
+                default: return               (rdp << 20) | (rs1p << 15) | (7 << 12) | (rs1p << 7) | 0x33; // c.and
+            }
+        }
+        case 0x0E: // c.beqz -> beq rs1', x0, offset
+        case 0x0F: { // c.bnez -> bne rs1', x0, offset
+            uint32_t off = (((c >> 12) & 1) << 8) | (((c >> 10) & 3) << 3) | (((c >> 5) & 3) << 6) |
+                           (((c >> 3) & 3) << 1) | (((c >> 2) & 1) << 5);
+            int32_t  imm = (int32_t)(off << 23) >> 23;
+            uint32_t enc = (((uint32_t)imm >> 12) & 1) << 31 | ((imm >> 5) & 0x3F) << 25 |
+                           ((imm >> 1) & 0xF) << 8 | ((imm >> 11) & 1) << 7;
+            return enc | (rs1p << 15) | ((((c >> 13) & 7) == 7 ? 1u : 0u) << 12) | 0x63;
+        }
+        case 0x10: // c.slli -> slli rd, rd, shamt
+            return (((c >> 2) & 0x1F) << 20) | (rd << 15) | (1 << 12) | (rd << 7) | 0x13;
+        case 0x12: { // c.lwsp -> lw rd, uimm(x2)
+            uint32_t imm = (((c >> 12) & 1) << 5) | (((c >> 4) & 7) << 2) | (((c >> 2) & 3) << 6);
+            if (rd == 0)
+                return 0;
+            return (imm << 20) | (2 << 15) | (2 << 12) | (rd << 7) | 0x03;
+        }
+        case 0x14:
+            if (((c >> 12) & 1) == 0) {
+                if (rs2 == 0) // c.jr -> jalr x0, 0(rs1)
+                    return rd == 0 ? 0 : (rd << 15) | 0x67;
+                return (rs2 << 20) | (rd << 7) | 0x33; // c.mv -> add rd, x0, rs2
+            }
+            if (rd == 0 && rs2 == 0) // c.ebreak
+                return 0x00100073;
+            if (rs2 == 0) // c.jalr -> jalr x1, 0(rs1)
+                return (rd << 15) | (1 << 7) | 0x67;
+            return (rs2 << 20) | (rd << 15) | (rd << 7) | 0x33; // c.add
+        case 0x16: { // c.swsp -> sw rs2, uimm(x2)
+            uint32_t imm = (((c >> 9) & 0xF) << 2) | (((c >> 7) & 3) << 6);
+            return ((imm >> 5) << 25) | (rs2 << 20) | (2 << 15) | (2 << 12) | ((imm & 0x1F) << 7) | 0x23;
+        }
+        default:
+            return 0;
+    }
+}
+
+static bool decode_vector(uint32_t raw, rv_instr *instr) {
+    uint32_t funct3 = (raw >> 12) & 7, funct6 = raw >> 26, vs1 = (raw >> 15) & 0x1F;
+    instr->vmasked = ((raw >> 25) & 1) == 0;
+    instr->rd      = (raw >> 7) & 0x1F;
+    instr->rs1     = vs1;
+    instr->rs2     = (raw >> 20) & 0x1F;
+
+    // vector loads and stores
+    if ((raw & 0x7F) == 0x07 || (raw & 0x7F) == 0x27) {
+        bool store = (raw & 0x7F) == 0x27;
+        switch (funct3) {
+            case 0:  instr->veew = 8;  break;
+            case 5:  instr->veew = 16; break;
+            case 6:  instr->veew = 32; break;
+            default: return false;
+        }
+        if ((raw >> 29) != 0) // Zvlsseg is not supported
+            return false;
+        const char *pre = store ? "vs" : "vl";
+        instr->cls = store ? INSTR_VSTORE : INSTR_VLOAD;
+        switch ((raw >> 26) & 3) {
+            case 0:
+                instr->vstride = VSTRIDE_UNIT;
+                snprintf(instr->name, sizeof(instr->name), "%se%d.v", pre, instr->veew);
+                break;
+            case 2:
+                instr->vstride = VSTRIDE_STRIDED;
+                snprintf(instr->name, sizeof(instr->name), "%sse%d.v", pre, instr->veew);
+                break;
+            default:
+                instr->vstride = VSTRIDE_INDEXED;
+                snprintf(instr->name, sizeof(instr->name), "%s%sxei%d.v", pre, (((raw >> 26) & 3) == 1) ? "u" : "o", instr->veew);
+                break;
+        }
+        return true;
+    }
+
+    // vector AES instructions (Zvkned, opcode OP-VE)
+    if ((raw & 0x7F) == 0x77) {
+        static const char *aes_names[8] = {"vaesdm", "vaesdf", "vaesem", "vaesef", NULL, NULL, NULL, "vaesz"};
+        if (funct3 != 2 || instr->vmasked)
+            return false;
+        instr->cls = INSTR_VAES;
+        if (funct6 == 0x22) {
+            instr->imm = vs1; // round number
+            strcpy(instr->name, "vaeskf1.vi");
+            return true;
+        }
+        if ((funct6 != 0x28 && funct6 != 0x29) || vs1 >= 8 || aes_names[vs1] == NULL || (vs1 == 7 && funct6 == 0x28))
+            return false;
+        snprintf(instr->name, sizeof(instr->name), "%s%s", aes_names[vs1], (funct6 == 0x29) ? ".vs" : ".vv");
+        return true;
+    }
+
+    // configuration instructions
+    if (funct3 == 7) {
+        instr->cls = INSTR_VCFG;
+        if ((raw >> 31) == 0) {
+            instr->vtype_imm = true;
+            instr->vtype     = (raw >> 20) & 0x7FF;
+            strcpy(instr->name, "vsetvli");
+        } else if ((raw >> 30) == 3) {
+            instr->vtype_imm = true;
+            instr->vtype     = (raw >> 20) & 0x3FF;
+            instr->imm       = vs1; // AVL is an immediate
+            strcpy(instr->name, "vsetivli");
+        } else if ((raw >> 25) == 0x40) {
+            strcpy(instr->name, "vsetvl");
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    static const char *suffix[8] = {".vv", NULL, ".vv", ".vi", ".vx", NULL, ".vx", NULL};
+    if (suffix[funct3] == NULL) // floating-point instructions are not supported
+        return false;
+
+    const vop_info *info = NULL;
+    const char     *sfx  = suffix[funct3];
+    vop_info        tmp;
+    if (funct3 == 0 || funct3 == 3 || funct3 == 4) {
+        info = &opi_table[funct6];
+        if (funct6 == 0x17 && !instr->vmasked) { // vmv.v.*
+            tmp      = *info;
+            tmp.name = "vmv.v";
+            sfx      = (funct3 == 0) ? ".v" : (funct3 == 3) ? ".i" : ".x";
+            info     = &tmp;
+        }
+        if (funct6 == 0x15 && funct3 == 3) // vror.vi with bit 5 of the immediate set
+            info = &opi_table[0x14];
+        if ((funct6 == 0x27 || funct6 == 0x01) && funct3 == 3) // vsmul and vandn have no immediate variant
+            return false;
+    } else {
+        if (funct6 == 0x10) { // VWXUNARY0 and VRXUNARY0
+            tmp.cls   = INSTR_VELEM;
+            tmp.flags = 0;
+            tmp.name  = NULL;
+            if (funct3 == 2) {
+                instr->vxreg = true;
+                if (vs1 == 0x00) tmp.name = "vmv.x.s";
+                if (vs1 == 0x10) tmp.name = "vpopc.m";
+                if (vs1 == 0x11) tmp.name = "vfirst.m";
+            } else if (instr->rs2 == 0) {
+                tmp.cls  = INSTR_VALU;
+                tmp.name = "vmv.s.x";
+            }
+            sfx  = "";
+            info = &tmp;
+        } else if (funct6 == 0x12 && funct3 == 2) { // VXUNARY0
+            tmp.cls   = INSTR_VALU;
+            tmp.flags = 0;
+            tmp.name  = NULL;
+            if (vs1 == 0x06) tmp.name = "vzext.vf2";
+            if (vs1 == 0x07) tmp.name = "vsext.vf2";
+            if (vs1 == 0x04) tmp.name = "vzext.vf4";
+            if (vs1 == 0x05) tmp.name = "vsext.vf4";
+            if (vs1 == 0x08) tmp.name = "vbrev8.v";
+            if (vs1 == 0x09) tmp.name = "vrev8.v";
+            if (vs1 == 0x0C) tmp.name = "vclz.v";
+            if (vs1 == 0x0D) tmp.name = "vctz.v";
+            if (vs1 == 0x0E) tmp.name = "vcpop.v";
+            sfx  = "";
+            info = &tmp;
+        } else if (funct6 == 0x14 && funct3 == 2) { // VMUNARY0
+            tmp.cls   = INSTR_VELEM;
+            tmp.flags = 0;
+            tmp.name  = NULL;
+            if (vs1 == 0x01) { tmp.name = "vmsbf.m"; tmp.flags = VF_MASK; }
+            if (vs1 == 0x02) { tmp.name = "vmsof.m"; tmp.flags = VF_MASK; }
+            if (vs1 == 0x03) { tmp.name = "vmsif.m"; tmp.flags = VF_MASK; }
+            if (vs1 == 0x10) tmp.name = "viota.m";
+            if (vs1 == 0x11) tmp.name = "vid.v";
+            sfx  = "";
+            info = &tmp;
+        } else {
+            info = &opm_table[funct6];
+            if (info->flags & VF_REDUCE)
+                sfx = (funct6 == 0x17) ? ".vm" : ".vs";
+            if (info->flags & VF_MASK)
+                sfx = ".mm";
+            if (funct3 == 6 && (info->flags & (VF_REDUCE | VF_MASK)))
+                return false;
+        }
+    }
+    if (info == NULL || info->name == NULL)
+        return false;
+
+    instr->cls     = info->cls;
+    instr->vwiden  = (info->flags & VF_WIDEN) ? 1 : (info->flags & VF_NARROW) ? -1 : 0;
+    instr->vreduce = (info->flags & VF_REDUCE) != 0;
+    instr->vgather = (info->flags & VF_GATHER) != 0;
+    instr->vmaskop = (info->flags & VF_MASK) != 0;
+    if (funct3 == 3)
+        instr->imm = (int32_t)(vs1 << 27) >> 27;
+    snprintf(instr->name, sizeof(instr->name), "%s%s", info->name, sfx);
+    return true;
+}
+
+bool rv_decode(uint32_t raw, rv_instr *instr) {
+    memset(instr, 0, sizeof(*instr));
+    instr->cls = INSTR_ILLEGAL;
+    strcpy(instr->name, "illegal");
+
+    uint32_t exp = raw;
+    instr->len = 4;
+    if ((raw & 3) != 3) {
+        instr->raw = raw & 0xFFFF;
+        instr->len = 2;
+        exp = expand_compressed(raw & 0xFFFF);
+        if (exp == 0)
+            return false;
+    } else {
+        instr->raw = raw;
+    }
+    instr->exp = exp;
+
+    uint32_t opcode = exp & 0x7F, funct3 = (exp >> 12) & 7, funct7 = exp >> 25;
+    instr->rd  = (exp >> 7 ) & 0x1F;
+    instr->rs1 = (exp >> 15) & 0x1F;
+    instr->rs2 = (exp >> 20) & 0x1F;
+    instr->imm = (int32_t)exp >> 20;
+
+    static const char *branch_names[8] = {"beq", "bne", NULL, NULL, "blt", "bge", "bltu", "bgeu"};
+    static const char *load_names  [8] = {"lb", "lh", "lw", NULL, "lbu", "lhu", NULL, NULL};
+    static const char *store_names [8] = {"sb", "sh", "sw", NULL, NULL, NULL, NULL, NULL};
+    static const char *opimm_names [8] = {"addi", "slli", "slti", "sltiu", "xori", "srli", "ori", "andi"};
+    static const char *op_names    [8] = {"add", "sll", "slt", "sltu", "xor", "srl", "or", "and"};
+    static const char *mul_names   [8] = {"mul", "mulh", "mulhsu", "mulhu", "div", "divu", "rem", "remu"};
+    static const char *csr_names   [8] = {NULL, "csrrw", "csrrs", "csrrc", NULL, "csrrwi", "csrrsi", "csrrci"};
+    const char *name = NULL;
+
+    switch (opcode) {
+        case 0x37:
+        case 0x17:
+            instr->cls = INSTR_ALU;
+            instr->imm = exp & 0xFFFFF000;
+            name = (opcode == 0x37) ? "lui" : "auipc";
+            break;
+        case 0x6F:
+            instr->cls = INSTR_JAL;
+            instr->imm = ((int32_t)(exp & 0x80000000) >> 11) | (exp & 0xFF000) | ((exp >> 9) & 0x800) | ((exp >> 20) & 0x7FE);
+            name = "jal";
+            break;
+        case 0x67:
+            instr->cls = INSTR_JALR;
+            name = "jalr";
+            break;
+        case 0x63:
+            instr->cls = INSTR_BRANCH;
+            instr->imm = ((int32_t)(exp & 0x80000000) >> 19) | ((exp << 4) & 0x800) | ((exp >> 20) & 0x7E0) | ((exp >> 7) & 0x1E);
+            name = branch_names[funct3];
+            break;
+        case 0x03:
+            instr->cls = INSTR_LOAD;
+            name = load_names[funct3];
+            break;
+        case 0x23:
+            instr->cls = INSTR_STORE;
+            instr->imm = ((int32_t)exp >> 25 << 5) | ((exp >> 7) & 0x1F);
+            name = store_names[funct3];
+            break;
+        case 0x13:
+            instr->cls = INSTR_ALU;
+            name = opimm_names[funct3];
+            if (funct3 == 5 && funct7 == 0x20)
+                name = "srai";
+            break;
+        case 0x33:
+            if (funct7 == 0x01) {
+                instr->cls = (funct3 < 4) ? INSTR_MUL : INSTR_DIV;
+                name = mul_names[funct3];
+            } else {
+                instr->cls = INSTR_ALU;
+                name = op_names[funct3];
+                if (funct7 == 0x20 && funct3 == 0)
+                    name = "sub";
+                if (funct7 == 0x20 && funct3 == 5)
+                    name = "sra";
+            }
+            break;
+        case 0x0F:
+            instr->cls = INSTR_SYSTEM;
+            name = "fence";
+            break;
+        case 0x73:
+            if (funct3 == 0) {
+                instr->cls = INSTR_SYSTEM;
+                switch (exp >> 20) {
+                    case 0x000: name = "ecall";  break;
+                    case 0x001: name = "ebreak"; break;
+                    case 0x302: name = "mret";   break;
+                    case 0x105: name = "wfi";    break;
+                    default:    break;
+                }
+            } else {
+                instr->cls = INSTR_CSR;
+                instr->imm = exp >> 20; // CSR address
+                name = csr_names[funct3];
+            }
+            break;
+        case 0x07:
+        case 0x27:
+        case 0x57:
+        case 0x77:
+            if (instr->len != 4 || !decode_vector(exp, instr)) {
+                instr->cls = INSTR_ILLEGAL;
+                strcpy(instr->name, "illegal");
+                return false;
+            }
+            return true;
+        default:
+            break;
+    }
+    if (name == NULL) {
+        instr->cls = INSTR_ILLEGAL;
+        return false;
+    }
+    snprintf(instr->name, sizeof(instr->name), "%s", name);
+    return true;
+}
+
+bool vtype_decode(uint32_t vtype, int *sew, int *lmul8) {
+    static const int lmul8_table[8] = {8, 16, 32, 64, 0, 1, 2, 4};
+    uint32_t vsew  = (vtype >> 3) & 7;
+    uint32_t vlmul = vtype & 7;
+    if (vsew > 2 || lmul8_table[vlmul] == 0 || (vtype >> 8) != 0)
+        return false;
+    *sew   = 8 << vsew;
+    *lmul8 = lmul8_table[vlmul];
+    return true;
+}
@@ -0,0 +1,77 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// Instruction decoder for RV32IMC and the subset of the V extension (v0.10)
+// that is supported by Vicuna
+
+#ifndef RV_INSTR_H
+#define RV_INSTR_H
+
+#include <stdint.h>
+
+enum instr_class {
+    INSTR_ILLEGAL,
+    INSTR_ALU,      // scalar integer computation (including LUI and AUIPC)
+    INSTR_MUL,      // scalar multiplication
+    INSTR_DIV,      // scalar division and remainder
+    INSTR_LOAD,     // scalar load
+    INSTR_STORE,    // scalar store
+    INSTR_BRANCH,   // conditional branch
+    INSTR_JAL,      // direct jump (and link)
+    INSTR_JALR,     // indirect jump (and link)
+    INSTR_CSR,      // CSR access
+    INSTR_SYSTEM,   // fence, ecall, ebreak, mret, wfi
+    INSTR_VCFG,     // vsetvli, vsetivli, vsetvl
+    INSTR_VLOAD,    // vector load
+    INSTR_VSTORE,   // vector store
+    INSTR_VALU,     // vector instruction executed by the ALU unit
+    INSTR_VMUL,     // vector instruction executed by the MUL unit
+    INSTR_VSLD,     // vector instruction executed by the SLD unit
+    INSTR_VELEM,    // vector instruction executed by the ELEM unit
+    INSTR_VAES      // vector AES instruction (Zvkned) executed by the AES unit
+};
+
+enum vstride_mode {
+    VSTRIDE_UNIT,
+    VSTRIDE_STRIDED,
+    VSTRIDE_INDEXED
+};
+
+struct rv_instr {
+    uint32_t     raw;
+    uint32_t     exp;       // equivalent 32-bit encoding of compressed instructions
+    int          len;       // length in bytes (2 for compressed instructions)
+    instr_class  cls;
+    char         name[24];  // mnemonic (for vector instructions with suffix)
+    int          rd, rs1, rs2;
+    int32_t      imm;       // immediate (branch and jump offsets are relative)
+
+    // vector instruction details:
+    bool         vmasked;   // instruction is masked (v0.t)
+    int          vwiden;    // 0: single-width, 1: widening, -1: narrowing
+    int          veew;      // EEW of vector loads and stores (8, 16 or 32)
+    vstride_mode vstride;   // stride mode of vector loads and stores
+    bool         vreduce;   // reduction or compress (requires a flush)
+    bool         vgather;   // register gather
+    bool         vmaskop;   // operates on mask registers (EMUL is always 1)
+    bool         vxreg;     // writes an x register (vmv.x.s, vpopc, vfirst)
+    bool         vtype_imm; // vtype is given as immediate (vsetvli, vsetivli)
+    uint32_t     vtype;     // immediate vtype of vsetvli and vsetivli
+};
+
+// decode the instruction at the lower end of raw; returns false if the
+// instruction is illegal (or not supported)
+bool rv_decode(uint32_t raw, rv_instr *instr);
+
+// check whether an instruction class is a vector instruction
+static inline bool instr_is_vector(instr_class cls) {
+    return cls >= INSTR_VCFG;
+}
+
+// SEW in bits and LMUL times 8 (i.e., 1 for LMUL=1/8 and 64 for LMUL=8) of a
+// vtype value; returns false for reserved encodings
+bool vtype_decode(uint32_t vtype, int *sew, int *lmul8);
+
+#endif // RV_INSTR_H
@@ -0,0 +1,219 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include "rv_iss.h"
+
+rv_iss::rv_iss(uint32_t mem_sz, int vreg_w) : mem(mem_sz, 0), vreg_w(vreg_w) {
+    pc      = 0x80;
+    vl      = 0;
+    vtype   = 0x80000000u; // vill
+    instret = 0;
+    memset(x, 0, sizeof(x));
+}
+
+void rv_iss::load(const elf_file &elf) {
+    std::fill(mem.begin(), mem.end(), 0);
+    elf.load_image(mem);
+    pc      = 0x80;
+    vl      = 0;
+    vtype   = 0x80000000u;
+    instret = 0;
+    memset(x, 0, sizeof(x));
+}
+
+bool rv_iss::read(uint32_t addr, int size, uint32_t *val) {
+    if ((uint64_t)addr + size > mem.size()) {
+        fprintf(stderr, "ERROR: load from invalid address 0x%08x at pc 0x%08x\n", addr, pc);
+        return false;
+    }
+    *val = 0;
+    for (int i = 0; i < size; i++)
+        *val |= (uint32_t)mem[addr + i] << (8 * i);
+    return true;
+}
+
+bool rv_iss::write(uint32_t addr, int size, uint32_t val) {
+    if ((uint64_t)addr + size > mem.size()) {
+        fprintf(stderr, "ERROR: store to invalid address 0x%08x at pc 0x%08x\n", addr, pc);
+        return false;
+    }
+    for (int i = 0; i < size; i++)
+        mem[addr + i] = (val >> (8 * i)) & 0xFF;
+    return true;
+}
+
+bool rv_iss::step(rv_step *s) {
+    uint32_t raw;
+    if (!read(pc, 2, &raw))
+        return false;
+    if ((raw & 3) == 3 && !read(pc, 4, &raw))
+        return false;
+
+    rv_instr &in = s->instr;
+    if (!rv_decode(raw, &in)) {
+        fprintf(stderr, "ERROR: illegal instruction 0x%08x at pc 0x%08x\n", raw, pc);
+        return false;
+    }
+    s->pc    = pc;
+    s->taken = false;
+    s->addr  = 0;
+    s->x_rs1 = x[in.rs1];
+    s->x_rs2 = x[in.rs2];
+    s->end   = false;
+
+    uint32_t exp    = in.exp;
+    uint32_t funct3 = (exp >> 12) & 7, funct7 = exp >> 25;
+    uint32_t a = x[in.rs1], b = x[in.rs2], res = 0;
+    uint32_t next = pc + in.len;
+    bool     wb   = false;
+
+    switch (in.cls) {
+        case INSTR_ALU: {
+            uint32_t opcode = exp & 0x7F;
+            if (opcode == 0x37) {
+                res = in.imm;
+            } else if (opcode == 0x17) {
+                res = pc + in.imm;
+            } else {
+                uint32_t op2 = (opcode == 0x13) ? (uint32_t)in.imm : b;
+                switch (funct3) {
+                    case 0: res = (opcode == 0x33 && funct7 == 0x20) ? a - op2 : a + op2; break;
+                    case 1: res = a << (op2 & 0x1F); break;
+                    case 2: res = ((int32_t)a < (int32_t)op2) ? 1 : 0; break;
+                    case 3: res = (a < op2) ? 1 : 0; break;
+                    case 4: res = a ^ op2; break;
+                    case 5: res = (funct7 & 0x20) ? (uint32_t)((int32_t)a >> (op2 & 0x1F)) : a >> (op2 & 0x1F); break;
+                    case 6: res = a | op2; break;
+                    case 7: res = a & op2; break;
+                }
+            }
+            wb = true;
+            break;
+        }
+        case INSTR_MUL: {
+            int64_t sa = (int32_t)a, sb = (int32_t)b;
+            switch (funct3) {
+                case 0: res = a * b; break;
+                case 1: res = (uint32_t)((sa * sb) >> 32); break;
+                case 2: res = (uint32_t)((sa * (int64_t)(uint64_t)b) >> 32); break;
+                case 3: res = (uint32_t)(((uint64_t)a * b) >> 32); break;
+            }
+            wb = true;
+            break;
+        }
+        case INSTR_DIV:
+            switch (funct3) {
+                case 4: res = (b == 0) ? 0xFFFFFFFFu : ((a == 0x80000000u && b == 0xFFFFFFFFu) ? a : (uint32_t)((int32_t)a / (int32_t)b)); break;
+                case 5: res = (b == 0) ? 0xFFFFFFFFu : a / b; break;
+                case 6: res = (b == 0) ? a : ((a == 0x80000000u && b == 0xFFFFFFFFu) ? 0 : (uint32_t)((int32_t)a % (int32_t)b)); break;
+                case 7: res = (b == 0) ? a : a % b; break;
+            }
+            wb = true;
+            break;
+        case INSTR_LOAD: {
+            s->addr = a + in.imm;
+            int size = 1 << (funct3 & 3);
+            if (!read(s->addr, size, &res))
+                return false;
+            if (funct3 == 0)
+                res = (uint32_t)(int8_t)res;
+            if (funct3 == 1)
+                res = (uint32_t)(int16_t)res;
+            wb = true;
+            break;
+        }
+        case INSTR_STORE:
+            s->addr = a + in.imm;
+            if (!write(s->addr, 1 << funct3, b))
+                return false;
+            break;
+        case INSTR_BRANCH: {
+            bool cond = false;
+            switch (funct3) {
+                case 0: cond = a == b; break;
+                case 1: cond = a != b; break;
+                case 4: cond = (int32_t)a <  (int32_t)b; break;
+                case 5: cond = (int32_t)a >= (int32_t)b; break;
+                case 6: cond = a <  b; break;
+                case 7: cond = a >= b; break;
+            }
+            if (cond) {
+                next     = pc + in.imm;
+                s->taken = true;
+            }
+            break;
+        }
+        case INSTR_JAL:
+            res      = next;
+            next     = pc + in.imm;
+            s->taken = true;
+            wb       = true;
+            break;
+        case INSTR_JALR:
+            res      = next;
+            next     = (a + in.imm) & ~1u;
+            s->taken = true;
+            wb       = true;
+            break;
+        case INSTR_CSR: {
+            uint32_t csr = (uint32_t)in.imm & 0xFFF;
+            switch (csr) {
+                case 0xC20: res = vl;                       break;
+                case 0xC21: res = vtype;                    break;
+                case 0xC22: res = vreg_w / 8;               break;
+                case 0xB02:
+                case 0xC02: res = (uint32_t)instret;        break;
+                default:    res = 0;                        break;
+            }
+            wb = true;
+            break;
+        }
+        case INSTR_SYSTEM:
+            break;
+        case INSTR_VCFG: {
+            uint32_t new_vtype = in.vtype_imm ? in.vtype : b;
+            uint32_t avl;
+            if (strcmp(in.name, "vsetivli") == 0)
+                avl = in.imm;
+            else if (in.rs1 != 0)
+                avl = a;
+            else
+                avl = (in.rd != 0) ? 0xFFFFFFFFu : vl;
+            int sew, lmul8;
+            if (vtype_decode(new_vtype, &sew, &lmul8)) {
+                uint32_t vlmax = (uint32_t)vreg_w * lmul8 / 8 / sew;
+                vtype = new_vtype;
+                vl    = (avl < vlmax) ? avl : vlmax;
+            } else {
+                vtype = 0x80000000u;
+                vl    = 0;
+            }
+            res = vl;
+            wb  = true;
+            break;
+        }
+        case INSTR_VLOAD:
+        case INSTR_VSTORE:
+            s->addr = a;
+            break;
+        default:
+            if (in.vxreg) {
+                res = 0;
+                wb  = true;
+            }
+            break;
+    }
+    if (wb && in.rd != 0)
+        x[in.rd] = res;
+    s->vl    = vl;
+    s->vtype = vtype;
+    s->end   = (s->taken && next == 0);
+    pc       = next;
+    instret++;
+    return true;
+}
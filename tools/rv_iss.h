@@ -0,0 +1,61 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// Functional instruction set simulator for the scalar part of RV32IMC
+//
+// Vector instructions only update vl and vtype (vsetvli, vsetivli, vsetvl)
+// and report the scalar operands needed for timing purposes (such as the base
+// address and stride of loads and stores).  The content of vector registers
+// is not simulated: vector loads and stores do not access memory and vector
+// instructions writing an x register (vmv.x.s, vpopc.m, vfirst.m) return 0.
+
+#ifndef RV_ISS_H
+#define RV_ISS_H
+
+#include <stdint.h>
+#include <vector>
+#include "elf32.h"
+#include "rv_instr.h"
+
+struct rv_step {
+    uint32_t pc;
+    rv_instr instr;
+    bool     taken;     // control transfer (taken branch or jump)
+    uint32_t addr;      // data address of loads and stores (base address for vectors)
+    uint32_t x_rs1;     // scalar operands passed to the vector unit
+    uint32_t x_rs2;
+    uint32_t vl;        // vl and vtype after the instruction
+    uint32_t vtype;
+    bool     end;       // the program ends (jump to address 0)
+};
+
+class rv_iss {
+public:
+    // create a simulator with a memory of mem_sz bytes for a vector register
+    // width of vreg_w bits
+    rv_iss(uint32_t mem_sz, int vreg_w);
+
+    // load an ELF file into memory and reset the simulator; execution starts
+    // at address 0x80 (the reset vector of Ibex)
+    void load(const elf_file &elf);
+
+    // execute one instruction; returns false and prints an error message in
+    // case of an illegal instruction or an invalid memory access
+    bool step(rv_step *s);
+
+    uint32_t pc;
+    uint32_t x[32];
+    uint32_t vl, vtype;
+    uint64_t instret;
+
+private:
+    bool     read(uint32_t addr, int size, uint32_t *val);
+    bool     write(uint32_t addr, int size, uint32_t val);
+
+    std::vector<uint8_t> mem;
+    int                  vreg_w;
+};
+
+#endif // RV_ISS_H
@@ -0,0 +1,75 @@
+#!/bin/bash
+
+# Copyright TU Wien
+# Licensed under the ISC license, see LICENSE.txt for details
+# SPDX-License-Identifier: ISC
+
+
+# Validation of the performance model against RTL simulation
+#
+# Usage: validate_perf.sh RESULTS TOLERANCE
+#
+# RESULTS is the results file written by the tests Makefile (e.g., the file
+# test/kernel/results.csv after running `make kernel' in test/), which contains
+# one line per test and configuration with the fields CONFIG;TEST;CYCLES;STATUS.
+# The ELF file of each test is expected in the directory of the results file.
+# TOLERANCE is the permitted deviation of the predicted cycle count in percent.
+#
+# For every successful test, the cycle count predicted by vperf is compared
+# against the simulated cycle count.  The script prints the deviation of each
+# test and the mean and maximum absolute deviation, and exits with a non-zero
+# status if any prediction deviates by more than the tolerance.
+
+if [ "$#" != "2" ]; then
+    echo "Usage: $0 RESULTS TOLERANCE" >&2
+    exit 2
+fi
+
+results="$1"
+tolerance="$2"
+vperf="$(dirname "$0")/vperf"
+
+if [ ! -f "$results" ]; then
+    echo "[ ERROR ] results file \`$results' not found" >&2
+    exit 2
+fi
+if [ ! -x "$vperf" ]; then
+    echo "[ ERROR ] \`$vperf' not found; build the host tools with make" >&2
+    exit 2
+fi
+
+dir=`dirname "$results"`
+set -o pipefail
+while IFS=';' read -r config test cycles status; do
+    if [ "$status" != "SUCCESS" ]; then
+        continue
+    fi
+    predicted=`"$vperf" -q -c "$config" "$dir/$test.elf" | cut -d ';' -f 3`
+    if [ -z "$predicted" ]; then
+        echo "[ ERROR ] $test: vperf failed for config $config" >&2
+        exit 2
+    fi
+    echo "$config;$test;$cycles;$predicted"
+done < "$results" | awk -F ';' -v tol="$tolerance" '
+    {
+        diff = ($4 - $3) * 100.0 / $3;
+        adiff = (diff < 0) ? -diff : diff;
+        sum += adiff;
+        cnt++;
+        if (adiff > max)
+            max = adiff;
+        if (adiff > tol) {
+            printf "[ ERROR ] %-30s %9d cycles, predicted %9d (%+.1f%%); config %s\n", \
+                   $2, $3, $4, diff, $1;
+            retval = 1;
+        } else {
+            printf "[ INFO  ] %-30s %9d cycles, predicted %9d (%+.1f%%)\n", $2, $3, $4, diff;
+        }
+    }
+    END {
+        if (cnt > 0)
+            printf "[ INFO  ] mean deviation %.1f%%, maximum deviation %.1f%% over %d tests\n", \
+                   sum / cnt, max, cnt;
+        exit retval
+    }
+'
@@ -0,0 +1,487 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// Cycle-approximate performance model of Vicuna
+//
+// The program is executed by a functional instruction set simulator and the
+// resulting dynamic instruction stream is replayed through a model of Ibex,
+// the vector instruction decoder and queue, the dispatcher with its vector
+// register hazard tracking, the vector execution units, and the caches.  The
+// model is orders of magnitude faster than an RTL simulation and is intended
+// to explore and prune the configuration space.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include "elf32.h"
+#include "rv_instr.h"
+#include "rv_iss.h"
+#include "vproc_config.h"
+#include "vproc_timing.h"
+
+enum vunit {
+    VUNIT_LSU,
+    VUNIT_ALU,
+    VUNIT_MUL,
+    VUNIT_SLD,
+    VUNIT_ELEM,
+    VUNIT_AES,
+    VUNIT_CNT
+};
+
+static const char *vunit_names[VUNIT_CNT] = {"LSU", "ALU", "MUL", "SLD", "ELEM", "AES"};
+
+struct perf_stats {
+    int64_t  cycles;
+    uint64_t scalar_instrs, vector_instrs;
+    int64_t  unit_busy[VUNIT_CNT];
+    int64_t  stall_queue;       // Ibex waits for space in the vector instruction queue
+    int64_t  stall_hazard;      // dispatcher waits for vector register hazards
+    int64_t  stall_unit;        // dispatcher waits for a busy unit
+    int64_t  stall_xreg;        // Ibex waits for an x register result of the vector unit
+    int64_t  stall_mem;         // scalar memory access waits for pending vector loads/stores
+};
+
+class perf_model {
+public:
+    perf_model(const vproc_config &cfg);
+    void scalar(const rv_step &s);
+    void vector(const rv_step &s);
+
+    perf_stats    stats;
+    vtiming_cache icache, dcache;
+
+private:
+    void vreg_operands(const rv_instr &in, int sew, int lmul8, uint32_t *rd_map, uint32_t *wr_map);
+
+    const vproc_config &cfg;
+    int64_t             t;                      // cycle in which Ibex issues the next instruction
+    int64_t             last_dispatch;
+    std::deque<int64_t> dispatch_hist;          // dispatch cycles of the preceding instructions
+    int64_t             unit_free[VUNIT_CNT];   // cycle in which a unit accepts the next instruction
+    int64_t             rd_clear[32];           // cycle in which the read hazard of a vreg clears
+    int64_t             wr_clear[32];           // cycle in which the write hazard of a vreg clears
+    int64_t             vload_done, vstore_done;
+};
+
+perf_model::perf_model(const vproc_config &cfg) :
+        icache(cfg.icache_sz ? cfg.icache_sz : 2 * cfg.icache_line_w / 8, cfg.icache_line_w),
+        dcache(cfg.dcache_sz ? cfg.dcache_sz : 2 * cfg.dcache_line_w / 8, cfg.dcache_line_w),
+        cfg(cfg) {
+    memset(&stats, 0, sizeof(stats));
+    t             = 0;
+    last_dispatch = 0;
+    vload_done    = 0;
+    vstore_done   = 0;
+    for (int i = 0; i < VUNIT_CNT; i++)
+        unit_free[i] = 0;
+    for (int i = 0; i < 32; i++) {
+        rd_clear[i] = 0;
+        wr_clear[i] = 0;
+    }
+}
+
+// cycles until a memory access has completed (cache lookup and, in case of a
+// miss, write back of the replaced line and line fill)
+static int64_t mem_access(const vproc_config &cfg, vtiming_cache &cache, int line_w, uint32_t addr, bool write) {
+    switch (cache.access(addr, write)) {
+        case vtiming_cache::HIT:
+            return 1;
+        case vtiming_cache::MISS:
+            return vtiming_line_fill(cfg, line_w);
+        default:
+            return vtiming_line_fill(cfg, line_w) + vtiming_line_spill(cfg, line_w);
+    }
+}
+
+void perf_model::scalar(const rv_step &s) {
+    const rv_instr &in = s.instr;
+    stats.scalar_instrs++;
+
+    // instruction fetch
+    if (cfg.icache_sz != 0) {
+        if (icache.access(s.pc, false) != vtiming_cache::HIT)
+            t += vtiming_line_fill(cfg, cfg.icache_line_w);
+    } else {
+        t += (cfg.mem_latency + 1) / 2 - 1;
+    }
+
+    t += vtiming_scalar_cycles(in, s.taken);
+    if (s.taken)
+        t += (cfg.icache_sz != 0) ? 1 : cfg.mem_latency;
+
+    if (in.cls == INSTR_LOAD || in.cls == INSTR_STORE) {
+        // the main core's data requests are held back while the vector unit
+        // accesses memory; loads wait for pending vector stores and stores
+        // wait for all pending vector loads and stores
+        int64_t ready = std::max(t, unit_free[VUNIT_LSU]);
+        ready = std::max(ready, vstore_done);
+        if (in.cls == INSTR_STORE)
+            ready = std::max(ready, vload_done);
+        stats.stall_mem += ready - t;
+        t = ready;
+        if (cfg.dcache_sz != 0)
+            t += mem_access(cfg, dcache, cfg.dcache_line_w, s.addr, in.cls == INSTR_STORE);
+        else
+            t += cfg.mem_latency;
+    }
+    stats.cycles = t;
+}
+
+// bit maps of the vector registers read and written by an instruction
+void perf_model::vreg_operands(const rv_instr &in, int sew, int lmul8, uint32_t *rd_map, uint32_t *wr_map) {
+    int      emul   = (lmul8 < 8) ? 1 : lmul8 / 8;
+    int      wide   = (lmul8 < 4) ? 1 : lmul8 / 4;
+    uint32_t funct3 = (in.raw >> 12) & 7;
+    bool     vv     = (funct3 == 0 || funct3 == 2);
+    const char *name = in.name;
+    #define VGROUP(reg, cnt) ((uint32_t)(((1ull << (cnt)) - 1) << (reg)))
+
+    *rd_map = in.vmasked ? 1u : 0u;
+    *wr_map = 0;
+    if (in.cls == INSTR_VLOAD || in.cls == INSTR_VSTORE) {
+        int emul8 = lmul8 * in.veew / sew;
+        int data  = (emul8 < 8) ? 1 : emul8 / 8;
+        if (in.vstride == VSTRIDE_INDEXED)
+            *rd_map |= VGROUP(in.rs2, emul);
+        if (in.cls == INSTR_VLOAD)
+            *wr_map |= VGROUP(in.rd, data);
+        else
+            *rd_map |= VGROUP(in.rd, data);
+        return;
+    }
+    if (in.vxreg) {                         // vmv.x.s, vpopc.m, vfirst.m
+        *rd_map |= VGROUP(in.rs2, 1);
+        return;
+    }
+    if (strcmp(name, "vmv.s.x") == 0) {
+        *wr_map |= VGROUP(in.rd, 1);
+        return;
+    }
+    if (in.vmaskop) {                       // mask logical operations, vmsbf, vmsif, vmsof
+        *rd_map |= VGROUP(in.rs2, 1);
+        if (strstr(name, ".mm") != NULL)
+            *rd_map |= VGROUP(in.rs1, 1);
+        *wr_map |= VGROUP(in.rd, 1);
+        return;
+    }
+    if (in.cls == INSTR_VAES) {             // vaes*.vv, vaes*.vs, vaeskf1.vi
+        *rd_map |= VGROUP(in.rs2, (strstr(name, ".vs") != NULL) ? 1 : emul);
+        if (strcmp(name, "vaeskf1.vi") != 0)
+            *rd_map |= VGROUP(in.rd, emul);
+        *wr_map |= VGROUP(in.rd, emul);
+        return;
+    }
+    if (strcmp(name, "vid.v") == 0) {
+        *wr_map |= VGROUP(in.rd, emul);
+        return;
+    }
+    if (strcmp(name, "viota.m") == 0) {
+        *rd_map |= VGROUP(in.rs2, 1);
+        *wr_map |= VGROUP(in.rd, emul);
+        return;
+    }
+    if (in.vreduce) {
+        if (strcmp(name, "vcompress.vm") == 0) {
+            *rd_map |= VGROUP(in.rs2, emul) | VGROUP(in.rs1, 1);
+            *wr_map |= VGROUP(in.rd, emul);
+        } else {
+            *rd_map |= VGROUP(in.rs2, emul) | VGROUP(in.rs1, 1);
+            *wr_map |= VGROUP(in.rd, 1);
+        }
+        return;
+    }
+
+    // regular arithmetic instructions
+    int  vs2_cnt = emul, vs1_cnt = emul, vd_cnt = emul;
+    bool mask_dst = (strncmp(name, "vms", 3) == 0) || (strncmp(name, "vmadc", 5) == 0) ||
+                    (strncmp(name, "vmsbc", 5) == 0);
+    if (in.vwiden > 0) {
+        vd_cnt = wide;
+        if (strstr(name, ".w.") != NULL)
+            vs2_cnt = wide;
+    } else if (in.vwiden < 0) {
+        vs2_cnt = wide;
+    }
+    if (strncmp(name, "vzext.vf2", 9) == 0 || strncmp(name, "vsext.vf2", 9) == 0)
+        vs2_cnt = (lmul8 < 16) ? 1 : lmul8 / 16;
+    if (strncmp(name, "vzext.vf4", 9) == 0 || strncmp(name, "vsext.vf4", 9) == 0)
+        vs2_cnt = (lmul8 < 32) ? 1 : lmul8 / 32;
+    if (mask_dst)
+        vd_cnt = 1;
+    if (strncmp(name, "vmv.v", 5) != 0)     // vmv.v.* does not read vs2
+        *rd_map |= VGROUP(in.rs2, vs2_cnt);
+    if (vv)
+        *rd_map |= VGROUP(in.rs1, vs1_cnt);
+    if (strstr(name, "macc") != NULL || strstr(name, "msac") != NULL || strstr(name, "madd") != NULL ||
+        strstr(name, "msub") != NULL)       // multiply-add instructions read vd
+        *rd_map |= VGROUP(in.rd, vd_cnt);
+    *wr_map |= VGROUP(in.rd, vd_cnt);
+    #undef VGROUP
+}
+
+void perf_model::vector(const rv_step &s) {
+    const rv_instr &in = s.instr;
+    stats.vector_instrs++;
+
+    // instruction fetch and offloading to the vector unit; the decoder buffer,
+    // the instruction queue, and the dequeue buffer hold QUEUE_SZ + 2
+    // instructions in total
+    if (cfg.icache_sz != 0) {
+        if (icache.access(s.pc, false) != vtiming_cache::HIT)
+            t += vtiming_line_fill(cfg, cfg.icache_line_w);
+    } else {
+        t += (cfg.mem_latency + 1) / 2 - 1;
+    }
+    int64_t accept = t;
+    size_t  cap    = cfg.queue_sz + 2;
+    if (dispatch_hist.size() >= cap)
+        accept = std::max(accept, dispatch_hist[dispatch_hist.size() - cap] + 1);
+    stats.stall_queue += accept - t;
+
+    // configuration instructions are executed by the decoder, Ibex waits for
+    // the new value of vl
+    if (in.cls == INSTR_VCFG) {
+        t = accept + 2;
+        return;
+    }
+    t = accept + 1;
+
+    int sew, lmul8;
+    if (!vtype_decode(s.vtype, &sew, &lmul8))
+        return; // instructions are not executed if vtype is invalid
+
+    vunit unit;
+    switch (in.cls) {
+        case INSTR_VLOAD:
+        case INSTR_VSTORE: unit = VUNIT_LSU;  break;
+        case INSTR_VMUL:   unit = VUNIT_MUL;  break;
+        case INSTR_VSLD:   unit = VUNIT_SLD;  break;
+        case INSTR_VELEM:  unit = VUNIT_ELEM; break;
+        case INSTR_VAES:   unit = VUNIT_AES;  break;
+        default:           unit = VUNIT_ALU;  break;
+    }
+
+    // dispatch (in order, once all hazards are cleared and the unit is ready)
+    uint32_t rd_map, wr_map;
+    vreg_operands(in, sew, lmul8, &rd_map, &wr_map);
+    int64_t ready  = std::max(accept + 2, last_dispatch + 1);
+    int64_t hazard = ready;
+    for (int i = 0; i < 32; i++) {
+        if ((rd_map >> i) & 1)
+            hazard = std::max(hazard, wr_clear[i]);
+        if ((wr_map >> i) & 1)
+            hazard = std::max(hazard, std::max(rd_clear[i], wr_clear[i]));
+    }
+    int64_t dispatch = std::max(hazard, unit_free[unit]);
+    stats.stall_hazard += hazard - ready;
+    stats.stall_unit   += dispatch - hazard;
+
+    // execution
+    int64_t busy    = vtiming_unit_cycles(cfg, in, sew, lmul8);
+    int64_t latency = vtiming_unit_latency(in);
+    if (unit == VUNIT_LSU) {
+        int      emul8 = lmul8 * in.veew / sew;
+        int      emul  = (emul8 < 8) ? 1 : emul8 / 8;
+        int64_t  cnt;
+        uint32_t step;
+        if (in.vstride == VSTRIDE_UNIT) {
+            step = cfg.vmem_w / 8;
+            cnt  = emul * cfg.vreg_w / cfg.vmem_w + ((s.addr % step) != 0 ? 1 : 0);
+        } else {
+            // indices of indexed accesses are unknown, contiguous elements
+            // are assumed instead
+            step = (in.vstride == VSTRIDE_STRIDED) ? s.x_rs2 : in.veew / 8;
+            cnt  = emul * cfg.vreg_w / in.veew;
+        }
+        busy = 0;
+        for (int64_t i = 0; i < cnt; i++) {
+            uint32_t addr = s.addr + (uint32_t)i * step;
+            if (cfg.dcache_sz != 0)
+                busy += mem_access(cfg, dcache, cfg.dcache_line_w, addr, in.cls == INSTR_VSTORE);
+            else
+                busy += 1;
+        }
+        if (in.cls == INSTR_VLOAD)
+            latency += (cfg.dcache_sz != 0) ? 2 : cfg.mem_latency;
+    }
+    int64_t done = dispatch + busy + latency;
+    unit_free[unit]        = dispatch + busy;
+    stats.unit_busy[unit] += busy;
+    last_dispatch          = dispatch;
+    dispatch_hist.push_back(dispatch);
+    if (dispatch_hist.size() > cap)
+        dispatch_hist.pop_front();
+    for (int i = 0; i < 32; i++) {
+        if ((rd_map >> i) & 1)
+            rd_clear[i] = std::max(rd_clear[i], dispatch + busy);
+        if ((wr_map >> i) & 1)
+            wr_clear[i] = std::max(wr_clear[i], done);
+    }
+    if (in.cls == INSTR_VLOAD)
+        vload_done = std::max(vload_done, done);
+    if (in.cls == INSTR_VSTORE)
+        vstore_done = std::max(vstore_done, done);
+
+    // instructions that write an x register stall Ibex until the result is
+    // available
+    if (in.vxreg) {
+        stats.stall_xreg += std::max((int64_t)0, done + 1 - t);
+        t = std::max(t, done + 1);
+    }
+    stats.cycles = t;
+}
+
+// simulate a program for one configuration; returns false on error
+static bool run(const vproc_config &cfg, const elf_file &elf, uint32_t mem_sz, uint64_t max_instrs,
+                perf_model *model) {
+    rv_iss  iss(mem_sz, cfg.vreg_w);
+    rv_step s;
+    iss.load(elf);
+    for (;;) {
+        if (iss.instret >= max_instrs) {
+            fprintf(stderr, "ERROR: instruction limit of %llu exceeded\n", (unsigned long long)max_instrs);
+            return false;
+        }
+        if (!iss.step(&s))
+            return false;
+        if (instr_is_vector(s.instr.cls))
+            model->vector(s);
+        else
+            model->scalar(s);
+        if (s.end)
+            break;
+    }
+    return true;
+}
+
+static void print_report(const vproc_config &cfg, const perf_model &model) {
+    const perf_stats &st = model.stats;
+    printf("configuration: ");
+    cfg.print(stdout);
+    printf("\n");
+    printf("cycles:              %12lld\n", (long long)st.cycles);
+    printf("scalar instructions: %12llu\n", (unsigned long long)st.scalar_instrs);
+    printf("vector instructions: %12llu\n", (unsigned long long)st.vector_instrs);
+    printf("unit utilization:\n");
+    for (int i = 0; i < VUNIT_CNT; i++) {
+        printf("    %-4s %12lld busy cycles (%5.1f%%)\n", vunit_names[i], (long long)st.unit_busy[i],
+               (st.cycles > 0) ? 100.0 * st.unit_busy[i] / st.cycles : 0.0);
+    }
+    printf("stall cycles:\n");
+    printf("    queue full          %12lld\n", (long long)st.stall_queue);
+    printf("    vreg hazards        %12lld\n", (long long)st.stall_hazard);
+    printf("    unit busy           %12lld\n", (long long)st.stall_unit);
+    printf("    x register result   %12lld\n", (long long)st.stall_xreg);
+    printf("    memory ordering     %12lld\n", (long long)st.stall_mem);
+    if (cfg.icache_sz != 0) {
+        printf("instruction cache:   %12llu hits, %llu misses\n", (unsigned long long)model.icache.hits,
+               (unsigned long long)model.icache.misses);
+    }
+    if (cfg.dcache_sz != 0) {
+        printf("data cache:          %12llu hits, %llu misses\n", (unsigned long long)model.dcache.hits,
+               (unsigned long long)model.dcache.misses);
+    }
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-c CONFIG | -f CONFIG_FILE] [-s MEM_SZ] [-n MAX_INSTRS] [-q] ELF_FILE...\n"
+                    "  -c CONFIG       hardware configuration as list of KEY=VAL pairs\n"
+                    "  -f CONFIG_FILE  file with one configuration per line (such as the\n"
+                    "                  test_configs.conf files in test/)\n"
+                    "  -s MEM_SZ       memory size in bytes (default: 262144)\n"
+                    "  -n MAX_INSTRS   maximum number of executed instructions (default: 100000000)\n"
+                    "  -q              print only the cycle counts\n"
+                    "A detailed report is printed for a single configuration and program (unless -q\n"
+                    "is given).  Otherwise, one line CONFIG;PROGRAM;CYCLES is printed per\n"
+                    "configuration and program.\n", prog);
+}
+
+int main(int argc, char **argv) {
+    std::vector<std::string> configs;
+    uint32_t mem_sz     = 262144;
+    uint64_t max_instrs = 100000000;
+    bool     quiet      = false;
+    int      opt;
+    while ((opt = getopt(argc, argv, "c:f:s:n:q")) != -1) {
+        switch (opt) {
+            case 'c':
+                configs.push_back(optarg);
+                break;
+            case 'f': {
+                FILE *f = fopen(optarg, "r");
+                if (f == NULL) {
+                    fprintf(stderr, "ERROR: opening `%s': %s\n", optarg, strerror(errno));
+                    return 1;
+                }
+                char line[1024];
+                while (fgets(line, sizeof(line), f) != NULL) {
+                    // strip comments and surrounding whitespace
+                    line[strcspn(line, "#\r\n")] = '\0';
+                    std::string cfg_line(line);
+                    size_t      first = cfg_line.find_first_not_of(" \t");
+                    if (first != std::string::npos)
+                        configs.push_back(cfg_line.substr(first, cfg_line.find_last_not_of(" \t") - first + 1));
+                }
+                fclose(f);
+                break;
+            }
+            case 's':
+                mem_sz = strtoul(optarg, NULL, 0);
+                break;
+            case 'n':
+                max_instrs = strtoull(optarg, NULL, 0);
+                break;
+            case 'q':
+                quiet = true;
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (optind >= argc) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (configs.empty())
+        configs.push_back("");
+
+    bool detailed = !quiet && configs.size() == 1 && optind == argc - 1;
+    int  retval   = 0;
+    for (size_t i = 0; i < configs.size(); i++) {
+        vproc_config cfg;
+        if (!cfg.parse(configs[i].c_str()))
+            return 1;
+        for (int j = optind; j < argc; j++) {
+            elf_file elf;
+            if (!elf.load(argv[j]))
+                return 1;
+            perf_model model(cfg);
+            if (!run(cfg, elf, mem_sz, max_instrs, &model)) {
+                fprintf(stderr, "ERROR: simulation of `%s' failed\n", argv[j]);
+                retval = 1;
+                continue;
+            }
+            if (detailed) {
+                print_report(cfg, model);
+            } else {
+                // program name without directory and extension (as in the
+                // results.csv files written by the test Makefile)
+                std::string name(argv[j]);
+                name = name.substr(name.find_last_of('/') + 1);
+                name = name.substr(0, name.find_last_of('.'));
+                printf("%s;%s;%lld\n", configs[i].c_str(), name.c_str(), (long long)model.stats.cycles);
+            }
+        }
+    }
+    return retval;
+}
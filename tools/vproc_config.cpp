@@ -0,0 +1,130 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "vproc_config.h"
+
+vproc_config::vproc_config() {
+    vreg_w        = 128;
+    vmem_w        = 32;
+    vmul_w        = 64;
+    alu_op_w      = 64;
+    sld_op_w      = 64;
+    gather_op_w   = 32;
+    aes_op_w      = 128;
+    queue_sz      = 2;
+    icache_sz     = 0;
+    icache_line_w = 128;
+    dcache_sz     = 0;
+    dcache_line_w = 64;
+    mem_w         = 32;
+    mem_latency   = 1;
+}
+
+bool vproc_config::parse(const char *str) {
+    bool sld_op_w_set = false, dcache_line_w_set = false;
+    const char *pos = str;
+    while (*pos != '\0') {
+        while (*pos == ' ' || *pos == '\t' || *pos == '\n' || *pos == '\r')
+            pos++;
+        if (*pos == '\0')
+            break;
+        size_t len = strcspn(pos, " \t\n\r");
+        const char *eq = (const char *)memchr(pos, '=', len);
+        if (eq == NULL) {
+            fprintf(stderr, "ERROR: invalid configuration parameter `%.*s'\n", (int)len, pos);
+            return false;
+        }
+        // parameters of vproc_top that are not reflected by the timing models
+        // are accepted and ignored (MEM_ARB takes a string value); a warning is
+        // printed for those that do affect the timing of the hardware
+        static const struct {
+            const char *key;
+            bool        timing;
+        } ignored[] = {
+            {"DCACHE_SECTOR_W", true },
+            {"MEM_ARB",         true },
+            {"MEM_ARB_IWEIGHT", true },
+            {"MEM_ARB_DWEIGHT", true },
+            {"AES_UNIT",        false},
+            {"TRACE_BUF_LEN",   false}
+        };
+        size_t i;
+        for (i = 0; i < sizeof(ignored) / sizeof(ignored[0]); i++) {
+            if (strlen(ignored[i].key) == (size_t)(eq - pos) && strncmp(ignored[i].key, pos, eq - pos) == 0)
+                break;
+        }
+        if (i < sizeof(ignored) / sizeof(ignored[0])) {
+            if (ignored[i].timing)
+                fprintf(stderr, "WARNING: `%.*s' is not modeled; timing estimates may deviate\n", (int)len, pos);
+            pos += len;
+            continue;
+        }
+        char *end;
+        long val = strtol(eq + 1, &end, 0);
+        if (end != pos + len || val < 0 || val > (1L << 24)) {
+            fprintf(stderr, "ERROR: invalid value for configuration parameter `%.*s'\n", (int)len, pos);
+            return false;
+        }
+        static const struct {
+            const char       *key;
+            int vproc_config::*field;
+        } params[] = {
+            {"VREG_W",        &vproc_config::vreg_w       },
+            {"VMEM_W",        &vproc_config::vmem_w       },
+            {"VMUL_W",        &vproc_config::vmul_w       },
+            {"ALU_OP_W",      &vproc_config::alu_op_w     },
+            {"SLD_OP_W",      &vproc_config::sld_op_w     },
+            {"GATHER_OP_W",   &vproc_config::gather_op_w  },
+            {"AES_OP_W",      &vproc_config::aes_op_w     },
+            {"QUEUE_SZ",      &vproc_config::queue_sz     },
+            {"ICACHE_SZ",     &vproc_config::icache_sz    },
+            {"ICACHE_LINE_W", &vproc_config::icache_line_w},
+            {"DCACHE_SZ",     &vproc_config::dcache_sz    },
+            {"DCACHE_LINE_W", &vproc_config::dcache_line_w},
+            {"MEM_W",         &vproc_config::mem_w        },
+            {"MEM_LATENCY",   &vproc_config::mem_latency  }
+        };
+        for (i = 0; i < sizeof(params) / sizeof(params[0]); i++) {
+            if (strlen(params[i].key) == (size_t)(eq - pos) && strncmp(params[i].key, pos, eq - pos) == 0) {
+                this->*params[i].field = (int)val;
+                sld_op_w_set      = sld_op_w_set      || params[i].field == &vproc_config::sld_op_w;
+                dcache_line_w_set = dcache_line_w_set || params[i].field == &vproc_config::dcache_line_w;
+                break;
+            }
+        }
+        if (i == sizeof(params) / sizeof(params[0])) {
+            fprintf(stderr, "ERROR: unknown configuration parameter `%.*s'\n", (int)(eq - pos), pos);
+            return false;
+        }
+        pos += len;
+    }
+    if (!sld_op_w_set)
+        sld_op_w = (vmul_w > 64) ? vmul_w : 64;
+    if (!dcache_line_w_set)
+        dcache_line_w = vmem_w * 2;
+
+    // same restrictions as in vproc_top and vproc_core
+    if (vreg_w < 64 || (vreg_w & (vreg_w - 1)) != 0 || vmem_w < 32 || (vmem_w & (vmem_w - 1)) != 0 ||
+        vmul_w < 32 || (vmul_w & (vmul_w - 1)) != 0 || mem_w < 32 || (mem_w & (mem_w - 1)) != 0 ||
+        alu_op_w < 32 || sld_op_w < 32 || gather_op_w < 32 || aes_op_w < 128 ||
+        (aes_op_w > vreg_w && vreg_w >= 128) || queue_sz < 1 || mem_latency < 1) {
+        fprintf(stderr, "ERROR: invalid configuration `%s'\n", str);
+        return false;
+    }
+    if (dcache_sz == 0 && mem_w != vmem_w) {
+        fprintf(stderr, "ERROR: MEM_W and VMEM_W must be equal if no data cache is used\n");
+        return false;
+    }
+    return true;
+}
+
+void vproc_config::print(FILE *f) const {
+    fprintf(f, "VREG_W=%d VMEM_W=%d VMUL_W=%d ALU_OP_W=%d SLD_OP_W=%d GATHER_OP_W=%d AES_OP_W=%d QUEUE_SZ=%d "
+               "ICACHE_SZ=%d ICACHE_LINE_W=%d DCACHE_SZ=%d DCACHE_LINE_W=%d MEM_W=%d MEM_LATENCY=%d",
+            vreg_w, vmem_w, vmul_w, alu_op_w, sld_op_w, gather_op_w, aes_op_w, queue_sz,
+            icache_sz, icache_line_w, dcache_sz, dcache_line_w, mem_w, mem_latency);
+}
@@ -0,0 +1,50 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// Hardware configuration of a Vicuna instance (vproc_top with Ibex)
+
+#ifndef VPROC_CONFIG_H
+#define VPROC_CONFIG_H
+
+#include <stdio.h>
+
+struct vproc_config {
+    // parameters of vproc_top and the memory of the testbench; the defaults
+    // are those of the simulation Makefile in sim/
+    int vreg_w;         // VREG_W: vector register width in bits
+    int vmem_w;         // VMEM_W: vector memory interface width in bits
+    int vmul_w;         // VMUL_W: MUL unit operand width in bits
+    int alu_op_w;       // ALU_OP_W: ALU unit operand width in bits
+    int sld_op_w;       // SLD_OP_W: SLD unit operand width in bits
+    int gather_op_w;    // GATHER_OP_W: vrgather operand width in bits
+    int aes_op_w;       // AES_OP_W: AES unit operand width in bits
+    int queue_sz;       // QUEUE_SZ: instruction queue depth
+    int icache_sz;      // ICACHE_SZ: instruction cache size in bytes (0 if none)
+    int icache_line_w;  // ICACHE_LINE_W: instruction cache line width in bits
+    int dcache_sz;      // DCACHE_SZ: data cache size in bytes (0 if none)
+    int dcache_line_w;  // DCACHE_LINE_W: data cache line width in bits
+    int mem_w;          // MEM_W: memory bus width in bits
+    int mem_latency;    // MEM_LATENCY: memory latency in cycles
+
+    vproc_config();
+
+    // parse a list of KEY=VAL pairs separated by whitespace (such as a line of
+    // the test_configs.conf files in test/); parameters that are not given
+    // keep their current value, except for SLD_OP_W and DCACHE_LINE_W which
+    // follow VMUL_W and VMEM_W unless specified explicitly; TRACE_BUF_LEN and
+    // AES_UNIT are ignored (the AES instructions are always modeled), as are
+    // DCACHE_SECTOR_W, MEM_ARB, MEM_ARB_IWEIGHT, and MEM_ARB_DWEIGHT, which
+    // do affect the timing but are not modeled (the models assume whole-line
+    // fills and fixed-priority memory arbitration), hence a warning is
+    // printed for them;
+    // returns false and prints an error message for unknown keys or invalid
+    // values
+    bool parse(const char *str);
+
+    // print the configuration as a list of KEY=VAL pairs
+    void print(FILE *f) const;
+};
+
+#endif // VPROC_CONFIG_H
@@ -0,0 +1,174 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+#include "vproc_timing.h"
+
+int vtiming_emul(const rv_instr &instr, int sew, int lmul8) {
+    int emul8 = lmul8;
+    if (instr.vmaskop)
+        return 1;
+    if (instr.cls == INSTR_VLOAD || instr.cls == INSTR_VSTORE) {
+        // EMUL of the data operand is EEW / SEW * LMUL, that of the indices
+        // of indexed loads and stores is LMUL
+        emul8 = lmul8 * instr.veew / sew;
+        if (instr.vstride == VSTRIDE_INDEXED && lmul8 > emul8)
+            emul8 = lmul8;
+    }
+    else if (instr.vwiden != 0) {
+        emul8 = lmul8 * 2;
+    }
+    return (emul8 < 8) ? 1 : emul8 / 8;
+}
+
+int vtiming_unit_cycles(const vproc_config &cfg, const rv_instr &instr, int sew, int lmul8) {
+    int emul = vtiming_emul(instr, sew, lmul8);
+    switch (instr.cls) {
+        case INSTR_VLOAD:
+        case INSTR_VSTORE:
+            return vtiming_mem_transactions(cfg, instr, sew, lmul8);
+        case INSTR_VALU:
+            // the ALU processes ALU_OP_W bits per cycle
+            return emul * cfg.vreg_w / cfg.alu_op_w;
+        case INSTR_VMUL:
+            // the MUL unit processes VMUL_W bits per cycle
+            return emul * cfg.vreg_w / cfg.vmul_w;
+        case INSTR_VSLD:
+            // the SLD unit requires one additional operand fetch cycle
+            return (emul + 1) * cfg.vreg_w / cfg.sld_op_w;
+        case INSTR_VELEM: {
+            // the ELEM unit processes one element per cycle; vrgather reads
+            // the source vreg holding the gathered element GATHER_OP_W bits
+            // per cycle (i.e., VREG_W / GATHER_OP_W cycles per element), and
+            // reductions as well as vcompress flush their result at the end;
+            // instructions returning a scalar and vmsbf, vmsif, and vmsof
+            // process the whole mask vreg at once (vmv.x.s in a single cycle,
+            // the others take a second cycle for fetching the mask vreg)
+            if (instr.vxreg || instr.vmaskop)
+                return (instr.vxreg && instr.rs1 == 0) ? 1 : 2;
+            int elems = emul * cfg.vreg_w / sew;
+            if (instr.vgather)
+                return elems * cfg.vreg_w / cfg.gather_op_w;
+            if (instr.vreduce)
+                return elems + cfg.vreg_w / sew;
+            return elems;
+        }
+        case INSTR_VAES:
+            // the AES unit processes AES_OP_W bits (i.e., AES_OP_W / 128
+            // element groups) per cycle
+            return emul * cfg.vreg_w / cfg.aes_op_w;
+        default:
+            return 1;
+    }
+}
+
+int vtiming_unit_latency(const rv_instr &instr) {
+    // operand fetch, operand buffer, execution pipeline, result buffer and
+    // vector register file write (the units retry failed writes, which is
+    // accounted for in the number of write attempts)
+    switch (instr.cls) {
+        case INSTR_VLOAD:
+        case INSTR_VSTORE:
+            return 3;
+        case INSTR_VALU:
+            return 5;
+        case INSTR_VMUL:
+            return 6;
+        case INSTR_VSLD:
+            return 5;
+        case INSTR_VELEM:
+            return 8;
+        case INSTR_VAES:
+            return 6;
+        default:
+            return 1;
+    }
+}
+
+int vtiming_mem_transactions(const vproc_config &cfg, const rv_instr &instr, int sew, int lmul8) {
+    int emul = vtiming_emul(instr, sew, lmul8);
+    if (instr.vstride == VSTRIDE_UNIT) {
+        // unit-stride accesses use the full VMEM_W bit width of the memory
+        // interface; one additional transaction covers misaligned addresses
+        int cnt = emul * cfg.vreg_w / cfg.vmem_w;
+        return (cnt < 1) ? 1 : cnt + 1;
+    }
+    // strided and indexed accesses require one transaction per element
+    return emul * cfg.vreg_w / ((instr.veew > sew) ? instr.veew : sew);
+}
+
+int vtiming_mem_bytes(const vproc_config &cfg, const rv_instr &instr, int sew, int lmul8) {
+    int emul8 = lmul8 * instr.veew / sew;
+    return ((emul8 < 8) ? 1 : emul8 / 8) * cfg.vreg_w / 8;
+}
+
+int vtiming_line_fill(const vproc_config &cfg, int line_w) {
+    // one request per MEM_W bits (pipelined), the last response arrives after
+    // MEM_LATENCY cycles; the cache requires one cycle for the tag check and
+    // one cycle to return the data
+    return line_w / cfg.mem_w + cfg.mem_latency + 2;
+}
+
+int vtiming_line_spill(const vproc_config &cfg, int line_w) {
+    return line_w / cfg.mem_w;
+}
+
+int vtiming_scalar_cycles(const rv_instr &instr, bool taken) {
+    // cycle counts of Ibex (two-stage pipeline, no branch prediction) as
+    // documented for the fast multiplier variant; loads and stores take one
+    // cycle plus the data memory latency
+    switch (instr.cls) {
+        case INSTR_BRANCH:
+            return taken ? 3 : 1;
+        case INSTR_JAL:
+        case INSTR_JALR:
+            return 2;
+        case INSTR_MUL:
+            return 3;
+        case INSTR_DIV:
+            return 37;
+        case INSTR_LOAD:
+        case INSTR_STORE:
+            return 1;
+        case INSTR_SYSTEM:
+            return 4;
+        default:
+            return 1;
+    }
+}
+
+vtiming_cache::vtiming_cache(int size_bytes, int line_w) {
+    line_bytes = line_w / 8;
+    way_len    = size_bytes / line_bytes / 2;
+    hits       = 0;
+    misses     = 0;
+    for (int i = 0; i < 2; i++) {
+        cache_line inv = {false, false, 0};
+        ways[i].assign(way_len, inv);
+    }
+    lru.assign(way_len, 0);
+}
+
+vtiming_cache::result vtiming_cache::access(uint32_t addr, bool write) {
+    uint32_t line  = addr / line_bytes;
+    uint32_t index = line % way_len;
+    uint32_t tag   = line / way_len;
+    for (int i = 0; i < 2; i++) {
+        cache_line &l = ways[i][index];
+        if (l.valid && l.tag == tag) {
+            l.dirty    = l.dirty || write;
+            lru[index] = 1 - i;
+            hits++;
+            return HIT;
+        }
+    }
+    cache_line &l     = ways[lru[index]][index];
+    bool        dirty = l.valid && l.dirty;
+    l.valid    = true;
+    l.dirty    = write;
+    l.tag      = tag;
+    lru[index] = 1 - lru[index];
+    misses++;
+    return dirty ? MISS_DIRTY : MISS;
+}
@@ -0,0 +1,81 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// Timing models of Ibex and of the execution units of Vicuna
+//
+// The models capture the number of cycles that an instruction occupies the
+// unit executing it (i.e., its issue interval) as well as the latency until
+// its result is written back.  All values are derived from the structure of
+// the RTL and are approximations; see tools/README.md for details.
+
+#ifndef VPROC_TIMING_H
+#define VPROC_TIMING_H
+
+#include <stdint.h>
+#include <vector>
+#include "rv_instr.h"
+#include "vproc_config.h"
+
+// cycles between offloading a vector instruction and its dispatch to a unit
+// (Ibex coprocessor interface, decoder buffer and queue output buffer)
+#define VTIMING_DISPATCH_LATENCY 3
+
+// number of vector registers processed by an instruction (EMUL, at least 1)
+// for a given SEW and LMUL (times 8); for widening and narrowing instructions
+// this is the EMUL of the wider operand
+int vtiming_emul(const rv_instr &instr, int sew, int lmul8);
+
+// cycles during which the vector unit executing an instruction is busy
+int vtiming_unit_cycles(const vproc_config &cfg, const rv_instr &instr, int sew, int lmul8);
+
+// cycles from the dispatch of an instruction to a unit until the last
+// result is written back (excluding the busy cycles of the unit and memory
+// latency)
+int vtiming_unit_latency(const rv_instr &instr);
+
+// number of memory transactions of a vector load or store
+int vtiming_mem_transactions(const vproc_config &cfg, const rv_instr &instr, int sew, int lmul8);
+
+// number of bytes of memory accessed by a unit-stride vector load or store
+int vtiming_mem_bytes(const vproc_config &cfg, const rv_instr &instr, int sew, int lmul8);
+
+// cycles required to fill a cache line (and to write back a dirty line)
+int vtiming_line_fill(const vproc_config &cfg, int line_w);
+int vtiming_line_spill(const vproc_config &cfg, int line_w);
+
+// execution cycles of a scalar instruction on Ibex (excluding instruction
+// fetch and data memory latency); taken is only relevant for branches
+int vtiming_scalar_cycles(const rv_instr &instr, bool taken);
+
+// model of the two-way set-associative write-back cache with LRU replacement
+// implemented by vproc_cache
+class vtiming_cache {
+public:
+    enum result {
+        HIT,
+        MISS,           // miss that replaces a clean (or invalid) line
+        MISS_DIRTY      // miss that replaces a dirty line
+    };
+
+    // create a cache of size_bytes bytes with lines of line_w bits
+    vtiming_cache(int size_bytes, int line_w);
+
+    // look up an address; on a miss, the LRU line is replaced
+    result access(uint32_t addr, bool write);
+
+    uint64_t hits, misses;
+
+private:
+    struct cache_line {
+        bool     valid, dirty;
+        uint32_t tag;
+    };
+    int                     line_bytes;
+    uint32_t                way_len;
+    std::vector<cache_line> ways[2];
+    std::vector<uint8_t>    lru;    // index of the least recently used way
+};
+
+#endif // VPROC_TIMING_H
@@ -0,0 +1,254 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// Instruction mix and vector utilization profiler
+//
+// Executes a program on the functional simulator and reports the dynamic
+// instruction mix: the fraction of vector and scalar instructions, the count
+// of each vector opcode, the distribution of SEW and LMUL, and the average
+// vector length relative to VLMAX.  The density of masks (i.e., the fraction
+// of active elements of masked instructions) depends on vector register
+// content and is taken from the profile written by the Verilator harness
+// (see sim/Makefile, PROF_FILE), as are the memory arbitration counters.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include "elf32.h"
+#include "rv_instr.h"
+#include "rv_iss.h"
+#include "vproc_config.h"
+
+struct prof_stats {
+    uint64_t instrs, scalar_instrs, vcfg_instrs, vector_instrs;
+    uint64_t masked_instrs;
+    uint64_t vl_sum, vlmax_sum;                 // vector instructions other than vset[i]vl[i]
+    std::map<std::string, uint64_t> opcodes;    // dynamic count of each vector opcode
+    std::map<std::pair<int, int>, uint64_t> vtypes; // dynamic count of each SEW/LMUL*8 pair
+};
+
+// simulate a program and collect statistics; returns false on error
+static bool run(const vproc_config &cfg, const elf_file &elf, uint32_t mem_sz, uint64_t max_instrs,
+                prof_stats *st) {
+    rv_iss  iss(mem_sz, cfg.vreg_w);
+    rv_step s;
+    iss.load(elf);
+    for (;;) {
+        if (iss.instret >= max_instrs) {
+            fprintf(stderr, "ERROR: instruction limit of %llu exceeded\n", (unsigned long long)max_instrs);
+            return false;
+        }
+        if (!iss.step(&s))
+            return false;
+        const rv_instr &in = s.instr;
+        st->instrs++;
+        if (!instr_is_vector(in.cls)) {
+            st->scalar_instrs++;
+        } else if (in.cls == INSTR_VCFG) {
+            st->vcfg_instrs++;
+            st->opcodes[in.name]++;
+        } else {
+            st->vector_instrs++;
+            st->opcodes[in.name]++;
+            int sew, lmul8;
+            if (vtype_decode(s.vtype, &sew, &lmul8)) {
+                st->vtypes[std::make_pair(sew, lmul8)]++;
+                st->vl_sum    += s.vl;
+                st->vlmax_sum += (uint64_t)cfg.vreg_w * lmul8 / 8 / sew;
+            }
+            if (in.vmasked)
+                st->masked_instrs++;
+        }
+        if (s.end)
+            break;
+    }
+    return true;
+}
+
+static double percent(uint64_t part, uint64_t total) {
+    return (total > 0) ? 100.0 * part / total : 0.0;
+}
+
+static void print_lmul(int lmul8) {
+    if (lmul8 < 8)
+        printf("mf%-2d", 8 / lmul8);
+    else
+        printf("m%-3d", lmul8 / 8);
+}
+
+// statistics of a program from a harness profile
+struct harness_prof {
+    uint64_t elems, active;                     // elements and active elements of masked instructions
+    uint64_t arb_lines;                         // lines with memory arbitration counters
+    uint64_t ireq, iwait, iwait_max;            // instruction memory arbitration counters
+    uint64_t dreq, dwait, dwait_max;            // data memory arbitration counters
+};
+
+// read the profile of a program (lines of the form PROG;MASKED;ELEMS;ACTIVE,
+// optionally followed by IREQ;IWAIT;IWAIT_MAX;DREQ;DWAIT;DWAIT_MAX, which are
+// accumulated over all lines for the program, except for the maxima)
+static bool read_profile(const char *path, const std::string &prog, harness_prof *hp) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        fprintf(stderr, "ERROR: opening `%s': %s\n", path, strerror(errno));
+        return false;
+    }
+    memset(hp, 0, sizeof(*hp));
+    char line[1024];
+    while (fgets(line, sizeof(line), f) != NULL) {
+        char               name[1024];
+        unsigned long long masked, e, a, ir, iw, iwm, dr, dw, dwm;
+        int items = sscanf(line, "%1023[^;];%llu;%llu;%llu;%llu;%llu;%llu;%llu;%llu;%llu", name, &masked, &e, &a,
+                           &ir, &iw, &iwm, &dr, &dw, &dwm);
+        if (items < 4 || prog != name)
+            continue;
+        hp->elems  += e;
+        hp->active += a;
+        if (items == 10) {
+            hp->arb_lines++;
+            hp->ireq      += ir;
+            hp->iwait     += iw;
+            hp->iwait_max  = std::max<uint64_t>(hp->iwait_max, iwm);
+            hp->dreq      += dr;
+            hp->dwait     += dw;
+            hp->dwait_max  = std::max<uint64_t>(hp->dwait_max, dwm);
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-c CONFIG] [-m PROF_FILE] [-s MEM_SZ] [-n MAX_INSTRS] ELF_FILE...\n"
+                    "  -c CONFIG       hardware configuration as list of KEY=VAL pairs (only VREG_W\n"
+                    "                  is relevant for VLMAX)\n"
+                    "  -m PROF_FILE    profile written by the Verilator harness, from which the\n"
+                    "                  mask density and memory arbitration counters are obtained\n"
+                    "  -s MEM_SZ       memory size in bytes (default: 262144)\n"
+                    "  -n MAX_INSTRS   maximum number of executed instructions (default: 100000000)\n",
+            prog);
+}
+
+int main(int argc, char **argv) {
+    const char *config     = "";
+    const char *prof_path  = NULL;
+    uint32_t    mem_sz     = 262144;
+    uint64_t    max_instrs = 100000000;
+    int         opt;
+    while ((opt = getopt(argc, argv, "c:m:s:n:")) != -1) {
+        switch (opt) {
+            case 'c':
+                config = optarg;
+                break;
+            case 'm':
+                prof_path = optarg;
+                break;
+            case 's':
+                mem_sz = strtoul(optarg, NULL, 0);
+                break;
+            case 'n':
+                max_instrs = strtoull(optarg, NULL, 0);
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (optind >= argc) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    vproc_config cfg;
+    if (!cfg.parse(config))
+        return 1;
+
+    int retval = 0;
+    for (int j = optind; j < argc; j++) {
+        elf_file elf;
+        if (!elf.load(argv[j]))
+            return 1;
+        prof_stats st;
+        st.instrs        = 0;
+        st.scalar_instrs = 0;
+        st.vcfg_instrs   = 0;
+        st.vector_instrs = 0;
+        st.masked_instrs = 0;
+        st.vl_sum        = 0;
+        st.vlmax_sum     = 0;
+        if (!run(cfg, elf, mem_sz, max_instrs, &st)) {
+            fprintf(stderr, "ERROR: simulation of `%s' failed\n", argv[j]);
+            retval = 1;
+            continue;
+        }
+
+        // program name without directory and extension (as in the profile
+        // written by the harness)
+        std::string name(argv[j]);
+        name = name.substr(name.find_last_of('/') + 1);
+        name = name.substr(0, name.find_last_of('.'));
+
+        if (j > optind)
+            printf("\n");
+        printf("program: %s\n", name.c_str());
+        printf("instructions:        %12llu\n", (unsigned long long)st.instrs);
+        printf("    scalar           %12llu (%5.1f%%)\n", (unsigned long long)st.scalar_instrs,
+               percent(st.scalar_instrs, st.instrs));
+        printf("    vector config    %12llu (%5.1f%%)\n", (unsigned long long)st.vcfg_instrs,
+               percent(st.vcfg_instrs, st.instrs));
+        printf("    vector           %12llu (%5.1f%%)\n", (unsigned long long)st.vector_instrs,
+               percent(st.vector_instrs, st.instrs));
+
+        // opcodes sorted by descending count
+        std::vector<std::pair<uint64_t, std::string> > ops;
+        for (std::map<std::string, uint64_t>::const_iterator it = st.opcodes.begin(); it != st.opcodes.end(); ++it)
+            ops.push_back(std::make_pair(it->second, it->first));
+        std::stable_sort(ops.begin(), ops.end(), std::greater<std::pair<uint64_t, std::string> >());
+        printf("vector opcodes:\n");
+        for (size_t i = 0; i < ops.size(); i++)
+            printf("    %-16s %12llu (%5.1f%%)\n", ops[i].second.c_str(), (unsigned long long)ops[i].first,
+                   percent(ops[i].first, st.vcfg_instrs + st.vector_instrs));
+
+        printf("SEW/LMUL:\n");
+        for (std::map<std::pair<int, int>, uint64_t>::const_iterator it = st.vtypes.begin(); it != st.vtypes.end();
+             ++it) {
+            printf("    e%-2d ", it->first.first);
+            print_lmul(it->first.second);
+            printf("         %12llu (%5.1f%%)\n", (unsigned long long)it->second,
+                   percent(it->second, st.vector_instrs));
+        }
+
+        if (st.vector_instrs > 0) {
+            printf("average vl:          %12.1f (%5.1f%% of VLMAX)\n", (double)st.vl_sum / st.vector_instrs,
+                   percent(st.vl_sum, st.vlmax_sum));
+        }
+        printf("masked instructions: %12llu (%5.1f%%)\n", (unsigned long long)st.masked_instrs,
+               percent(st.masked_instrs, st.vector_instrs));
+        if (prof_path != NULL) {
+            harness_prof hp;
+            if (!read_profile(prof_path, name, &hp))
+                return 1;
+            if (hp.elems > 0)
+                printf("mask density:        %12.1f%%\n", percent(hp.active, hp.elems));
+            else
+                printf("mask density:        no masked elements in profile\n");
+            if (hp.arb_lines > 0) {
+                printf("memory arbitration:     requests   wait cycles    max wait\n");
+                printf("    instruction      %12llu %12llu (%5.1f%%) %8llu\n", (unsigned long long)hp.ireq,
+                       (unsigned long long)hp.iwait, percent(hp.iwait, hp.ireq), (unsigned long long)hp.iwait_max);
+                printf("    data             %12llu %12llu (%5.1f%%) %8llu\n", (unsigned long long)hp.dreq,
+                       (unsigned long long)hp.dwait, percent(hp.dwait, hp.dreq), (unsigned long long)hp.dwait_max);
+            }
+        }
+    }
+    return retval;
+}
@@ -0,0 +1,196 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// Trace buffer decoder
+//
+// Decodes the content of the trace buffer of vproc_top (see
+// rtl/vproc_tracebuf.sv), as sent over the UART by the demo system (see
+// demo/rtl/demo_top.sv) or written by the Verilator harness (see sim/Makefile,
+// TRACE_BUF_FILE), into a timeline of vector instruction dispatch and
+// completion events and memory stalls.  The input is either a raw capture of
+// the UART output or a file with one byte per line in hexadecimal (option -x,
+// as written by the Verilator harness and by demo/rtl/demo_tb.sv), in which
+// each trace is preceded by the magic bytes "VTRC" and the trace status word;
+// any other data (such as text output of the program) is skipped.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <vector>
+
+static const char *unit_names[] = {"lsu", "alu", "mul", "sld", "elem", "aes"};
+#define UNIT_CNT 6
+
+// bit positions and widths of the fields of a trace entry
+#define ENTRY_DISPATCH_POS  26
+#define ENTRY_COMPLETE_POS  20
+#define ENTRY_STALL_POS     19
+#define ENTRY_STAMP_W       19
+
+// read the input as a sequence of bytes; returns false on error
+static bool read_input(const char *path, bool hex, std::vector<uint8_t> *data) {
+    FILE *f = fopen(path, hex ? "r" : "rb");
+    if (f == NULL) {
+        fprintf(stderr, "ERROR: opening `%s': %s\n", path, strerror(errno));
+        return false;
+    }
+    if (hex) {
+        char line[256];
+        while (fgets(line, sizeof(line), f) != NULL) {
+            char *ptr = line;
+            while (*ptr == ' ' || *ptr == '\t')
+                ptr++;
+            if (*ptr == '#' || *ptr == '\n' || *ptr == '\r' || *ptr == 0)
+                continue;
+            char *end;
+            unsigned long val = strtoul(ptr, &end, 16);
+            if (end == ptr || val > 0xFF) {
+                fprintf(stderr, "ERROR: invalid byte `%s' in `%s'\n", strtok(ptr, "\r\n"), path);
+                fclose(f);
+                return false;
+            }
+            data->push_back((uint8_t)val);
+        }
+    } else {
+        int c;
+        while ((c = fgetc(f)) != EOF)
+            data->push_back((uint8_t)c);
+    }
+    fclose(f);
+    return true;
+}
+
+static uint32_t get_word(const std::vector<uint8_t> &data, size_t pos) {
+    return data[pos] | (data[pos+1] << 8) | (data[pos+2] << 16) | ((uint32_t)data[pos+3] << 24);
+}
+
+// decode the entries of one trace and print the timeline and a summary
+static void decode(int idx, uint32_t stat, const std::vector<uint8_t> &data, size_t pos, uint32_t cnt,
+                   FILE *out) {
+    fprintf(out, "# trace %d: %u entries%s\n", idx, cnt,
+            (stat & 0x80000000u) ? " (buffer overflow, recording stopped early)" : "");
+    fprintf(out, "#      CYCLE  EVENT     UNIT\n");
+    uint64_t cycle = 0, stall_start = 0, stall_cycles = 0;
+    uint32_t last_stamp = 0;
+    bool     first = true, stall = false;
+    uint64_t dispatched[UNIT_CNT] = {0}, completed[UNIT_CNT] = {0};
+    for (uint32_t i = 0; i < cnt; i++) {
+        uint32_t entry = get_word(data, pos + 4 * i);
+        uint32_t stamp = entry & ((1u << ENTRY_STAMP_W) - 1);
+        // at most one entry is recorded per cycle and an entry is recorded
+        // whenever the stamp wraps around to zero
+        if (!first && stamp <= last_stamp)
+            cycle += 1ull << ENTRY_STAMP_W;
+        cycle      = (cycle & ~((1ull << ENTRY_STAMP_W) - 1)) | stamp;
+        last_stamp = stamp;
+        first      = false;
+        for (int u = 0; u < UNIT_CNT; u++) {
+            if ((entry >> (ENTRY_DISPATCH_POS + u)) & 1) {
+                fprintf(out, "%12llu  dispatch  %s\n", (unsigned long long)cycle, unit_names[u]);
+                dispatched[u]++;
+            }
+        }
+        for (int u = 0; u < UNIT_CNT; u++) {
+            if ((entry >> (ENTRY_COMPLETE_POS + u)) & 1) {
+                fprintf(out, "%12llu  complete  %s\n", (unsigned long long)cycle, unit_names[u]);
+                completed[u]++;
+            }
+        }
+        bool entry_stall = (entry >> ENTRY_STALL_POS) & 1;
+        if (entry_stall != stall) {
+            fprintf(out, "%12llu  %-8s  mem\n", (unsigned long long)cycle, entry_stall ? "stall" : "resume");
+            if (entry_stall)
+                stall_start = cycle;
+            else
+                stall_cycles += cycle - stall_start;
+            stall = entry_stall;
+        }
+    }
+    if (stall)
+        stall_cycles += cycle - stall_start;
+    fprintf(out, "# unit   dispatched   completed\n");
+    for (int u = 0; u < UNIT_CNT; u++)
+        fprintf(out, "# %-4s %12llu %11llu\n", unit_names[u], (unsigned long long)dispatched[u],
+                (unsigned long long)completed[u]);
+    fprintf(out, "# memory stall cycles: %llu of %llu\n", (unsigned long long)stall_cycles,
+            (unsigned long long)cycle);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-x] [-o OUT_FILE] IN_FILE\n"
+                    "  -x              input contains one byte per line in hexadecimal (default: raw\n"
+                    "                  bytes, e.g., a capture of the UART output)\n"
+                    "  -o OUT_FILE     output file (default: standard output)\n",
+            prog);
+}
+
+int main(int argc, char **argv) {
+    const char *out_path = NULL;
+    bool        hex      = false;
+    int         opt;
+    while ((opt = getopt(argc, argv, "xo:")) != -1) {
+        switch (opt) {
+            case 'x':
+                hex = true;
+                break;
+            case 'o':
+                out_path = optarg;
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (optind != argc - 1) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    std::vector<uint8_t> data;
+    if (!read_input(argv[optind], hex, &data))
+        return 1;
+
+    FILE *out = stdout;
+    if (out_path != NULL) {
+        out = fopen(out_path, "w");
+        if (out == NULL) {
+            fprintf(stderr, "ERROR: opening `%s': %s\n", out_path, strerror(errno));
+            return 1;
+        }
+    }
+    int    traces = 0;
+    bool   ok     = true;
+    size_t pos    = 0;
+    while (pos + 8 <= data.size()) {
+        if (memcmp(&data[pos], "VTRC", 4) != 0) {
+            pos++;
+            continue;
+        }
+        uint32_t stat = get_word(data, pos + 4);
+        uint32_t cnt  = stat & 0x3FFFFFFF;
+        pos += 8;
+        if (pos + 4 * (size_t)cnt > data.size()) {
+            fprintf(stderr, "ERROR: trace %d is truncated (%u entries expected, %u found)\n", traces, cnt,
+                    (unsigned)((data.size() - pos) / 4));
+            ok = false;
+            break;
+        }
+        if (traces > 0)
+            fprintf(out, "\n");
+        decode(traces, stat, data, pos, cnt, out);
+        pos += 4 * (size_t)cnt;
+        traces++;
+    }
+    if (out != stdout)
+        fclose(out);
+    if (traces == 0) {
+        fprintf(stderr, "ERROR: no trace found in `%s'\n", argv[optind]);
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,116 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// Vector instruction trace recorder
+//
+// Executes a program on the functional simulator and writes the sequence of
+// executed vector instructions together with the values of their scalar
+// operands, which is the input of the trace-driven harness of the vector core
+// (see sim/verilator_core_main.cpp).  For vset[i]vl[i] the resulting vl is
+// recorded as expected result.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <stdint.h>
+#include "elf32.h"
+#include "rv_instr.h"
+#include "rv_iss.h"
+#include "vproc_config.h"
+
+// simulate a program and write one line INSTR X_RS1 X_RS2 [XRES] per vector
+// instruction; returns false on error
+static bool run(const vproc_config &cfg, const elf_file &elf, uint32_t mem_sz, uint64_t max_instrs, FILE *out) {
+    rv_iss  iss(mem_sz, cfg.vreg_w);
+    rv_step s;
+    iss.load(elf);
+    for (;;) {
+        if (iss.instret >= max_instrs) {
+            fprintf(stderr, "ERROR: instruction limit of %llu exceeded\n", (unsigned long long)max_instrs);
+            return false;
+        }
+        if (!iss.step(&s))
+            return false;
+        const rv_instr &in = s.instr;
+        if (instr_is_vector(in.cls)) {
+            if (in.cls == INSTR_VCFG)
+                fprintf(out, "%08x %08x %08x %08x\n", in.exp, s.x_rs1, s.x_rs2, s.vl);
+            else
+                fprintf(out, "%08x %08x %08x\n", in.exp, s.x_rs1, s.x_rs2);
+        }
+        if (s.end)
+            break;
+    }
+    return true;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-c CONFIG] [-o TRACE_FILE] [-s MEM_SZ] [-n MAX_INSTRS] ELF_FILE\n"
+                    "  -c CONFIG       hardware configuration as list of KEY=VAL pairs (only VREG_W\n"
+                    "                  is relevant for vl)\n"
+                    "  -o TRACE_FILE   output file (default: standard output)\n"
+                    "  -s MEM_SZ       memory size in bytes (default: 262144)\n"
+                    "  -n MAX_INSTRS   maximum number of executed instructions (default: 100000000)\n",
+            prog);
+}
+
+int main(int argc, char **argv) {
+    const char *config     = "";
+    const char *out_path   = NULL;
+    uint32_t    mem_sz     = 262144;
+    uint64_t    max_instrs = 100000000;
+    int         opt;
+    while ((opt = getopt(argc, argv, "c:o:s:n:")) != -1) {
+        switch (opt) {
+            case 'c':
+                config = optarg;
+                break;
+            case 'o':
+                out_path = optarg;
+                break;
+            case 's':
+                mem_sz = strtoul(optarg, NULL, 0);
+                break;
+            case 'n':
+                max_instrs = strtoull(optarg, NULL, 0);
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (optind != argc - 1) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    vproc_config cfg;
+    if (!cfg.parse(config))
+        return 1;
+
+    elf_file elf;
+    if (!elf.load(argv[optind]))
+        return 1;
+
+    FILE *out = stdout;
+    if (out_path != NULL) {
+        out = fopen(out_path, "w");
+        if (out == NULL) {
+            fprintf(stderr, "ERROR: opening `%s': %s\n", out_path, strerror(errno));
+            return 1;
+        }
+    }
+    fprintf(out, "# vector instructions of %s (VREG_W=%d)\n", argv[optind], cfg.vreg_w);
+    bool ok = run(cfg, elf, mem_sz, max_instrs, out);
+    if (out != stdout)
+        fclose(out);
+    if (!ok) {
+        fprintf(stderr, "ERROR: simulation of `%s' failed\n", argv[optind]);
+        return 1;
+    }
+    return 0;
+}
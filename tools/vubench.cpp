@@ -0,0 +1,268 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// Micro-benchmarks of the vector execution units
+//
+// Generates instruction traces for the trace-driven harness of the vector
+// core (see sim/verilator_core_main.cpp) that each exercise a single unit with
+// back-to-back operations of one SEW/LMUL setting, and evaluates the cycle
+// counts reported by the harness.  Two hazard patterns are generated per unit
+// and setting: independent operations (every operation writes another
+// register group than the preceding one and no operation reads the result of
+// another), which measure the throughput of the unit, and a chain of dependent
+// operations (every operation reads the result of its predecessor), which
+// measures the latency from dispatch to the completion of the result.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <string>
+#include <map>
+#include "rv_instr.h"
+#include "vproc_config.h"
+
+enum ubench_unit {
+    UB_ALU,         // vadd.vv
+    UB_MUL,         // vmul.vv
+    UB_SLD,         // vslidedown.vi
+    UB_GATHER,      // vrgather.vv (ELEM unit)
+    UB_ELEM,        // vredsum.vs (ELEM unit)
+    UB_LOAD,        // unit-stride load (LSU)
+    UB_STORE        // unit-stride store (LSU)
+};
+
+static const struct {
+    const char  *name;
+    instr_class  cls;
+} units[] = {
+    {"alu",    INSTR_VALU  },
+    {"mul",    INSTR_VMUL  },
+    {"sld",    INSTR_VSLD  },
+    {"gather", INSTR_VELEM },
+    {"elem",   INSTR_VELEM },
+    {"load",   INSTR_VLOAD },
+    {"store",  INSTR_VSTORE}
+};
+#define UNIT_CNT ((int)(sizeof(units) / sizeof(units[0])))
+
+// base address and size of the memory region accessed by loads and stores
+#define LSU_BASE 0x10000
+#define LSU_SIZE 0x10000
+
+static uint32_t enc_arith(uint32_t funct6, uint32_t funct3, int vd, int vs2, int vs1) {
+    return (funct6 << 26) | (1u << 25) | (vs2 << 20) | (vs1 << 15) | (funct3 << 12) | (vd << 7) | 0x57;
+}
+
+static uint32_t enc_ldst(bool store, int sew, int vd, int rs1) {
+    uint32_t width = (sew == 8) ? 0 : ((sew == 16) ? 5 : 6);
+    return (1u << 25) | (rs1 << 15) | (width << 12) | (vd << 7) | (store ? 0x27 : 0x07);
+}
+
+// encode one operation of a unit
+static uint32_t enc_op(int unit, int sew, int vd, int vs2, int vs1) {
+    switch (unit) {
+        case UB_ALU:    return enc_arith(0x00, 0, vd, vs2, vs1);    // vadd.vv
+        case UB_MUL:    return enc_arith(0x25, 2, vd, vs2, vs1);    // vmul.vv
+        case UB_SLD:    return enc_arith(0x0f, 3, vd, vs2, 1);      // vslidedown.vi vd, vs2, 1
+        case UB_GATHER: return enc_arith(0x0c, 0, vd, vs2, vs1);    // vrgather.vv
+        case UB_ELEM:   return enc_arith(0x00, 2, vd, vs2, vs1);    // vredsum.vs
+        case UB_LOAD:   return enc_ldst(false, sew, vd, 10);
+        default:        return enc_ldst(true,  sew, vd, 10);
+    }
+}
+
+// write the trace of a micro-benchmark with ops operations; the register
+// groups of LMUL registers are used as follows: group 0 is the second
+// source operand (vs1), group 1 the first source operand (vs2) of
+// independent operations, and the remaining groups are destinations in turn;
+// dependent operations alternate between groups 1 and 2 as source and
+// destination, except for loads, which all write group 1 (stores read the
+// destination groups of independent operations)
+static bool write_trace(const char *path, const vproc_config &cfg, int unit, int sew, int lmul, bool dep,
+                        int ops) {
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        fprintf(stderr, "ERROR: opening `%s': %s\n", path, strerror(errno));
+        return false;
+    }
+    int      vlmax  = cfg.vreg_w * lmul / sew;
+    uint32_t vtypei = ((sew == 8) ? 0 : ((sew == 16) ? 1 : 2)) << 3 | ((lmul == 1) ? 0 : (lmul == 2) ? 1 :
+                                                                      (lmul == 4) ? 2 : 3);
+    fprintf(f, "# %s %s, SEW=%d, LMUL=%d, VREG_W=%d\n", units[unit].name, dep ? "dependent" : "independent", sew,
+            lmul, cfg.vreg_w);
+    // vsetvli a0, zero, vtypei (sets vl to VLMAX)
+    fprintf(f, "%08x %08x %08x %08x\n", (vtypei << 20) | (7 << 12) | (10 << 7) | 0x57, 0, 0, vlmax);
+    int groups = 32 / lmul;
+    for (int i = 0; i < ops; i++) {
+        int vd, vs2, vs1 = 0;
+        if (dep) {
+            vd  = lmul * (1 + (i + 1) % 2);
+            vs2 = lmul * (1 + i % 2);
+        } else {
+            vd  = lmul * (2 + i % (groups - 2));
+            vs2 = lmul;
+        }
+        if (unit == UB_LOAD && dep)
+            vd = lmul;      // loads do not read registers, chain by overwriting
+        uint32_t instr = enc_op(unit, sew, vd, vs2, vs1);
+        rv_instr in;
+        if (!rv_decode(instr, &in) || in.cls != units[unit].cls) {
+            fprintf(stderr, "ERROR: invalid encoding %08x for unit %s\n", instr, units[unit].name);
+            fclose(f);
+            return false;
+        }
+        uint32_t addr = LSU_BASE + (uint32_t)((uint64_t)i * vlmax * sew / 8 % LSU_SIZE);
+        fprintf(f, "%08x %08x %08x\n", instr, (unit == UB_LOAD || unit == UB_STORE) ? addr : 0, 0);
+    }
+    fclose(f);
+    return true;
+}
+
+// generate the traces of all units and settings, a memory initialization file
+// and the list of traces for the harness in directory dir
+static bool generate(const vproc_config &cfg, const char *dir, int ops) {
+    std::string list_path = std::string(dir) + "/traces.txt";
+    std::string mem_path  = std::string(dir) + "/ubench.vmem";
+    FILE *fmem = fopen(mem_path.c_str(), "w");
+    if (fmem == NULL) {
+        fprintf(stderr, "ERROR: opening `%s': %s\n", mem_path.c_str(), strerror(errno));
+        return false;
+    }
+    // fill the memory region of loads and stores with a pseudo-random pattern
+    fprintf(fmem, "@%08x\n", LSU_BASE / 4);
+    uint32_t lfsr = 0xace1u;
+    for (int i = 0; i < LSU_SIZE / 4; i++) {
+        lfsr = lfsr * 1664525u + 1013904223u;
+        fprintf(fmem, "%08x\n", lfsr);
+    }
+    fclose(fmem);
+
+    FILE *flist = fopen(list_path.c_str(), "w");
+    if (flist == NULL) {
+        fprintf(stderr, "ERROR: opening `%s': %s\n", list_path.c_str(), strerror(errno));
+        return false;
+    }
+    for (int unit = 0; unit < UNIT_CNT; unit++) {
+        for (int sew = 8; sew <= 32; sew *= 2) {
+            for (int lmul = 1; lmul <= 8; lmul *= 2) {
+                for (int dep = 0; dep < 2; dep++) {
+                    // stores do not write registers, hence there is no chain
+                    if (unit == UB_STORE && dep)
+                        continue;
+                    char name[64];
+                    snprintf(name, sizeof(name), "%s_e%d_m%d_%s", units[unit].name, sew, lmul,
+                             dep ? "dep" : "ind");
+                    std::string path = std::string(dir) + "/" + name + ".trace";
+                    if (!write_trace(path.c_str(), cfg, unit, sew, lmul, dep, ops)) {
+                        fclose(flist);
+                        return false;
+                    }
+                    fprintf(flist, "%s %s\n", path.c_str(), mem_path.c_str());
+                }
+            }
+        }
+    }
+    fclose(flist);
+    return true;
+}
+
+// evaluate the statistics file written by the harness (lines of the form
+// TRACE;INSTRS;CYCLES;VREG_W;VMEM_W;MEM_LATENCY)
+static bool report(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        fprintf(stderr, "ERROR: opening `%s': %s\n", path, strerror(errno));
+        return false;
+    }
+    // throughput (elements per cycle) and latency (cycles per operation) by
+    // unit, SEW and LMUL
+    std::map<std::string, std::pair<double, double> > res;
+    char line[1024];
+    while (fgets(line, sizeof(line), f) != NULL) {
+        char unit[64], mode[8];
+        int  sew, lmul, instrs, vreg_w;
+        long long cycles;
+        if (sscanf(line, "%63[^_]_e%d_m%d_%7[^;];%d;%lld;%d", unit, &sew, &lmul, mode, &instrs, &cycles,
+                   &vreg_w) != 7 || instrs < 2 || cycles <= 0)
+            continue;
+        char key[96];
+        snprintf(key, sizeof(key), "%-8s %4d %4d", unit, sew, lmul);
+        std::pair<double, double> &r = res.insert(std::make_pair(std::string(key),
+                                                                 std::make_pair(-1.0, -1.0))).first->second;
+        int ops = instrs - 1;   // without the initial vsetvli
+        if (strcmp(mode, "dep") == 0)
+            r.second = (double)cycles / ops;
+        else
+            r.first  = (double)ops * (vreg_w * lmul / sew) / cycles;
+    }
+    fclose(f);
+    printf("unit      SEW LMUL  elements/cycle  cycles/dependent op\n");
+    for (std::map<std::string, std::pair<double, double> >::const_iterator it = res.begin(); it != res.end();
+         ++it) {
+        printf("%s", it->first.c_str());
+        if (it->second.first >= 0.0)
+            printf("  %14.2f", it->second.first);
+        else
+            printf("  %14s", "-");
+        if (it->second.second >= 0.0)
+            printf("  %19.1f\n", it->second.second);
+        else
+            printf("  %19s\n", "-");
+    }
+    return true;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-c CONFIG] [-n OPS] -d DIR\n"
+                    "       %s -r STATS_FILE\n"
+                    "  -c CONFIG       hardware configuration as list of KEY=VAL pairs (only VREG_W\n"
+                    "                  is relevant for the traces)\n"
+                    "  -n OPS          number of operations per micro-benchmark (default: 64)\n"
+                    "  -d DIR          directory to which the traces are written\n"
+                    "  -r STATS_FILE   report the results from the statistics of the harness\n",
+            prog, prog);
+}
+
+int main(int argc, char **argv) {
+    const char *config     = "";
+    const char *dir        = NULL;
+    const char *stats_path = NULL;
+    int         ops        = 64;
+    int         opt;
+    while ((opt = getopt(argc, argv, "c:n:d:r:")) != -1) {
+        switch (opt) {
+            case 'c':
+                config = optarg;
+                break;
+            case 'n':
+                ops = strtol(optarg, NULL, 0);
+                break;
+            case 'd':
+                dir = optarg;
+                break;
+            case 'r':
+                stats_path = optarg;
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (optind != argc || (dir == NULL) == (stats_path == NULL) || ops < 1) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (stats_path != NULL)
+        return report(stats_path) ? 0 : 1;
+
+    vproc_config cfg;
+    if (!cfg.parse(config))
+        return 1;
+    return generate(cfg, dir, ops) ? 0 : 1;
+}
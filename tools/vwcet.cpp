@@ -0,0 +1,717 @@
+// Copyright TU Wien
+// Licensed under the ISC license, see LICENSE.txt for details
+// SPDX-License-Identifier: ISC
+
+
+// Static worst-case execution time (WCET) estimator for Vicuna programs
+//
+// The control flow graph of each function is reconstructed from the ELF file,
+// natural loops are identified and bounded with user-supplied loop bounds, and
+// the longest path through each function is computed with the timing models
+// of Ibex and of the vector units.  Calls are accounted for with the WCET of
+// the callee.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <vector>
+#include <map>
+#include <set>
+#include <string>
+#include <algorithm>
+#include "elf32.h"
+#include "rv_instr.h"
+#include "vproc_config.h"
+#include "vproc_timing.h"
+
+#define VTYPE_UNKNOWN 0xFFFFFFFFu   // vtype is unknown (or differs between paths)
+#define VTYPE_UNDEF   0xFFFFFFFEu   // block has not been reached yet
+
+struct block {
+    uint32_t              start, end;   // address range [start, end)
+    std::vector<rv_instr> instrs;
+    std::vector<int>      succ;         // indices of successor blocks
+    uint32_t              call;         // callee address (or 0 if none)
+    bool                  ret;          // block returns from the function
+    uint32_t              vtype_in;     // vtype at the beginning of the block
+    int64_t               cost_hit;     // WCET assuming instruction cache hits
+    int64_t               cost_miss;    // WCET assuming instruction cache misses
+};
+
+struct loop_info {
+    int           header;
+    std::set<int> body;
+    int64_t       bound;
+    int64_t       iter;                 // WCET of one iteration
+    int64_t       cost_hit, cost_miss;
+};
+
+struct function_info {
+    bool    busy, done;
+    bool    returns;                    // function has at least one path that returns
+    int64_t wcet;
+};
+
+static elf_file                        elf;
+static vproc_config                    cfg;
+static std::map<uint32_t, int64_t>     loop_bounds;
+static std::map<uint32_t, function_info> functions;
+static bool                            verbose = false;
+
+static std::string location(uint32_t addr) {
+    char buf[64];
+    std::string sym = elf.symbol_at(addr);
+    uint32_t    sym_addr;
+    if (sym.empty() || !elf.symbol(sym.c_str(), &sym_addr)) {
+        snprintf(buf, sizeof(buf), "0x%08x", addr);
+        return std::string(buf);
+    }
+    snprintf(buf, sizeof(buf), "0x%08x (%s+0x%x)", addr, sym.c_str(), addr - sym_addr);
+    return std::string(buf);
+}
+
+// parse a code location given as symbol, symbol+offset or address
+static bool parse_location(const char *str, uint32_t *addr) {
+    std::string s(str);
+    size_t      plus = s.find('+');
+    uint32_t    base = 0, off = 0;
+    char       *end;
+    if (plus != std::string::npos) {
+        off = strtoul(s.c_str() + plus + 1, &end, 0);
+        if (*end != '\0')
+            return false;
+        s = s.substr(0, plus);
+    }
+    if (s[0] >= '0' && s[0] <= '9') {
+        base = strtoul(s.c_str(), &end, 0);
+        if (*end != '\0')
+            return false;
+    } else if (!elf.symbol(s.c_str(), &base)) {
+        return false;
+    }
+    *addr = base + off;
+    return true;
+}
+
+static bool read_bounds_file(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        fprintf(stderr, "ERROR: opening `%s': %s\n", path, strerror(errno));
+        return false;
+    }
+    char line[256];
+    int  lineno = 0;
+    bool ok     = true;
+    while (fgets(line, sizeof(line), f) != NULL) {
+        lineno++;
+        char *comment = strchr(line, '#');
+        if (comment != NULL)
+            *comment = '\0';
+        char loc[128];
+        long long bound;
+        int  cnt = sscanf(line, "%127s %lld", loc, &bound);
+        if (cnt <= 0)
+            continue;
+        uint32_t addr;
+        if (cnt != 2 || bound < 0 || !parse_location(loc, &addr)) {
+            fprintf(stderr, "ERROR: %s:%d: invalid loop bound\n", path, lineno);
+            ok = false;
+            continue;
+        }
+        loop_bounds[addr] = bound;
+    }
+    fclose(f);
+    return ok;
+}
+
+// worst-case cycles of a vector instruction for a given vtype
+static int64_t vector_cycles(const rv_instr &instr, int sew, int lmul8) {
+    if (instr.cls == INSTR_VCFG)
+        return VTIMING_DISPATCH_LATENCY + 1;
+    int64_t cycles = VTIMING_DISPATCH_LATENCY + vtiming_unit_cycles(cfg, instr, sew, lmul8) +
+                     vtiming_unit_latency(instr);
+    if (instr.cls == INSTR_VLOAD || instr.cls == INSTR_VSTORE) {
+        if (cfg.dcache_sz == 0) {
+            cycles += cfg.mem_latency;
+        } else {
+            // every accessed cache line misses and requires a write back
+            int64_t misses = vtiming_mem_transactions(cfg, instr, sew, lmul8);
+            if (instr.vstride == VSTRIDE_UNIT)
+                misses = vtiming_mem_bytes(cfg, instr, sew, lmul8) * 8 / cfg.dcache_line_w + 1;
+            cycles += misses * (vtiming_line_fill(cfg, cfg.dcache_line_w) +
+                                vtiming_line_spill(cfg, cfg.dcache_line_w));
+        }
+    }
+    return cycles;
+}
+
+// worst-case cycles of an instruction (excluding instruction cache misses)
+static int64_t instr_cycles(const rv_instr &instr, uint32_t vtype) {
+    if (!instr_is_vector(instr.cls)) {
+        int64_t cycles = vtiming_scalar_cycles(instr, true);
+        if (instr.cls == INSTR_LOAD || instr.cls == INSTR_STORE) {
+            if (cfg.dcache_sz == 0)
+                cycles += cfg.mem_latency;
+            else
+                cycles += vtiming_line_fill(cfg, cfg.dcache_line_w) + vtiming_line_spill(cfg, cfg.dcache_line_w);
+        }
+        // without an instruction cache, Ibex has at most two outstanding
+        // fetch requests; control transfers flush the prefetch buffer
+        bool ctrl = instr.cls == INSTR_BRANCH || instr.cls == INSTR_JAL || instr.cls == INSTR_JALR;
+        if (cfg.icache_sz == 0) {
+            cycles += (cfg.mem_latency + 1) / 2 - 1;
+            if (ctrl)
+                cycles += cfg.mem_latency;
+        } else if (ctrl) {
+            cycles += 1;
+        }
+        return cycles;
+    }
+    int sew, lmul8;
+    if (vtype != VTYPE_UNKNOWN && vtype_decode(vtype, &sew, &lmul8))
+        return vector_cycles(instr, sew, lmul8);
+    // unknown vtype: maximum over all legal configurations
+    int64_t max = 0;
+    for (sew = 8; sew <= 32; sew *= 2) {
+        for (lmul8 = 8; lmul8 <= 64; lmul8 *= 2) {
+            if (instr.vwiden != 0 && (lmul8 == 64 || sew == 32))
+                continue;
+            if ((instr.cls == INSTR_VLOAD || instr.cls == INSTR_VSTORE) && lmul8 * instr.veew / sew > 64)
+                continue;
+            int64_t cycles = vector_cycles(instr, sew, lmul8);
+            if (cycles > max)
+                max = cycles;
+        }
+    }
+    return max;
+}
+
+// longest path from node start in the acyclic graph given by edges
+static int64_t longest_path(int node, const std::map<int, std::set<int> > &edges,
+                            const std::vector<int64_t> &cost, std::map<int, int64_t> &memo,
+                            std::set<int> &active, bool *cyclic) {
+    std::map<int, int64_t>::iterator it = memo.find(node);
+    if (it != memo.end())
+        return it->second;
+    if (active.count(node) != 0) {
+        *cyclic = true;
+        return 0;
+    }
+    active.insert(node);
+    int64_t max = 0;
+    std::map<int, std::set<int> >::const_iterator e = edges.find(node);
+    if (e != edges.end()) {
+        for (std::set<int>::const_iterator s = e->second.begin(); s != e->second.end(); ++s) {
+            int64_t len = longest_path(*s, edges, cost, memo, active, cyclic);
+            if (len > max)
+                max = len;
+        }
+    }
+    active.erase(node);
+    memo[node] = cost[node] + max;
+    return cost[node] + max;
+}
+
+static bool analyze_function(uint32_t entry, function_info *result);
+
+// WCET of a function (analyzed on first use)
+static bool function_wcet(uint32_t addr, int64_t *wcet, bool *returns) {
+    function_info &info = functions[addr];
+    if (info.busy) {
+        fprintf(stderr, "ERROR: recursive call of function at %s\n", location(addr).c_str());
+        return false;
+    }
+    if (!info.done) {
+        info.busy = true;
+        function_info tmp;
+        if (!analyze_function(addr, &tmp))
+            return false;
+        functions[addr] = tmp;
+        functions[addr].done = true;
+        functions[addr].busy = false;
+    }
+    *wcet    = functions[addr].wcet;
+    *returns = functions[addr].returns;
+    return true;
+}
+
+static bool analyze_function(uint32_t entry, function_info *result) {
+    const std::map<uint32_t, elf_symbol> &funcs = elf.functions();
+
+    ///////////////////////////////////////////////////////////////////////////
+    // INSTRUCTION DISCOVERY
+
+    std::map<uint32_t, rv_instr> instrs;
+    std::map<uint32_t, uint32_t> calls;     // call or tail call site -> callee
+    std::set<uint32_t>           leaders, terminal, returns;
+    std::vector<uint32_t>        worklist;
+    leaders.insert(entry);
+    worklist.push_back(entry);
+    while (!worklist.empty()) {
+        uint32_t addr = worklist.back();
+        worklist.pop_back();
+        rv_instr prev;
+        prev.cls = INSTR_ILLEGAL;
+        while (instrs.count(addr) == 0) {
+            rv_instr instr;
+            if (!elf.is_text(addr)) {
+                fprintf(stderr, "ERROR: control flow leaves the text segment at %s\n", location(addr).c_str());
+                return false;
+            }
+            if (!rv_decode(elf.read32(addr), &instr)) {
+                fprintf(stderr, "ERROR: illegal or unsupported instruction 0x%08x at %s\n",
+                        instr.raw, location(addr).c_str());
+                return false;
+            }
+            if (instr.cls == INSTR_MUL || instr.cls == INSTR_DIV)
+                fprintf(stderr, "WARNING: scalar multiplication or division at %s is not supported by "
+                                "the Ibex configuration of vproc_top\n", location(addr).c_str());
+            instrs[addr] = instr;
+            uint32_t next = addr + instr.len;
+
+            // jump targets, including those computed with auipc or lui
+            bool     direct = instr.cls == INSTR_JAL;
+            uint32_t target = addr + instr.imm;
+            if (instr.cls == INSTR_JALR) {
+                if (prev.cls == INSTR_ALU && prev.rd == instr.rs1 && prev.rd != 0 &&
+                    (strcmp(prev.name, "auipc") == 0 || strcmp(prev.name, "lui") == 0)) {
+                    direct = true;
+                    target = ((strcmp(prev.name, "auipc") == 0) ? addr - prev.len : 0) + prev.imm + instr.imm;
+                } else if (instr.rs1 == 0) {
+                    direct = true;
+                    target = instr.imm;
+                }
+            }
+
+            if (instr.cls == INSTR_BRANCH) {
+                leaders.insert(target);
+                leaders.insert(next);
+                worklist.push_back(target);
+                worklist.push_back(next);
+                break;
+            }
+            if (instr.cls == INSTR_JAL || instr.cls == INSTR_JALR) {
+                if (!direct) {
+                    if (instr.rd == 0 && instr.rs1 == 1 && instr.imm == 0) { // return
+                        terminal.insert(addr);
+                        returns.insert(addr);
+                        leaders.insert(next);
+                        break;
+                    }
+                    fprintf(stderr, "ERROR: indirect jump at %s is not supported\n", location(addr).c_str());
+                    return false;
+                }
+                if (instr.rd == 0 && target == 0) { // end of the program
+                    terminal.insert(addr);
+                    leaders.insert(next);
+                    break;
+                }
+                std::map<uint32_t, elf_symbol>::const_iterator sym = funcs.find(target);
+                bool is_func = sym != funcs.end() && sym->second.func && target != entry;
+                if (instr.rd != 0 || is_func) { // call or tail call
+                    int64_t wcet;
+                    bool    returns;
+                    if (!function_wcet(target, &wcet, &returns))
+                        return false;
+                    calls[addr] = target;
+                    leaders.insert(next);
+                    if (instr.rd != 0 && returns) {
+                        worklist.push_back(next);
+                    } else {
+                        terminal.insert(addr);
+                    }
+                    break;
+                }
+                leaders.insert(target);
+                leaders.insert(next);
+                worklist.push_back(target);
+                break;
+            }
+            prev = instr;
+            addr = next;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // BASIC BLOCKS
+
+    std::vector<block>      blocks;
+    std::map<uint32_t, int> block_at;   // start address -> block index
+    for (std::map<uint32_t, rv_instr>::iterator it = instrs.begin(); it != instrs.end(); ++it) {
+        uint32_t addr = it->first;
+        if (blocks.empty() || leaders.count(addr) != 0 || blocks.back().end != addr) {
+            block b;
+            b.start    = addr;
+            b.end      = addr;
+            b.call     = 0;
+            b.ret      = false;
+            b.vtype_in = VTYPE_UNDEF;
+            block_at[addr] = blocks.size();
+            blocks.push_back(b);
+        }
+        blocks.back().instrs.push_back(it->second);
+        blocks.back().end += it->second.len;
+    }
+    int entry_blk = block_at[entry];
+    for (size_t i = 0; i < blocks.size(); i++) {
+        block          &b    = blocks[i];
+        const rv_instr &last = b.instrs.back();
+        uint32_t        addr = b.end - last.len;
+        if (calls.count(addr) != 0)
+            b.call = calls[addr];
+        if (terminal.count(addr) != 0) {
+            if (b.call != 0) // tail call returns if the callee returns
+                b.ret = functions[b.call].returns;
+            else
+                b.ret = returns.count(addr) != 0;
+            continue;
+        }
+        if (last.cls == INSTR_BRANCH) {
+            b.succ.push_back(block_at[addr + last.imm]);
+            b.succ.push_back(block_at[b.end]);
+        } else if (last.cls == INSTR_JAL && b.call == 0) {
+            b.succ.push_back(block_at[addr + last.imm]);
+        } else if (instrs.count(b.end) != 0) {
+            b.succ.push_back(block_at[b.end]);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // VTYPE PROPAGATION AND BLOCK COSTS
+
+    // reverse postorder (iterative depth-first search)
+    std::vector<int> rpo;
+    {
+        std::vector<char> visited(blocks.size(), 0);
+        std::vector<std::pair<int, size_t> > stack;
+        stack.push_back(std::make_pair(entry_blk, (size_t)0));
+        visited[entry_blk] = 1;
+        while (!stack.empty()) {
+            int     n = stack.back().first;
+            size_t &i = stack.back().second;
+            if (i < blocks[n].succ.size()) {
+                int s = blocks[n].succ[i++];
+                if (!visited[s]) {
+                    visited[s] = 1;
+                    stack.push_back(std::make_pair(s, (size_t)0));
+                }
+            } else {
+                rpo.push_back(n);
+                stack.pop_back();
+            }
+        }
+        std::reverse(rpo.begin(), rpo.end());
+    }
+
+    blocks[entry_blk].vtype_in = VTYPE_UNKNOWN;
+    for (bool changed = true; changed; ) {
+        changed = false;
+        for (size_t i = 0; i < rpo.size(); i++) {
+            block   &b     = blocks[rpo[i]];
+            uint32_t vtype = b.vtype_in;
+            for (size_t j = 0; j < b.instrs.size(); j++) {
+                if (b.instrs[j].cls == INSTR_VCFG)
+                    vtype = b.instrs[j].vtype_imm ? b.instrs[j].vtype : VTYPE_UNKNOWN;
+            }
+            if (b.call != 0)
+                vtype = VTYPE_UNKNOWN;
+            for (size_t j = 0; j < b.succ.size(); j++) {
+                uint32_t &in  = blocks[b.succ[j]].vtype_in;
+                uint32_t  new_in = (in == VTYPE_UNDEF || in == vtype) ? vtype : VTYPE_UNKNOWN;
+                if (new_in != in) {
+                    in      = new_in;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    int line_bytes = cfg.icache_line_w / 8;
+    for (size_t i = 0; i < blocks.size(); i++) {
+        block   &b     = blocks[i];
+        uint32_t vtype = b.vtype_in;
+        int64_t  cost  = 0;
+        for (size_t j = 0; j < b.instrs.size(); j++) {
+            cost += instr_cycles(b.instrs[j], vtype);
+            if (b.instrs[j].cls == INSTR_VCFG)
+                vtype = b.instrs[j].vtype_imm ? b.instrs[j].vtype : VTYPE_UNKNOWN;
+        }
+        if (b.call != 0)
+            cost += functions[b.call].wcet;
+        b.cost_hit  = cost;
+        b.cost_miss = cost;
+        if (cfg.icache_sz != 0) {
+            int64_t lines = (b.end - 1) / line_bytes - b.start / line_bytes + 1;
+            b.cost_miss  += lines * vtiming_line_fill(cfg, cfg.icache_line_w);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // LOOPS
+
+    // dominators (iterative data-flow analysis over the reverse postorder)
+    size_t nblocks = blocks.size();
+    std::vector<std::vector<char> > dom(nblocks, std::vector<char>(nblocks, 1));
+    std::vector<std::vector<int> >  preds(nblocks);
+    for (size_t i = 0; i < nblocks; i++) {
+        for (size_t j = 0; j < blocks[i].succ.size(); j++)
+            preds[blocks[i].succ[j]].push_back(i);
+    }
+    dom[entry_blk].assign(nblocks, 0);
+    dom[entry_blk][entry_blk] = 1;
+    for (bool changed = true; changed; ) {
+        changed = false;
+        for (size_t i = 0; i < rpo.size(); i++) {
+            int n = rpo[i];
+            if (n == entry_blk)
+                continue;
+            std::vector<char> d(nblocks, 1);
+            for (size_t j = 0; j < preds[n].size(); j++) {
+                for (size_t k = 0; k < nblocks; k++)
+                    d[k] = d[k] && dom[preds[n][j]][k];
+            }
+            d[n] = 1;
+            if (d != dom[n]) {
+                dom[n]  = d;
+                changed = true;
+            }
+        }
+    }
+
+    // natural loops (loops sharing a header are merged)
+    std::vector<int>      rpo_index(nblocks, 0);
+    std::map<int, size_t> loop_of_header;
+    std::vector<loop_info> loops;
+    for (size_t i = 0; i < rpo.size(); i++)
+        rpo_index[rpo[i]] = i;
+    for (size_t i = 0; i < rpo.size(); i++) {
+        int n = rpo[i];
+        for (size_t j = 0; j < blocks[n].succ.size(); j++) {
+            int h = blocks[n].succ[j];
+            if (rpo_index[h] > rpo_index[n])
+                continue;
+            if (!dom[n][h]) {
+                fprintf(stderr, "ERROR: irreducible control flow at %s\n", location(blocks[h].start).c_str());
+                return false;
+            }
+            if (loop_of_header.count(h) == 0) {
+                loop_info l;
+                l.header = h;
+                l.body.insert(h);
+                loop_of_header[h] = loops.size();
+                loops.push_back(l);
+            }
+            loop_info       &l = loops[loop_of_header[h]];
+            std::vector<int> stack(1, n);
+            while (!stack.empty()) {
+                int m = stack.back();
+                stack.pop_back();
+                if (l.body.insert(m).second) {
+                    for (size_t k = 0; k < preds[m].size(); k++)
+                        stack.push_back(preds[m][k]);
+                }
+            }
+        }
+    }
+
+    // loop bounds
+    bool bounds_ok = true;
+    for (size_t i = 0; i < loops.size(); i++) {
+        uint32_t addr = blocks[loops[i].header].start;
+        std::map<uint32_t, int64_t>::iterator it = loop_bounds.find(addr);
+        if (it != loop_bounds.end()) {
+            loops[i].bound = it->second;
+            continue;
+        }
+        // the crt0 loop clearing the bss section is bounded by its size
+        uint32_t bss_loop, bss_start, bss_end;
+        if (elf.symbol("bss_clear_loop", &bss_loop) && bss_loop == addr &&
+            elf.symbol("_bss_start", &bss_start) && elf.symbol("_bss_end", &bss_end)) {
+            loops[i].bound = (bss_end - bss_start) / 4 + 1;
+            continue;
+        }
+        fprintf(stderr, "ERROR: no bound for loop at %s\n", location(addr).c_str());
+        bounds_ok = false;
+    }
+    if (!bounds_ok)
+        return false;
+
+    // collapse loops into nodes, starting with the innermost loops; nodes
+    // 0 to nblocks-1 are basic blocks, nodes nblocks and above are loops
+    std::vector<size_t> order(loops.size());
+    for (size_t i = 0; i < loops.size(); i++)
+        order[i] = i;
+    for (size_t i = 1; i < order.size(); i++) {
+        for (size_t j = i; j > 0 && loops[order[j]].body.size() < loops[order[j-1]].body.size(); j--)
+            std::swap(order[j], order[j-1]);
+    }
+    std::vector<int>     rep(nblocks);
+    std::vector<int64_t> cost_hit(nblocks + loops.size()), cost_miss(nblocks + loops.size());
+    for (size_t i = 0; i < nblocks; i++) {
+        rep[i]       = i;
+        cost_hit [i] = blocks[i].cost_hit;
+        cost_miss[i] = blocks[i].cost_miss;
+    }
+    for (size_t i = 0; i < order.size(); i++) {
+        loop_info &l = loops[order[i]];
+        std::map<int, std::set<int> > edges;
+        uint32_t start    = 0xFFFFFFFFu, end = 0;
+        bool     has_call = false;
+        for (std::set<int>::iterator b = l.body.begin(); b != l.body.end(); ++b) {
+            for (size_t j = 0; j < blocks[*b].succ.size(); j++) {
+                int s = blocks[*b].succ[j];
+                if (s != l.header && l.body.count(s) != 0 && rep[s] != rep[*b])
+                    edges[rep[*b]].insert(rep[s]);
+            }
+            start    = std::min(start, blocks[*b].start);
+            end      = std::max(end,   blocks[*b].end);
+            has_call = has_call || blocks[*b].call != 0;
+        }
+        std::map<int, int64_t> memo_hit, memo_miss;
+        std::set<int>          active;
+        bool                   cyclic = false;
+        int64_t iter_hit  = longest_path(l.header, edges, cost_hit,  memo_hit,  active, &cyclic);
+        int64_t iter_miss = longest_path(l.header, edges, cost_miss, memo_miss, active, &cyclic);
+        if (cyclic) {
+            fprintf(stderr, "ERROR: irreducible control flow in loop at %s\n", location(blocks[l.header].start).c_str());
+            return false;
+        }
+        // if the code of a loop without calls fits into one way of the
+        // instruction cache, only the first iteration suffers from misses
+        l.cost_hit  = l.bound * iter_hit;
+        l.cost_miss = l.bound * iter_miss;
+        l.iter      = iter_miss;
+        if (cfg.icache_sz != 0 && !has_call && (int)(end - start) <= cfg.icache_sz / 2) {
+            int64_t lines = (end - 1) / line_bytes - start / line_bytes + 1;
+            l.cost_miss   = l.cost_hit + lines * vtiming_line_fill(cfg, cfg.icache_line_w);
+            l.iter        = iter_hit;
+        }
+        int node = nblocks + order[i];
+        cost_hit [node] = l.cost_hit;
+        cost_miss[node] = l.cost_miss;
+        for (std::set<int>::iterator b = l.body.begin(); b != l.body.end(); ++b)
+            rep[*b] = node;
+    }
+
+    // longest path through the function
+    std::map<int, std::set<int> > edges;
+    for (size_t i = 0; i < nblocks; i++) {
+        for (size_t j = 0; j < blocks[i].succ.size(); j++) {
+            int s = blocks[i].succ[j];
+            if (rep[s] != rep[i])
+                edges[rep[i]].insert(rep[s]);
+        }
+    }
+    std::map<int, int64_t> memo;
+    std::set<int>          active;
+    bool                   cyclic = false;
+    result->wcet    = longest_path(rep[entry_blk], edges, cost_miss, memo, active, &cyclic);
+    result->returns = false;
+    for (size_t i = 0; i < nblocks; i++)
+        result->returns = result->returns || blocks[i].ret;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // REPORT
+
+    std::string name = elf.symbol_at(entry);
+    printf("function %s at 0x%08x: %lld cycles\n", name.c_str(), entry, (long long)result->wcet);
+    if (verbose) {
+        for (size_t i = 0; i < nblocks; i++) {
+            const block &b = blocks[i];
+            printf("    block 0x%08x-0x%08x: %8lld cycles", b.start, b.end, (long long)b.cost_miss);
+            if (b.call != 0)
+                printf(" (calls %s)", elf.symbol_at(b.call).c_str());
+            printf("\n");
+        }
+    }
+    for (size_t i = 0; i < order.size(); i++) {
+        const loop_info &l = loops[order[i]];
+        printf("    loop at %s: bound %lld, %lld cycles per iteration, %lld cycles\n",
+               location(blocks[l.header].start).c_str(), (long long)l.bound, (long long)l.iter,
+               (long long)l.cost_miss);
+    }
+    return true;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-c CONFIG] [-b BOUNDS_FILE] [-l LOOP=BOUND] [-e ENTRY] [-m CYCLES] [-v] ELF_FILE\n"
+                    "  -c CONFIG       hardware configuration as list of KEY=VAL pairs, such as\n"
+                    "                  \"VREG_W=128 VMEM_W=64 DCACHE_SZ=16384 MEM_LATENCY=5\"\n"
+                    "  -b BOUNDS_FILE  file with one loop bound per line (LOOP BOUND)\n"
+                    "  -l LOOP=BOUND   bound of a single loop; LOOP is the address of the loop\n"
+                    "                  header given as address, symbol, or symbol+offset\n"
+                    "  -e ENTRY        entry function (default: _start)\n"
+                    "  -m CYCLES       calibration: compare the WCET bound to measured cycles\n"
+                    "  -v              print the WCET of every basic block\n", prog);
+}
+
+int main(int argc, char **argv) {
+    const char *entry_name = "_start";
+    const char *config     = "";
+    std::vector<const char *> bound_files, bound_args;
+    long long   measured   = -1;
+    int         opt;
+    while ((opt = getopt(argc, argv, "c:b:l:e:m:v")) != -1) {
+        switch (opt) {
+            case 'c': config     = optarg;            break;
+            case 'b': bound_files.push_back(optarg);  break;
+            case 'l': bound_args.push_back(optarg);   break;
+            case 'e': entry_name = optarg;            break;
+            case 'm': measured   = atoll(optarg);     break;
+            case 'v': verbose    = true;              break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (optind != argc - 1) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (!cfg.parse(config) || !elf.load(argv[optind]))
+        return 1;
+
+    for (size_t i = 0; i < bound_files.size(); i++) {
+        if (!read_bounds_file(bound_files[i]))
+            return 1;
+    }
+    for (size_t i = 0; i < bound_args.size(); i++) {
+        std::string arg(bound_args[i]);
+        size_t      eq = arg.find('=');
+        uint32_t    addr;
+        char       *end;
+        long long   bound = (eq == std::string::npos) ? -1 : strtoll(arg.c_str() + eq + 1, &end, 0);
+        if (bound < 0 || *end != '\0' || !parse_location(arg.substr(0, eq).c_str(), &addr)) {
+            fprintf(stderr, "ERROR: invalid loop bound `%s'\n", bound_args[i]);
+            return 1;
+        }
+        loop_bounds[addr] = bound;
+    }
+
+    uint32_t entry;
+    if (!parse_location(entry_name, &entry)) {
+        fprintf(stderr, "ERROR: unknown entry `%s'\n", entry_name);
+        return 1;
+    }
+
+    printf("configuration: ");
+    cfg.print(stdout);
+    printf("\n");
+    int64_t wcet;
+    bool    returns;
+    if (!function_wcet(entry, &wcet, &returns))
+        return 1;
+    printf("WCET bound: %lld cycles\n", (long long)wcet);
+
+    if (measured >= 0) {
+        printf("measured:   %lld cycles (bound / measured = %.3f)\n", measured,
+               (measured > 0) ? (double)wcet / measured : 0.0);
+        if (wcet < measured) {
+            fprintf(stderr, "ERROR: WCET bound is below the measured execution time\n");
+            return 2;
+        }
+    }
+    return 0;
+}